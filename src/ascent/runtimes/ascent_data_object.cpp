@@ -63,6 +63,7 @@
 #endif
 
 #include "ascent_transmogrifier.hpp"
+#include "expressions/ascent_topology_metadata.hpp"
 
 #include <ascent_logging.hpp>
 
@@ -115,7 +116,8 @@ DataObject::DataObject()
 #if defined(ASCENT_DRAY_ENABLED)
     m_dray(nullptr),
 #endif
-    m_source(Source::INVALID)
+    m_source(Source::INVALID),
+    m_keep_conversions(false)
 {
   m_name = "default";
 }
@@ -128,7 +130,8 @@ DataObject::DataObject(VTKHCollection *dataset)
 #if defined(ASCENT_DRAY_ENABLED)
     m_dray(nullptr),
 #endif
-    m_source(Source::VTKH)
+    m_source(Source::VTKH),
+    m_keep_conversions(false)
 {
   m_name = "default";
 }
@@ -142,7 +145,8 @@ DataObject::DataObject(dray::Collection *dataset)
     m_vtkh(nullptr),
 #endif
     m_dray(dataset),
-    m_source(Source::DRAY)
+    m_source(Source::DRAY),
+    m_keep_conversions(false)
 {
   m_name = "default";
 }
@@ -157,6 +161,7 @@ DataObject::DataObject(conduit::Node *dataset)
 #if defined(ASCENT_DRAY_ENABLED)
     ,m_dray(nullptr)
 #endif
+    ,m_keep_conversions(false)
 {
   reset(dataset);
   m_name = "default";
@@ -411,6 +416,12 @@ std::shared_ptr<conduit::Node>  DataObject::as_node()
   return nullptr;
 }
 
+std::shared_ptr<runtime::expressions::TopologyMetadata>
+DataObject::topology_metadata()
+{
+  return runtime::expressions::TopologyMetadata::get(as_low_order_bp());
+}
+
 DataObject::Source DataObject::source() const
 {
   return m_source;
@@ -442,8 +453,89 @@ std::string DataObject::source_string() const
   return res;
 }
 
+conduit::index_t DataObject::size_in_bytes() const
+{
+  // representations can share memory (zero copied conversions),
+  // so this is an upper bound
+  conduit::index_t bytes = 0;
+  if(m_low_bp != nullptr)
+  {
+    bytes += m_low_bp->total_bytes_allocated();
+  }
+  if(m_high_bp != nullptr)
+  {
+    bytes += m_high_bp->total_bytes_allocated();
+  }
+#if defined(ASCENT_VTKM_ENABLED)
+  if(m_vtkh != nullptr)
+  {
+    bytes += m_vtkh->size_in_bytes();
+  }
+#endif
+  return bytes;
+}
+
+void DataObject::keep_conversions(bool keep)
+{
+  m_keep_conversions = keep;
+}
+
+void DataObject::release_conversions()
+{
+  if(m_keep_conversions)
+  {
+    return;
+  }
+
+  if(m_source != Source::LOW_BP)
+  {
+    m_low_bp.reset();
+  }
+  if(m_source != Source::HIGH_BP)
+  {
+    m_high_bp.reset();
+  }
+#if defined(ASCENT_VTKM_ENABLED)
+  if(m_source != Source::VTKH)
+  {
+    m_vtkh.reset();
+  }
+#endif
+#if defined(ASCENT_DRAY_ENABLED)
+  if(m_source != Source::DRAY)
+  {
+    m_dray.reset();
+  }
+#endif
+}
+
 //-----------------------------------------------------------------------------
 };
 //-----------------------------------------------------------------------------
 // -- end ascent:: --
 //-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// -- begin flow:: --
+//-----------------------------------------------------------------------------
+namespace flow
+{
+
+template <>
+conduit::index_t
+data_size_in_bytes<ascent::DataObject>(const ascent::DataObject *data)
+{
+  return data->size_in_bytes();
+}
+
+template <>
+void
+data_release_cached<ascent::DataObject>(ascent::DataObject *data)
+{
+  data->release_conversions();
+}
+
+};
+//-----------------------------------------------------------------------------
+// -- end flow:: --
+//-----------------------------------------------------------------------------
@@ -54,6 +54,7 @@
 
 #include <ascent.hpp>
 #include <conduit.hpp>
+#include <flow_data.hpp>
 #include <memory>
 
 //-----------------------------------------------------------------------------
@@ -76,6 +77,14 @@ namespace ascent
 class VTKHCollection;
 #endif
 
+namespace runtime
+{
+namespace expressions
+{
+  class TopologyMetadata;
+} // namespace expressions
+} // namespace runtime
+
 
 class DataObject
 {
@@ -108,8 +117,19 @@ public:
   std::shared_ptr<conduit::Node>  as_low_order_bp();
   std::shared_ptr<conduit::Node>  as_high_order_bp();
   std::shared_ptr<conduit::Node>  as_node();          // just return the coduit node
+  // bounds, counts, and centroids of the low order topologies, shared
+  // until a new data set is published
+  std::shared_ptr<runtime::expressions::TopologyMetadata> topology_metadata();
   DataObject::Source              source() const;
   std::string source_string() const;
+  // estimate of the local memory held by all current representations
+  conduit::index_t size_in_bytes() const;
+  // drops every representation except the source
+  // (does nothing when conversions are kept)
+  void release_conversions();
+  // keeps every conversion when asked to release them, used for the
+  // published data set, whose conversions every pipeline shares
+  void keep_conversions(bool keep);
 protected:
   std::shared_ptr<conduit::Node>  m_low_bp;
   std::shared_ptr<conduit::Node>  m_high_bp;
@@ -122,11 +142,29 @@ protected:
 
   Source m_source;
   std::string m_name;
+  bool m_keep_conversions;
 };
 
 //-----------------------------------------------------------------------------
 };
-#endif
 //-----------------------------------------------------------------------------
 // -- end ascent:: --
 //-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// memory accounting for data objects held in the flow registry
+//-----------------------------------------------------------------------------
+namespace flow
+{
+
+template <>
+ASCENT_API conduit::index_t
+data_size_in_bytes<ascent::DataObject>(const ascent::DataObject *data);
+
+template <>
+ASCENT_API void
+data_release_cached<ascent::DataObject>(ascent::DataObject *data);
+
+};
+
+#endif
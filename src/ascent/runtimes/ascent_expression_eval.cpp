@@ -54,10 +54,15 @@
 #include "expressions/ascent_expressions_ast.hpp"
 #include "expressions/ascent_expressions_parser.hpp"
 #include "expressions/ascent_expressions_tokens.hpp"
+#include "expressions/ascent_history_window.hpp"
 
 #include <stdlib.h>
 #include <stdio.h>
 #include <ctime>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 #ifdef ASCENT_MPI_ENABLED
 #include <mpi.h>
@@ -81,11 +86,137 @@ namespace runtime
 namespace expressions
 {
 
-conduit::Node g_function_table;
-conduit::Node g_object_table;
+// the function and object tables every evaluation resolves names
+// against. They are built by register_builtin and never modified once
+// published, so concurrent evaluations can share them. Each evaluation
+// holds a reference to the tables it started with, so re-registering
+// doesn't pull them out from under a running expression.
+struct SymbolTables
+{
+  conduit::Node m_functions;
+  conduit::Node m_objects;
+};
+
+std::shared_ptr<SymbolTables> g_symbol_tables
+  = std::make_shared<SymbolTables>();
+
+std::shared_ptr<SymbolTables>
+symbol_tables()
+{
+  return std::atomic_load(&g_symbol_tables);
+}
+
+void
+publish_symbol_tables(std::shared_ptr<SymbolTables> tables)
+{
+  std::atomic_store(&g_symbol_tables, tables);
+}
+
+#ifdef ASCENT_MPI_ENABLED
+// expression filters issue MPI collectives (field reductions, binning,
+// quantiles, topology metadata) and every rank has to issue them in the
+// same order. Evaluations running on several threads would interleave
+// them differently on each rank, so with MPI only one thread may be
+// evaluating at a time. This raises an error instead of deadlocking.
+// Nested evaluations on the same thread are fine.
+class SerialEvaluation
+{
+public:
+  SerialEvaluation()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const std::thread::id self = std::this_thread::get_id();
+    if(m_depth > 0 && m_owner != self)
+    {
+      ASCENT_ERROR("Expressions can't be evaluated concurrently when Ascent "
+                   "is built with MPI. Every rank must issue the same MPI "
+                   "collectives in the same order.");
+    }
+    m_owner = self;
+    m_depth++;
+  }
+
+  ~SerialEvaluation()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_depth--;
+  }
+
+private:
+  static std::mutex m_mutex;
+  static std::thread::id m_owner;
+  static int m_depth;
+};
+
+std::mutex SerialEvaluation::m_mutex;
+std::thread::id SerialEvaluation::m_owner;
+int SerialEvaluation::m_depth = 0;
+#endif
+
+// parsed expressions by their text. Actions evaluate the same expressions
+// every cycle and everyone parses through a single lock, so each text is
+// parsed once and its AST is shared by every evaluation. Building the
+// graph doesn't modify the AST.
+class ParsedExpressions
+{
+public:
+  std::shared_ptr<ASTExpression> get(const std::string &expr)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto it = m_asts.find(expr);
+      if(it != m_asts.end())
+      {
+        return it->second;
+      }
+    }
+
+    // parse errors are thrown from here and never cached
+    std::shared_ptr<ASTExpression> ast(parse_expression(expr.c_str()));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(m_asts.size() >= m_max_size)
+    {
+      // expressions generated on the fly shouldn't grow this forever
+      m_asts.clear();
+    }
+    m_asts[expr] = ast;
+    return ast;
+  }
+
+private:
+  const size_t m_max_size = 1024;
+  std::mutex m_mutex;
+  std::unordered_map<std::string, std::shared_ptr<ASTExpression>> m_asts;
+};
+
+ParsedExpressions g_parsed_expressions;
 
 Cache ExpressionEval::m_cache;
 
+namespace detail
+{
+
+// value and time of a cache entry holding a number
+bool
+scalar_entry(const conduit::Node &entry, double &value, double &time)
+{
+  if(!entry.has_path("type") || !entry.has_path("value"))
+  {
+    return false;
+  }
+  const std::string type = entry["type"].as_string();
+  if(type != "double" && type != "int")
+  {
+    return false;
+  }
+  value = entry["value"].to_float64();
+  time = entry.has_path("time") ? entry["time"].to_float64() : 0.;
+  return true;
+}
+
+} // namespace detail
+
 double Cache::last_known_time()
 {
   double res = 0;
@@ -172,6 +303,8 @@ void Cache::filter_time(double ftime)
      <<" after simulation time "<<ftime<<".";
   m_data["ascent_cache_info"].append() = msg.str();
   m_filtered = true;
+  // the windows are recreated from what is left the next time they're used
+  m_windows.clear();
 }
 
 bool Cache::loaded()
@@ -220,6 +353,140 @@ void Cache::save()
   }
 }
 
+bool Cache::last_entry(const std::string &name, conduit::Node &entry)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if(!m_data.has_path(name))
+  {
+    return false;
+  }
+  const conduit::Node &history = m_data[name];
+  const int entries = history.number_of_children();
+  if(entries < 1)
+  {
+    return false;
+  }
+  entry = history.child(entries - 1);
+  return true;
+}
+
+bool Cache::history_entry(const std::string &name,
+                          const int index,
+                          const bool from_end,
+                          conduit::Node &entry,
+                          int &entries)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if(!m_data.has_path(name))
+  {
+    return false;
+  }
+  const conduit::Node &history = m_data[name];
+  entries = history.number_of_children();
+  int absolute_index = index;
+  if(from_end)
+  {
+    // a relative index that has gone too far is clamped to 0, which is
+    // the newest entry
+    absolute_index = index >= entries ? entries - 1 : entries - index - 1;
+  }
+  if(absolute_index >= 0 && absolute_index < entries)
+  {
+    entry = history.child(absolute_index);
+  }
+  return true;
+}
+
+void Cache::add_entry(const std::string &name,
+                      const int cycle,
+                      const conduit::Node &value,
+                      const double time,
+                      const bool valid_time)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  // check the cache for signs of time travel
+  // i.e., someone could have restarted the simulation from the beginning
+  // or from some earlier checkpoint
+  // There are a couple conditions:
+  // 0) only check one time on startup
+  // 1) only filter if we haven't done so before
+  // 2) only filter if we detect time travel
+  // 3) only filter if we have state/time
+  if(!m_time_checked &&
+     !filtered() &&
+     time <= last_known_time() &&
+     valid_time)
+  {
+    // remove all cache entries that occur in the future
+    filter_time(time);
+  }
+  m_time_checked = true;
+
+  last_known_time(time);
+
+  std::stringstream cache_entry;
+  cache_entry << name << "/" << cycle;
+
+  // re-evaluating an expression in the same cycle replaces its entry
+  const bool replaced = m_data.has_path(cache_entry.str());
+  m_data[cache_entry.str()] = value;
+
+  auto windows = m_windows.find(name);
+  if(windows == m_windows.end())
+  {
+    return;
+  }
+  double scalar, scalar_time;
+  if(replaced || !detail::scalar_entry(value, scalar, scalar_time))
+  {
+    // can't take a value back out of a window, recreate them on next use
+    m_windows.erase(windows);
+    return;
+  }
+  for(auto &window : windows->second)
+  {
+    window.second->push(scalar, scalar_time);
+  }
+}
+
+bool Cache::window_value(const std::string &name,
+                         const std::string &op,
+                         const double param,
+                         double &value)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if(!m_data.has_path(name))
+  {
+    return false;
+  }
+  std::stringstream key;
+  key << op << "/" << param;
+  std::map<std::string, std::shared_ptr<HistoryWindow>> &windows =
+    m_windows[name];
+  auto window = windows.find(key.str());
+  if(window == windows.end())
+  {
+    // catch up on the history so far
+    std::shared_ptr<HistoryWindow> new_window =
+      std::make_shared<HistoryWindow>(op, param);
+    const conduit::Node &history = m_data[name];
+    const int entries = history.number_of_children();
+    for(int i = 0; i < entries; ++i)
+    {
+      double scalar, scalar_time;
+      if(!detail::scalar_entry(history.child(i), scalar, scalar_time))
+      {
+        ASCENT_ERROR(op << ": expression '" << name
+                        << "' does not evaluate to a number");
+      }
+      new_window->push(scalar, scalar_time);
+    }
+    window = windows.insert(std::make_pair(key.str(), new_window)).first;
+  }
+  value = window->second->value();
+  return true;
+}
+
 Cache::~Cache()
 {
   save();
@@ -234,6 +501,11 @@ register_builtin()
   flow::Workspace::register_filter_type<expressions::Integer>();
   flow::Workspace::register_filter_type<expressions::Identifier>();
   flow::Workspace::register_filter_type<expressions::History>();
+  flow::Workspace::register_filter_type<expressions::RollingAvg>();
+  flow::Workspace::register_filter_type<expressions::RollingMax>();
+  flow::Workspace::register_filter_type<expressions::RollingMin>();
+  flow::Workspace::register_filter_type<expressions::Ema>();
+  flow::Workspace::register_filter_type<expressions::Derivative>();
   flow::Workspace::register_filter_type<expressions::BinaryOp>();
   flow::Workspace::register_filter_type<expressions::String>();
   flow::Workspace::register_filter_type<expressions::ExpressionList>();
@@ -264,6 +536,7 @@ register_builtin()
   flow::Workspace::register_filter_type<expressions::Pdf>();
   flow::Workspace::register_filter_type<expressions::Cdf>();
   flow::Workspace::register_filter_type<expressions::Quantile>();
+  flow::Workspace::register_filter_type<expressions::FieldQuantile>();
   flow::Workspace::register_filter_type<expressions::BinByValue>();
   flow::Workspace::register_filter_type<expressions::BinByIndex>();
   flow::Workspace::register_filter_type<expressions::Cycle>();
@@ -274,6 +547,9 @@ register_builtin()
   flow::Workspace::register_filter_type<expressions::Bin>();
   flow::Workspace::register_filter_type<expressions::Bounds>();
   flow::Workspace::register_filter_type<expressions::Lineout>();
+  flow::Workspace::register_filter_type<expressions::SamplePoints>();
+  flow::Workspace::register_filter_type<expressions::Probe>();
+  flow::Workspace::register_filter_type<expressions::NearestVertex>();
 
   initialize_functions();
   initialize_objects();
@@ -298,6 +574,7 @@ ExpressionEval::load_cache(const std::string &dir,
                            const std::string &session)
 {
   // the cache is static so don't load if we already have
+  std::lock_guard<std::mutex> lock(m_cache.m_mutex);
   if(!m_cache.loaded())
   {
     m_cache.load(dir,session);
@@ -305,12 +582,12 @@ ExpressionEval::load_cache(const std::string &dir,
 }
 
 void
-count_params()
+count_params(conduit::Node &functions)
 {
-  const int num_functions = g_function_table.number_of_children();
+  const int num_functions = functions.number_of_children();
   for(int i = 0; i < num_functions; ++i)
   {
-    conduit::Node &function = g_function_table.child(i);
+    conduit::Node &function = functions.child(i);
     const int num_overloads = function.number_of_children();
     for(int o = 0; o < num_overloads; ++o)
     {
@@ -347,9 +624,12 @@ count_params()
 void
 initialize_functions()
 {
-  // functions
-  g_function_table.reset();
-  conduit::Node *functions = &g_function_table;
+  // functions, built into a copy of the current tables so evaluations
+  // already in flight keep seeing the old ones
+  std::shared_ptr<SymbolTables> tables
+    = std::make_shared<SymbolTables>(*symbol_tables());
+  tables->m_functions.reset();
+  conduit::Node *functions = &tables->m_functions;
 
   // -------------------------------------------------------------
 
@@ -579,6 +859,81 @@ initialize_functions()
 
   // -------------------------------------------------------------
 
+  conduit::Node &rolling_avg_sig = (*functions)["rolling_avg"].append();
+  rolling_avg_sig["return_type"] = "double";
+  rolling_avg_sig["filter_name"] = "rolling_avg";
+  rolling_avg_sig["args/expr_name/type"] = "anytype";
+  rolling_avg_sig["args/expr_name/description"] =
+      "The name of a scalar expression that was evaluated in the past.";
+  rolling_avg_sig["args/window/type"] = "int";
+  rolling_avg_sig["args/window/description"] =
+      "The number of evaluations to average over.";
+  rolling_avg_sig["description"] =
+      "Return the average of the last ``window`` evaluations of an "
+      "expression, including the current one. For example, "
+      "``rolling_avg(energy, 10)``.";
+
+  // -------------------------------------------------------------
+
+  conduit::Node &rolling_max_sig = (*functions)["rolling_max"].append();
+  rolling_max_sig["return_type"] = "double";
+  rolling_max_sig["filter_name"] = "rolling_max";
+  rolling_max_sig["args/expr_name/type"] = "anytype";
+  rolling_max_sig["args/expr_name/description"] =
+      "The name of a scalar expression that was evaluated in the past.";
+  rolling_max_sig["args/window/type"] = "int";
+  rolling_max_sig["args/window/description"] =
+      "The number of evaluations to take the maximum over.";
+  rolling_max_sig["description"] =
+      "Return the maximum of the last ``window`` evaluations of an "
+      "expression, including the current one.";
+
+  // -------------------------------------------------------------
+
+  conduit::Node &rolling_min_sig = (*functions)["rolling_min"].append();
+  rolling_min_sig["return_type"] = "double";
+  rolling_min_sig["filter_name"] = "rolling_min";
+  rolling_min_sig["args/expr_name/type"] = "anytype";
+  rolling_min_sig["args/expr_name/description"] =
+      "The name of a scalar expression that was evaluated in the past.";
+  rolling_min_sig["args/window/type"] = "int";
+  rolling_min_sig["args/window/description"] =
+      "The number of evaluations to take the minimum over.";
+  rolling_min_sig["description"] =
+      "Return the minimum of the last ``window`` evaluations of an "
+      "expression, including the current one.";
+
+  // -------------------------------------------------------------
+
+  conduit::Node &ema_sig = (*functions)["ema"].append();
+  ema_sig["return_type"] = "double";
+  ema_sig["filter_name"] = "ema";
+  ema_sig["args/expr_name/type"] = "anytype";
+  ema_sig["args/expr_name/description"] =
+      "The name of a scalar expression that was evaluated in the past.";
+  ema_sig["args/alpha/type"] = "scalar";
+  ema_sig["args/alpha/description"] =
+      "Smoothing factor in ``(0, 1]``. Larger values discount older "
+      "evaluations faster.";
+  ema_sig["description"] =
+      "Return the exponential moving average of the evaluations of an "
+      "expression, ``avg = alpha * val + (1 - alpha) * previous avg``, "
+      "starting from the first evaluation.";
+
+  // -------------------------------------------------------------
+
+  conduit::Node &derivative_sig = (*functions)["derivative"].append();
+  derivative_sig["return_type"] = "double";
+  derivative_sig["filter_name"] = "derivative";
+  derivative_sig["args/expr_name/type"] = "anytype";
+  derivative_sig["args/expr_name/description"] =
+      "The name of a scalar expression that was evaluated in the past.";
+  derivative_sig["description"] =
+      "Return the rate of change of an expression with respect to simulation "
+      "time between its last two evaluations.";
+
+  // -------------------------------------------------------------
+
   conduit::Node &entropy_sig = (*functions)["entropy"].append();
   entropy_sig["return_type"] = "double";
   entropy_sig["filter_name"] = "entropy";
@@ -691,6 +1046,86 @@ initialize_functions()
   lineout["args/empty_val/optional"];
   lineout["description"] = "returns a sampled based line out";
 
+  conduit::Node &lineouts = (*functions)["lineout"].append();
+  lineouts["return_type"] = "array";
+  lineouts["filter_name"] = "lineout";
+  lineouts["args/samples/type"] = "int";
+  lineouts["args/samples/description"] = "samples per line";
+  lineouts["args/start/type"] = "list";
+  lineouts["args/start/description"] = "start point of each line";
+  lineouts["args/end/type"] = "list";
+  lineouts["args/end/description"] = "end point of each line";
+  lineouts["args/fields/type"] = "list";
+  lineouts["args/fields/optional"];
+  lineouts["args/empty_val/type"] = "double";
+  lineouts["args/empty_val/optional"];
+  lineouts["description"] = "Sample several lines at once. The samples of "
+    "all lines are located with one spatial index and exchanged in one "
+    "reduction.";
+
+  // -------------------------------------------------------------
+
+  conduit::Node &sample_points_sig = (*functions)["sample_points"].append();
+  sample_points_sig["return_type"] = "array";
+  sample_points_sig["filter_name"] = "sample_points";
+  sample_points_sig["args/points/type"] = "list";
+  sample_points_sig["args/points/description"] = "list of vectors";
+  sample_points_sig["args/fields/type"] = "list";
+  sample_points_sig["args/fields/optional"];
+  sample_points_sig["args/fields/description"] =
+    "scalar fields to sample, defaults to all of them";
+  sample_points_sig["args/empty_val/type"] = "double";
+  sample_points_sig["args/empty_val/optional"];
+  sample_points_sig["args/empty_val/description"] = "defaults to ``0``";
+  sample_points_sig["description"] = "Sample scalar fields at a set of "
+    "points. Vertex fields are interpolated and element fields take the "
+    "value of the element containing the point.";
+
+  // -------------------------------------------------------------
+
+  conduit::Node &probe_sig = (*functions)["probe"].append();
+  probe_sig["return_type"] = "double";
+  probe_sig["filter_name"] = "probe";
+  probe_sig["args/arg1/type"] = "field";
+  probe_sig["args/points/type"] = "vector";
+  probe_sig["args/empty_val/type"] = "double";
+  probe_sig["args/empty_val/optional"];
+  probe_sig["args/empty_val/description"] = "defaults to ``0``";
+  probe_sig["description"] = "Return the value of a scalar field at a point. "
+    "Vertex fields are interpolated and element fields take the value of the "
+    "element containing the point.";
+
+  conduit::Node &probe_list_sig = (*functions)["probe"].append();
+  probe_list_sig["return_type"] = "array";
+  probe_list_sig["filter_name"] = "probe";
+  probe_list_sig["args/arg1/type"] = "field";
+  probe_list_sig["args/points/type"] = "list";
+  probe_list_sig["args/empty_val/type"] = "double";
+  probe_list_sig["args/empty_val/optional"];
+  probe_list_sig["args/empty_val/description"] = "defaults to ``0``";
+  probe_list_sig["description"] = "Return the values of a scalar field at a "
+    "list of points, gathered from all ranks in one exchange.";
+
+  // -------------------------------------------------------------
+
+  conduit::Node &nearest_vertex_sig = (*functions)["nearest_vertex"].append();
+  nearest_vertex_sig["return_type"] = "value_position";
+  nearest_vertex_sig["filter_name"] = "nearest_vertex";
+  nearest_vertex_sig["args/arg1/type"] = "field";
+  nearest_vertex_sig["args/points/type"] = "vector";
+  nearest_vertex_sig["description"] = "Return the value and position of a "
+    "vertex field at the vertex closest to a point, and the distance to it.";
+
+  conduit::Node &nearest_vertex_list_sig =
+    (*functions)["nearest_vertex"].append();
+  nearest_vertex_list_sig["return_type"] = "array";
+  nearest_vertex_list_sig["filter_name"] = "nearest_vertex";
+  nearest_vertex_list_sig["args/arg1/type"] = "field";
+  nearest_vertex_list_sig["args/points/type"] = "list";
+  nearest_vertex_list_sig["description"] = "Return the values of a vertex "
+    "field at the vertices closest to a list of points, found over all ranks "
+    "in one exchange.";
+
   // -------------------------------------------------------------
 
   conduit::Node &quantile_sig = (*functions)["quantile"].append();
@@ -718,6 +1153,36 @@ initialize_functions()
   the axis of `cdf`. For example, if `q` is 0.5 the result is the value on the \
   x-axis which 50 percent of the data lies below.";
 
+  conduit::Node &field_quantile_sig = (*functions)["quantile"].append();
+  field_quantile_sig["return_type"] = "double";
+  field_quantile_sig["filter_name"] = "field_quantile";
+  field_quantile_sig["args/arg1/type"] = "field";
+
+  field_quantile_sig["args/q/type"] = "double";
+  field_quantile_sig["args/q/description"] =
+      "Quantile between 0 and 1 inclusive.";
+
+  field_quantile_sig["args/method/type"] = "string";
+  field_quantile_sig["args/method/optional"];
+  field_quantile_sig["args/method/description"] =
+      "Specifies how the quantile is computed: \n\n \
+  - sketch (default): merge streaming quantile sketches computed on every \
+  rank. \n \
+  - exact: keep every value. Only meant for small data.";
+
+  field_quantile_sig["args/error/type"] = "double";
+  field_quantile_sig["args/error/optional"];
+  field_quantile_sig["args/error/description"] =
+      "Bound on the rank error of the sketch as a fraction of the number of \
+  values, defaults to ``0.001``. The rank of the result is within \
+  ``error * n`` of ``q * n``. Memory use grows with ``1 / error``.";
+
+  field_quantile_sig["description"] = "Return the `q`-th quantile of the \
+  values of a field without a histogram. For example, if `q` is 0.99 the \
+  result is the value which 99 percent of the data lies below. The result \
+  has the attributes ``error``, the bound on its rank error as a fraction \
+  of the number of values, and ``count``, the number of values.";
+
   // -------------------------------------------------------------
 
   conduit::Node &axis_sig = (*functions)["axis"].append();
@@ -800,17 +1265,20 @@ initialize_functions()
 
   // -------------------------------------------------------------
 
-  count_params();
+  count_params(*functions);
   // functions->save("functions.json", "json");
   // TODO: validate that there are no ambiguities
+  publish_symbol_tables(tables);
 }
 
 void
 initialize_objects()
 {
   // object type definitions
-  g_object_table.reset();
-  conduit::Node *objects = &g_object_table;
+  std::shared_ptr<SymbolTables> tables
+    = std::make_shared<SymbolTables>(*symbol_tables());
+  tables->m_objects.reset();
+  conduit::Node *objects = &tables->m_objects;
 
   conduit::Node &histogram = (*objects)["histogram/attrs"];
   histogram["value/type"] = "array";
@@ -839,6 +1307,7 @@ initialize_objects()
   bin_atts["value/type"] = "double";
 
   //objects->save("objects.json", "json");
+  publish_symbol_tables(tables);
 }
 
 conduit::Node
@@ -849,16 +1318,23 @@ ExpressionEval::evaluate(const std::string expr, std::string expr_name)
     expr_name = expr;
   }
 
+#ifdef ASCENT_MPI_ENABLED
+  SerialEvaluation serial;
+#endif
+  // keep the tables alive for the whole evaluation
+  std::shared_ptr<SymbolTables> tables = symbol_tables();
+
   w.registry().add<DataObject>("dataset", &m_data_object, -1);
-  w.registry().add<conduit::Node>("cache", &m_cache.m_data, -1);
-  w.registry().add<conduit::Node>("function_table", &g_function_table, -1);
-  w.registry().add<conduit::Node>("object_table", &g_object_table, -1);
+  w.registry().add<Cache>("cache", &m_cache, -1);
+  w.registry().add<conduit::Node>("function_table", &tables->m_functions, -1);
+  w.registry().add<conduit::Node>("object_table", &tables->m_objects, -1);
   int cycle = get_state_var(*m_data_object.as_node().get(), "cycle").to_int32();
   w.registry().add<int>("cycle", &cycle, -1);
 
+  std::shared_ptr<ASTExpression> expression;
   try
   {
-    scan_string(expr.c_str());
+    expression = g_parsed_expressions.get(expr);
   }
   catch(const char *msg)
   {
@@ -866,8 +1342,6 @@ ExpressionEval::evaluate(const std::string expr, std::string expr_name)
     ASCENT_ERROR("Expression parsing error: " << msg << " in '" << expr << "'");
   }
 
-  ASTExpression *expression = get_result();
-
   conduit::Node root;
   try
   {
@@ -879,15 +1353,16 @@ ExpressionEval::evaluate(const std::string expr, std::string expr_name)
   }
   catch(std::exception &e)
   {
-    delete expression;
     w.reset();
     ASCENT_ERROR("Error while executing expression '" << expr
                                                       << "': " << e.what());
   }
   std::string filter_name = root["filter_name"].as_string();
 
+  // take the result instead of copying it, the registry is reset below
   conduit::Node *n_res = w.registry().fetch<conduit::Node>(filter_name);
-  conduit::Node return_val = *n_res;
+  conduit::Node return_val;
+  return_val.swap(*n_res);
 
   // add the sim time
   conduit::Node n_time = get_state_var(*m_data_object.as_node().get(), "time");
@@ -900,34 +1375,8 @@ ExpressionEval::evaluate(const std::string expr, std::string expr_name)
   }
   return_val["time"] = time;
 
-  // check the cache for signs of time travel
-  // i.e., someone could have restarted the simulation from the beginning
-  // or from some earlier checkpoint
-  // There are a couple conditions:
-  // 0) only check one time on startup
-  // 1) only filter if we haven't done so before
-  // 2) only filter if we detect time travel
-  // 3) only filter if we have state/time
-  static bool first_execute = true;
-
-  if(first_execute &&
-     !m_cache.filtered() &&
-     time <= m_cache.last_known_time() &&
-     valid_time)
-  {
-    // remove all cache entries that occur in the future
-    m_cache.filter_time(time);
-  }
-  first_execute = false;
-
-  m_cache.last_known_time(time);
-
-  std::stringstream cache_entry;
-  cache_entry << expr_name << "/" << cycle;
-
-  m_cache.m_data[cache_entry.str()] = return_val;
+  m_cache.add_entry(expr_name, cycle, return_val, time, valid_time);
 
-  delete expression;
   w.reset();
   return return_val;
 }
@@ -941,17 +1390,21 @@ ExpressionEval::get_cache()
 void
 ExpressionEval::reset_cache()
 {
+  std::lock_guard<std::mutex> lock(m_cache.m_mutex);
   m_cache.m_data.reset();
+  m_cache.m_windows.clear();
 }
 
 void
 ExpressionEval::save_cache()
 {
+  std::lock_guard<std::mutex> lock(m_cache.m_mutex);
   m_cache.save();
 }
 
 void ExpressionEval::get_last(conduit::Node &data)
 {
+  std::lock_guard<std::mutex> lock(m_cache.m_mutex);
   data.reset();
   const int entries = m_cache.m_data.number_of_children();
 
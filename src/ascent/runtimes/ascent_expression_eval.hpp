@@ -56,6 +56,10 @@
 #include <ascent_data_object.hpp>
 
 #include "flow_workspace.hpp"
+
+#include <map>
+#include <memory>
+#include <mutex>
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
 //-----------------------------------------------------------------------------
@@ -71,6 +75,8 @@ namespace runtime
 namespace expressions
 {
 
+class HistoryWindow;
+
 void ASCENT_API register_builtin();
 void ASCENT_API initialize_functions();
 void ASCENT_API initialize_objects();
@@ -81,7 +87,15 @@ struct Cache
   int m_rank;
   bool m_filtered = false;
   bool m_loaded = false;
+  bool m_time_checked = false;
   std::string m_session_file;
+  // windowed statistics over the scalar history of expressions, kept up
+  // to date as entries are added. expression name -> op and param -> window
+  std::map<std::string,
+           std::map<std::string, std::shared_ptr<HistoryWindow>>> m_windows;
+  // guards m_data and m_windows. The accessors below take it themselves, everything
+  // else expects the caller to hold it.
+  std::mutex m_mutex;
 
   void load(const std::string &dir,
             const std::string &session);
@@ -93,6 +107,31 @@ struct Cache
   bool loaded();
   void save();
 
+  // thread safe accessors used by concurrently executing expressions.
+  // Entries are copied out since other evaluations may be adding to
+  // the cache while the caller holds onto them.
+  bool last_entry(const std::string &name, conduit::Node &entry);
+  // copies one entry of the history of name: index entries back from the
+  // newest (the newest itself if index is past the oldest) when from_end
+  // is set, otherwise the entry at index if there is one. entries is set
+  // to the history length.
+  bool history_entry(const std::string &name,
+                     const int index,
+                     const bool from_end,
+                     conduit::Node &entry,
+                     int &entries);
+  void add_entry(const std::string &name,
+                 const int cycle,
+                 const conduit::Node &value,
+                 const double time,
+                 const bool valid_time);
+  // current value of a HistoryWindow over the history of name, created
+  // from the history so far the first time it is asked for
+  bool window_value(const std::string &name,
+                    const std::string &op,
+                    const double param,
+                    double &value);
+
   ~Cache();
 };
 
@@ -108,6 +147,8 @@ public:
   ExpressionEval(DataObject &dataset);
   ExpressionEval(conduit::Node *dataset);
 
+  // the returned node is only safe to use while no expressions
+  // are being evaluated
   static const conduit::Node &get_cache();
   static void get_last(conduit::Node &data);
   static void reset_cache();
@@ -115,6 +156,10 @@ public:
                          const std::string &session);
   static void save_cache();
 
+  // may be called from several threads at once, except when Ascent is
+  // built with MPI. Expressions issue MPI collectives, so MPI builds
+  // raise an error if a second thread starts evaluating while another
+  // evaluation is running.
   conduit::Node evaluate(const std::string expr, std::string exp_name = "");
 };
 
@@ -73,16 +73,21 @@
 #include <ascent_actions_utils.hpp>
 #include <ascent_metadata.hpp>
 #include <ascent_runtime_filters.hpp>
+#include <ascent_runtime_param_check.hpp>
+#include <ascent_runtime_scratch_arena.hpp>
 #include <ascent_expression_eval.hpp>
 #include <expressions/ascent_blueprint_architect.hpp>
 #include <ascent_transmogrifier.hpp>
 #include <ascent_data_object.hpp>
+#include <ascent_mpi_utils.hpp>
 
 #if defined(ASCENT_VTKM_ENABLED)
 #include <vtkm/cont/Error.h>
 #include <vtkh/vtkh.hpp>
 #include <vtkh/Error.hpp>
 #include <vtkh/Logger.hpp>
+#include <ascent_runtime_derived_fields.hpp>
+#include <ascent_vtkh_data_adapter.hpp>
 
 #ifdef VTKM_CUDA
 #include <vtkm/cont/cuda/ChooseCudaDevice.h>
@@ -136,11 +141,16 @@ int InfoHandler::m_rank = 0;
 AscentRuntime::AscentRuntime()
 :Runtime(),
  m_refinement_level(2), // default refinement level for high order meshes
+ m_external_data_object(nullptr),
  m_rank(0),
  m_default_output_dir("."),
  m_session_name("ascent_session"),
- m_field_filtering(false)
+ m_field_filtering(false),
+ m_derived_fields(nullptr)
 {
+#if defined(ASCENT_VTKM_ENABLED)
+    m_derived_fields = new runtime::filters::DerivedFieldTable();
+#endif
     m_ghost_fields.append() = "ascent_ghosts";
     flow::filters::register_builtin();
     ResetInfo();
@@ -150,6 +160,9 @@ AscentRuntime::AscentRuntime()
 AscentRuntime::~AscentRuntime()
 {
     Cleanup();
+#if defined(ASCENT_VTKM_ENABLED)
+    delete m_derived_fields;
+#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -243,6 +256,21 @@ AscentRuntime::Initialize(const conduit::Node &options)
 
     m_runtime_options = options;
 
+    if(options.has_path("trace") &&
+       options["trace"].as_string() == "true")
+    {
+      if(options.has_path("trace_buffer_size"))
+      {
+        flow::Trace::set_buffer_capacity(options["trace_buffer_size"].to_int32());
+      }
+      flow::Trace::set_rank(m_rank);
+#ifdef ASCENT_MPI_ENABLED
+      // line up the trace epochs across ranks
+      MPI_Barrier(comm);
+#endif
+      flow::Trace::enable();
+    }
+
     if(options.has_path("ghost_field_name"))
     {
       if(options["ghost_field_name"].dtype().is_string())
@@ -298,6 +326,28 @@ AscentRuntime::Initialize(const conduit::Node &options)
         m_web_interface.Enable();
     }
 
+    if(options.has_path("memory_budget"))
+    {
+      if(!options["memory_budget"].dtype().is_number())
+      {
+        ASCENT_ERROR("'memory_budget' must be a number of bytes");
+      }
+      w.set_memory_budget(options["memory_budget"].to_index_t());
+      // conversions dropped under the budget can be collective to
+      // rebuild, so all ranks release at the same filter
+      w.set_memory_budget_agreement(&global_someone_agrees);
+    }
+
+    if(options.has_path("scratch_memory_limit"))
+    {
+      if(!options["scratch_memory_limit"].dtype().is_number())
+      {
+        ASCENT_ERROR("'scratch_memory_limit' must be a number of bytes");
+      }
+      runtime::filters::ScratchArena::set_global_limit(
+        options["scratch_memory_limit"].to_index_t());
+    }
+
     if(options.has_path("field_filtering"))
     {
       if(options["field_filtering"].as_string() == "true")
@@ -306,6 +356,37 @@ AscentRuntime::Initialize(const conduit::Node &options)
       }
     }
 
+#if defined(ASCENT_VTKM_ENABLED)
+    // integer field types passed to vtk-m without converting to float64
+    std::vector<std::string> native_types;
+    if(options.has_path("native_field_types"))
+    {
+      const conduit::Node &n_types = options["native_field_types"];
+      if(n_types.dtype().is_string())
+      {
+        native_types.push_back(n_types.as_string());
+      }
+      else if(n_types.dtype().is_list())
+      {
+        const int num_children = n_types.number_of_children();
+        for(int i = 0; i < num_children; ++i)
+        {
+          const conduit::Node &child = n_types.child(i);
+          if(!child.dtype().is_string())
+          {
+            ASCENT_ERROR("native_field_types list child is not a string");
+          }
+          native_types.push_back(child.as_string());
+        }
+      }
+      else
+      {
+        ASCENT_ERROR("native_field_types is not a string or a list");
+      }
+    }
+    VTKHDataAdapter::SetNativeFieldTypes(native_types);
+#endif
+
     Node msg;
     ascent::about(msg["about"]);
     msg["options"] = options;
@@ -353,12 +434,49 @@ AscentRuntime::Cleanup()
         ftimings << w.timing_info();
         ftimings.close();
     }
+
+    if(m_runtime_options.has_child("trace") &&
+       m_runtime_options["trace"].as_string() == "true" &&
+       flow::Trace::enabled())
+    {
+        flow::Trace::disable();
+        // gather all ranks events into a single chrome trace
+        std::vector<std::string> events;
+        events.push_back(flow::Trace::events_json());
+#ifdef ASCENT_MPI_ENABLED
+        MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
+        Node n_events, n_all_events;
+        n_events.set(events[0]);
+        conduit::relay::mpi::gather_using_schema(n_events,
+                                                 n_all_events,
+                                                 0,
+                                                 mpi_comm);
+        events.clear();
+        if(m_rank == 0)
+        {
+          const int num_ranks = n_all_events.number_of_children();
+          for(int i = 0; i < num_ranks; ++i)
+          {
+            events.push_back(n_all_events.child(i).as_string());
+          }
+        }
+#endif
+        if(m_rank == 0)
+        {
+          std::string file_name
+            = conduit::utils::join_file_path(m_default_output_dir,
+                                             "ascent_trace.json");
+          flow::Trace::write_chrome_trace(file_name, events);
+        }
+        flow::Trace::clear();
+    }
 }
 
 //-----------------------------------------------------------------------------
 void
 AscentRuntime::Publish(const conduit::Node &data)
 {
+    FLOW_TRACE_SCOPE("ascent::publish");
     blueprint::mesh::to_multi_domain(data, m_source);
     EnsureDomainIds();
     // filter out default ghost name and
@@ -1098,14 +1216,25 @@ AscentRuntime::PopulateMetadata()
 void
 AscentRuntime::ConnectSource()
 {
-    // There is no promise that all data can be zero copied
-    // and conversions to vtkh/low order will be invalid.
-    // We must reset the source object
-    conduit::Node *data_node = new conduit::Node();
-    data_node->set_external(m_source);
-    m_data_object.reset(data_node);
-
-    SourceFieldFilter();
+    DataObject *source_object = &m_data_object;
+    if(m_external_data_object != nullptr)
+    {
+      // the data object belongs to a parent runtime that has
+      // already published it. Use it as is so any conversions
+      // it holds are not thrown away.
+      source_object = m_external_data_object;
+    }
+    else
+    {
+      // There is no promise that all data can be zero copied
+      // and conversions to vtkh/low order will be invalid.
+      // We must reset the source object
+      conduit::Node *data_node = new conduit::Node();
+      data_node->set_external(m_source);
+      m_data_object.reset(data_node);
+
+      SourceFieldFilter();
+    }
 
     // note: if the reg entry for data was already added
     // the set_external updates everything,
@@ -1114,7 +1243,7 @@ AscentRuntime::ConnectSource()
     if(!w.registry().has_entry("_ascent_input_data"))
     {
         w.registry().add<DataObject>("_ascent_input_data",
-                                     &m_data_object);
+                                     source_object);
     }
 
     if(!w.graph().has_filter("source"))
@@ -1575,6 +1704,12 @@ AscentRuntime::Execute(const conduit::Node &actions)
     try
     {
         ResetInfo();
+        // expression valued params are memoized for this execute only
+        m_expression_params.reset();
+#if defined(ASCENT_VTKM_ENABLED)
+        // derived fields are shared between pipelines for this execute only
+        m_derived_fields->reset();
+#endif
 
         conduit::Node diff_info;
         bool different_actions = m_previous_actions.diff(actions, diff_info);
@@ -1611,11 +1746,30 @@ AscentRuntime::Execute(const conduit::Node &actions)
 
         m_previous_actions = actions;
 
-        PopulateMetadata(); // add metadata so filters can access it
+        DataObject *source_object = &m_data_object;
+        if(m_external_data_object != nullptr)
+        {
+          // the parent runtime has already populated the metadata
+          source_object = m_external_data_object;
+        }
+        else
+        {
+          PopulateMetadata(); // add metadata so filters can access it
+        }
 
         // add the source to the registry so we can access information
-        // about the original mesh (like bounds)
-        w.registry().add<DataObject>("source_object", &m_data_object,1);
+        // about the original mesh (like bounds). Its conversions are
+        // shared by every pipeline (and trigger), so the memory budget
+        // does not drop them
+        source_object->keep_conversions(true);
+        w.registry().add<DataObject>("source_object", source_object,1);
+        // triggers start their child runtimes with our options
+        w.registry().add<Node>("runtime_options", &m_runtime_options, -1);
+#if defined(ASCENT_VTKM_ENABLED)
+        w.registry().add<runtime::filters::DerivedFieldTable>("derived_fields",
+                                                              m_derived_fields,
+                                                              -1);
+#endif
 
         w.info(m_info["flow_graph"]);
         m_info["actions"] = actions;
@@ -1633,9 +1787,59 @@ AscentRuntime::Execute(const conduit::Node &actions)
         ss<<"cycle_"<<cycle;
         vtkh::DataLogger::GetInstance()->OpenLogEntry(ss.str());
         vtkh::DataLogger::GetInstance()->AddLogData("cycle", cycle);
+#endif
+#ifdef ASCENT_MPI_ENABLED
+        if(w.memory_budget() > 0)
+        {
+          // the memory aware plan orders the filters, so every rank must
+          // plan with the same estimates: use the largest seen on any rank
+          MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
+          Node n_local, n_all, n_max;
+          n_local["rank"] = m_rank;
+          w.output_size_estimates(n_local["estimates"]);
+          conduit::relay::mpi::all_gather_using_schema(n_local,
+                                                       n_all,
+                                                       mpi_comm);
+          const int num_ranks = n_all.number_of_children();
+          for(int i = 0; i < num_ranks; ++i)
+          {
+            NodeConstIterator est_itr = n_all.child(i)["estimates"].children();
+            while(est_itr.has_next())
+            {
+              const index_t est = est_itr.next().to_index_t();
+              const std::string name = est_itr.name();
+              if(!n_max.has_child(name))
+              {
+                n_max.add_child(name) = est;
+              }
+              else if(n_max.child(name).to_index_t() < est)
+              {
+                n_max.child(name) = est;
+              }
+            }
+          }
+          w.set_output_size_estimates(n_max);
+        }
 #endif
         // now execute the data flow graph
-        w.execute();
+        {
+          FLOW_TRACE_SCOPE("ascent::execute");
+          // our filters use our memo, a trigger's child runtime
+          // installs its own and puts ours back when it is done
+          runtime::filters::ExpressionParamScope param_scope(&m_expression_params);
+          w.execute();
+        }
+        // per filter execution times for this call
+        m_info["filter_timings"] = w.last_execution_timings();
+        // per filter memory use for this call
+        m_info["filter_memory"] = w.last_execution_memory();
+        // expression valued params evaluated and shared between filters
+        m_expression_params.info(m_info["expression_params"]);
+#if defined(ASCENT_VTKM_ENABLED)
+        // derived fields computed and shared between pipelines
+        m_derived_fields->info(m_info["derived_fields"]);
+        m_derived_fields->release();
+#endif
 
 #if defined(ASCENT_VTKM_ENABLED)
         vtkh::DataLogger::GetInstance()->CloseLogEntry();
@@ -1704,7 +1908,7 @@ AscentRuntime::Execute(const conduit::Node &actions)
     catch(conduit::Error &e)
     {
       w.reset();
-      throw e;
+      throw;
     }
     catch(std::exception &e)
     {
@@ -1718,6 +1922,36 @@ AscentRuntime::Execute(const conduit::Node &actions)
     }
 }
 
+//-----------------------------------------------------------------------------
+void
+AscentRuntime::ExecuteDataObject(DataObject *data_object,
+                                 const conduit::Node &actions)
+{
+    if(data_object == nullptr || !data_object->is_valid())
+    {
+      ASCENT_ERROR("ExecuteDataObject: invalid data object");
+    }
+
+    // the parent runtime has already verified the ghosts and
+    // painted nestsets, so inherit its list of ghost fields
+    if(Metadata::n_metadata.has_path("ghost_field"))
+    {
+      m_ghost_fields = Metadata::n_metadata["ghost_field"];
+    }
+
+    m_external_data_object = data_object;
+    try
+    {
+      Execute(actions);
+    }
+    catch(conduit::Error &e)
+    {
+      m_external_data_object = nullptr;
+      throw;
+    }
+    m_external_data_object = nullptr;
+}
+
 //-----------------------------------------------------------------------------
 void
 AscentRuntime::DisplayError(const std::string &msg)
@@ -57,6 +57,7 @@
 #include <ascent_runtime.hpp>
 #include <ascent_data_object.hpp>
 #include <ascent_web_interface.hpp>
+#include <ascent_runtime_param_check.hpp>
 #include <flow.hpp>
 
 
@@ -67,6 +68,14 @@
 namespace ascent
 {
 
+namespace runtime
+{
+namespace filters
+{
+class DerivedFieldTable;
+}
+}
+
 class ASCENT_API AscentRuntime : public Runtime
 {
 public:
@@ -87,6 +96,13 @@ public:
 
     void DisplayError(const std::string &msg) override;
 
+    // Executes actions against a data object that was published (and
+    // possibly already converted) by another runtime. Publish is skipped,
+    // so vtkh and dray representations held by the data object are reused.
+    // Used by triggers to avoid re-publishing the mesh.
+    void  ExecuteDataObject(DataObject *data_object,
+                            const conduit::Node &actions);
+
     template <class FilterType>
     static void register_filter_type(const std::string &role_path = "",
                                      const std::string &api_name  = "")
@@ -102,6 +118,8 @@ private:
     // DataObject that (externally) holds the data from the simulation
     conduit::Node     m_source;
     DataObject        m_data_object;
+    // data object owned by a parent runtime (see ExecuteDataObject)
+    DataObject       *m_external_data_object;
     conduit::Node     m_connections;
     conduit::Node     m_scene_connections;
 
@@ -117,6 +135,13 @@ private:
 
     bool              m_field_filtering;
     std::set<std::string> m_field_list;
+    // expression valued params evaluated during an execute. The param
+    // getters have no workspace, so the memo is made current on the
+    // executing thread (ExpressionParamScope) instead of registered.
+    runtime::filters::ExpressionParamMemo m_expression_params;
+    // derived fields shared between pipelines
+    // (null when built without vtk-m)
+    runtime::filters::DerivedFieldTable *m_derived_fields;
 
     void              ResetInfo();
 
@@ -53,6 +53,14 @@
 #include "ascent_mpi_utils.hpp"
 #include "ascent_logging.hpp"
 
+#include <vtkh/utils/vtkm_dataset_info.hpp>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleCast.h>
+#include <vtkm/cont/ArrayHandleSOA.h>
+
+#include <algorithm>
+#include <limits>
+
 #if defined(ASCENT_MPI_ENABLED)
 #include <mpi.h>
 #include <conduit_relay_mpi.hpp>
@@ -65,49 +73,160 @@ namespace ascent
 namespace detail
 {
 //
-// returns true if all ranks say true
+// estimated bytes per component of a field array
 //
-bool global_has(bool local)
+conduit::index_t component_bytes(const vtkm::cont::VariantArrayHandle &data)
 {
-  bool has = local;
-#if defined(ASCENT_MPI_ENABLED)
-  int local_boolean = local ? 1 : 0;
-  int global_boolean;
-  MPI_Comm mpi_comm = MPI_Comm_f2c(vtkh::GetMPICommHandle());
-  MPI_Allreduce((void *)(&local_boolean),
-                (void *)(&global_boolean),
-                1,
-                MPI_INT,
-                MPI_SUM,
-                mpi_comm);
-
-  if(global_boolean == 0)
+  if(data.IsValueType<vtkm::Float32>() ||
+     data.IsValueType<vtkm::Vec<vtkm::Float32,3>>() ||
+     data.IsValueType<vtkm::Int32>() ||
+     data.IsValueType<vtkm::UInt32>())
   {
-    has = false;
+    return 4;
   }
-  else
+  if(data.IsValueType<vtkm::Int8>() ||
+     data.IsValueType<vtkm::UInt8>())
   {
-    has = true;
+    return 1;
   }
-#endif
-  return has;
+  return 8;
 }
 
-int global_max(int local)
+//
+// integer types the vtk-h data adapter can pass through natively
+//
+using NativeIntegerTypes = vtkm::List<vtkm::UInt8,
+                                      vtkm::Int32,
+                                      vtkm::Int64>;
+
+bool is_native_integer(const vtkm::cont::VariantArrayHandle &data)
 {
-   int global_count = local;
-#if defined(ASCENT_MPI_ENABLED)
+  return data.IsValueType<vtkm::UInt8>() ||
+         data.IsValueType<vtkm::Int32>() ||
+         data.IsValueType<vtkm::Int64>();
+}
 
-  MPI_Comm mpi_comm = MPI_Comm_f2c(vtkh::GetMPICommHandle());
-  MPI_Allreduce((void *)(&local),
-                (void *)(&global_count),
-                1,
-                MPI_INT,
-                MPI_MAX,
-                mpi_comm);
+struct CastToFloat64Functor
+{
+  template<typename T, typename S>
+  void operator()(const vtkm::cont::ArrayHandle<T,S> &array,
+                  vtkm::cont::ArrayHandle<vtkm::Float64> &output) const
+  {
+    vtkm::cont::ArrayCopy(vtkm::cont::make_ArrayHandleCast<vtkm::Float64>(array),
+                          output);
+  }
+};
+
+struct IntegerRangeFunctor
+{
+  template<typename T, typename S>
+  void operator()(const vtkm::cont::ArrayHandle<T,S> &array,
+                  vtkm::Range &range) const
+  {
+    auto portal = array.ReadPortal();
+    const vtkm::Id size = portal.GetNumberOfValues();
+    for(vtkm::Id i = 0; i < size; ++i)
+    {
+      range.Include(static_cast<vtkm::Float64>(portal.Get(i)));
+    }
+  }
+};
+
+//
+// per component ranges of a field. vtk-m only computes ranges for
+// its default type list, which does not have all the native integers
+//
+vtkm::cont::ArrayHandle<vtkm::Range> field_ranges(const vtkm::cont::Field &field)
+{
+  const vtkm::cont::VariantArrayHandle &data = field.GetData();
+  if(is_native_integer(data))
+  {
+    vtkm::Range range;
+    data.ResetTypes(NativeIntegerTypes{}).CastAndCall(IntegerRangeFunctor{}, range);
+    vtkm::cont::ArrayHandle<vtkm::Range> ranges;
+    ranges.Allocate(1);
+    ranges.WritePortal().Set(0, range);
+    return ranges;
+  }
+  // vtk-m caches field ranges, so this is only computed once
+  return field.GetRange();
+}
+
+std::string association_string(vtkm::cont::Field::Association assoc)
+{
+  if(assoc == vtkm::cont::Field::Association::POINTS)
+  {
+    return "vertex";
+  }
+  if(assoc == vtkm::cont::Field::Association::CELL_SET)
+  {
+    return "element";
+  }
+  return "other";
+}
+
+void bounds_to_node(const vtkm::Bounds &bounds, conduit::Node &n)
+{
+  n.set(conduit::DataType::float64(6));
+  double *vals = n.value();
+  vals[0] = bounds.X.Min;
+  vals[1] = bounds.X.Max;
+  vals[2] = bounds.Y.Min;
+  vals[3] = bounds.Y.Max;
+  vals[4] = bounds.Z.Min;
+  vals[5] = bounds.Z.Max;
+}
+
+vtkm::Bounds node_to_bounds(const conduit::Node &n)
+{
+  const double *vals = n.as_float64_ptr();
+  return vtkm::Bounds(vals[0], vals[1], vals[2], vals[3], vals[4], vals[5]);
+}
 
+//
+// exchanges the local descriptions with all ranks in a
+// single collective, returns a list with one entry per rank
+//
+void all_gather(conduit::Node &local, conduit::Node &all)
+{
+#if defined(ASCENT_MPI_ENABLED)
+  MPI_Comm mpi_comm = MPI_Comm_f2c(vtkh::GetMPICommHandle());
+  conduit::relay::mpi::all_gather_using_schema(local, all, mpi_comm);
+#else
+  all.reset();
+  all.append().set_external(local);
 #endif
-  return global_count;
+}
+
+//
+// describes the local part of a topology: its bounds and the
+// association of each of its fields
+//
+void describe_topology(const vtkh::DataSet &dataset, conduit::Node &topo)
+{
+  // GetDomain is non-const, copies of vtk-h data sets are shallow
+  vtkh::DataSet vtkh_dataset = dataset;
+  const vtkm::Id num_domains = vtkh_dataset.GetNumberOfDomains();
+  if(num_domains > 0)
+  {
+    bounds_to_node(vtkh_dataset.GetBounds(), topo["bounds"]);
+  }
+
+  conduit::Node &fields = topo["fields"];
+  fields.set(conduit::DataType::object());
+  for(vtkm::Id i = 0; i < num_domains; ++i)
+  {
+    const vtkm::cont::DataSet &dom = vtkh_dataset.GetDomain(i);
+    for(vtkm::IdComponent f = 0; f < dom.GetNumberOfFields(); ++f)
+    {
+      const vtkm::cont::Field &field = dom.GetField(f);
+      if(!fields.has_child(field.GetName()))
+      {
+        fields.add_child(field.GetName())["association"]
+          = association_string(field.GetAssociation());
+      }
+    }
+  }
 }
 
 } // namespace detail
@@ -120,143 +239,257 @@ void VTKHCollection::add(vtkh::DataSet &dataset, const std::string topology_name
     ASCENT_ERROR("VTKH collection already had topology '"<<topology_name<<"'");
   }
   m_datasets[topology_name] = dataset;
+
+  // the rest of the catalog is still valid, so only the
+  // new topology is exchanged
+  conduit::Node local;
+  detail::describe_topology(dataset, local["topologies"][topology_name]);
+
+  conduit::Node all;
+  detail::all_gather(local, all);
+  merge_catalog(all);
 }
 
-bool VTKHCollection::has_topology(const std::string name) const
+void VTKHCollection::merge_catalog(const conduit::Node &all)
 {
-  bool has_topo = m_datasets.count(name) != 0;
+  // a topology exists if it exists on any rank
+  const int num_ranks = all.number_of_children();
+  for(int r = 0; r < num_ranks; ++r)
+  {
+    conduit::NodeConstIterator t_itr = all.child(r)["topologies"].children();
+    while(t_itr.has_next())
+    {
+      const conduit::Node &topo = t_itr.next();
+      const std::string topo_name = t_itr.name();
+      vtkm::Bounds &bounds = m_topo_bounds[topo_name];
+      if(topo.has_child("bounds"))
+      {
+        bounds.Include(detail::node_to_bounds(topo["bounds"]));
+      }
+      // ranges are gathered the first time they are asked for
+      m_unranged_topologies.insert(topo_name);
 
-  return detail::global_has(has_topo);
+      conduit::NodeConstIterator itr = topo["fields"].children();
+      while(itr.has_next())
+      {
+        const conduit::Node &field = itr.next();
+        const std::string field_name = itr.name();
+        auto f_it = m_field_info.find(field_name);
+        // field names are unique, but if not, the first topology
+        // (by name) wins so every rank agrees
+        if(f_it == m_field_info.end() || topo_name < f_it->second.m_topology)
+        {
+          FieldInfo &info = m_field_info[field_name];
+          info.m_topology = topo_name;
+          info.m_association = field["association"].as_string();
+          info.m_ranges.clear();
+        }
+      }
+    }
+  }
 }
 
-std::string VTKHCollection::field_topology(const std::string field_name) {
-  std::string topo_name = "";
+void VTKHCollection::sync_ranges() const
+{
+  // only changes when topologies are added or removed, which
+  // every rank does together, so this needs no agreement
+  if(m_unranged_topologies.empty())
+  {
+    return;
+  }
 
-  for(auto it = m_datasets.begin(); it != m_datasets.end(); ++it)
+  // local per component ranges of the fields in the new topologies
+  conduit::Node local;
+  conduit::Node &fields = local["fields"];
+  fields.set(conduit::DataType::object());
+  for(const std::string &topo_name : m_unranged_topologies)
   {
-    // Should we really have to ask an MPI questions? its safer
-    if(it->second.FieldExists(field_name))
+    auto it = m_datasets.find(topo_name);
+    if(it == m_datasets.end())
+    {
+      continue;
+    }
+    // GetDomain is non-const, copies of vtk-h data sets are shallow
+    vtkh::DataSet vtkh_dataset = it->second;
+    const vtkm::Id num_domains = vtkh_dataset.GetNumberOfDomains();
+    for(vtkm::Id i = 0; i < num_domains; ++i)
     {
-      topo_name = it->first;
-      break;
+      const vtkm::cont::DataSet &dom = vtkh_dataset.GetDomain(i);
+      for(vtkm::IdComponent f = 0; f < dom.GetNumberOfFields(); ++f)
+      {
+        const vtkm::cont::Field &field = dom.GetField(f);
+        auto f_info = m_field_info.find(field.GetName());
+        if(f_info == m_field_info.end() || f_info->second.m_topology != topo_name)
+        {
+          continue;
+        }
+        vtkm::cont::ArrayHandle<vtkm::Range> ranges = detail::field_ranges(field);
+        auto portal = ranges.ReadPortal();
+        const vtkm::Id num_comps = ranges.GetNumberOfValues();
+
+        conduit::Node &n_range = fields.add_child(field.GetName());
+        if(!n_range.dtype().is_float64())
+        {
+          n_range.set(conduit::DataType::float64(num_comps * 2));
+          double *vals = n_range.value();
+          for(vtkm::Id c = 0; c < num_comps; ++c)
+          {
+            vals[c * 2 + 0] = std::numeric_limits<double>::max();
+            vals[c * 2 + 1] = std::numeric_limits<double>::lowest();
+          }
+        }
+        double *vals = n_range.value();
+        const vtkm::Id stored = n_range.dtype().number_of_elements() / 2;
+        for(vtkm::Id c = 0; c < num_comps && c < stored; ++c)
+        {
+          vtkm::Range range = portal.Get(c);
+          if(range.IsNonEmpty())
+          {
+            vals[c * 2 + 0] = std::min(vals[c * 2 + 0], range.Min);
+            vals[c * 2 + 1] = std::max(vals[c * 2 + 1], range.Max);
+          }
+        }
+      }
     }
   }
-#if defined(ASCENT_MPI_ENABLED)
-  // if the topology does not exist on this rank,
-  // but exists somewhere, we need to figure out what
-  // that name is for all ranks so all ranks
-  // can run the same code at the same time, avoiding deadlock
-  int rank;
-  MPI_Comm mpi_comm = MPI_Comm_f2c(vtkh::GetMPICommHandle());
-  MPI_Comm_rank(mpi_comm, &rank);
 
-  struct MaxLoc
+  conduit::Node all;
+  detail::all_gather(local, all);
+
+  for(auto it = m_field_info.begin(); it != m_field_info.end(); ++it)
   {
-    double size;
-    int rank;
-  };
+    if(m_unranged_topologies.count(it->second.m_topology) != 0)
+    {
+      it->second.m_ranges.clear();
+    }
+  }
 
-  // there is no MPI_INT_INT so shove the "small" size into double
-  MaxLoc maxloc = {(double)topo_name.length(), rank};
-  MaxLoc maxloc_res;
-  MPI_Allreduce( &maxloc, &maxloc_res, 1, MPI_DOUBLE_INT, MPI_MAXLOC, mpi_comm);
+  const int num_ranks = all.number_of_children();
+  for(int r = 0; r < num_ranks; ++r)
+  {
+    conduit::NodeConstIterator itr = all.child(r)["fields"].children();
+    while(itr.has_next())
+    {
+      const conduit::Node &n_range = itr.next();
+      const std::string field_name = itr.name();
+      const double *vals = n_range.as_float64_ptr();
+      const int num_comps = n_range.dtype().number_of_elements() / 2;
 
-  conduit::Node msg;
-  msg["topo"] = topo_name;
-  conduit::relay::mpi::broadcast_using_schema(msg,maxloc_res.rank,mpi_comm);
+      std::vector<vtkm::Range> &ranges = m_field_info[field_name].m_ranges;
+      if((int) ranges.size() < num_comps)
+      {
+        ranges.resize(num_comps);
+      }
+      for(int c = 0; c < num_comps; ++c)
+      {
+        if(vals[c * 2 + 0] <= vals[c * 2 + 1])
+        {
+          ranges[c].Include(vtkm::Range(vals[c * 2 + 0], vals[c * 2 + 1]));
+        }
+      }
+    }
+  }
 
-  if(!msg["topo"].dtype().is_string())
+  m_unranged_topologies.clear();
+}
+
+bool VTKHCollection::has_topology(const std::string name) const
+{
+  return m_topo_bounds.count(name) != 0;
+}
+
+std::string VTKHCollection::field_topology(const std::string field_name)
+{
+  auto it = m_field_info.find(field_name);
+  if(it == m_field_info.end())
   {
-    ASCENT_ERROR("failed to broadcast topo name");
+    return "";
   }
-  topo_name = msg["topo"].as_string();
-#endif
-  return topo_name;
+  return it->second.m_topology;
 }
 
-bool VTKHCollection::has_field(const std::string field_name) const
+vtkh::DataSet
+VTKHCollection::floating_point_dataset(const std::string topology_name,
+                                       const std::vector<std::string> &field_names) const
 {
-  bool has = false;
-  for(auto it = m_datasets.begin(); it != m_datasets.end(); ++it)
+  auto it = m_datasets.find(topology_name);
+  if(it == m_datasets.end())
   {
-    // Should we really have to ask an MPI questions? its safer
-    if(it->second.FieldExists(field_name))
+    return vtkh::DataSet();
+  }
+  return floating_point_copy(it->second, field_names);
+}
+
+vtkh::DataSet
+VTKHCollection::floating_point_copy(const vtkh::DataSet &dataset,
+                                    const std::vector<std::string> &field_names)
+{
+  vtkh::DataSet res = dataset;
+  const vtkm::Id num_domains = res.GetNumberOfDomains();
+  for(vtkm::Id i = 0; i < num_domains; ++i)
+  {
+    vtkm::cont::DataSet &dom = res.GetDomain(i);
+    for(const std::string &field_name : field_names)
     {
-      has = true;
-      break;
+      if(!dom.HasField(field_name))
+      {
+        continue;
+      }
+      const vtkm::cont::Field field = dom.GetField(field_name);
+      if(!detail::is_native_integer(field.GetData()))
+      {
+        continue;
+      }
+      vtkm::cont::ArrayHandle<vtkm::Float64> converted;
+      field.GetData().ResetTypes(detail::NativeIntegerTypes{}).
+        CastAndCall(detail::CastToFloat64Functor{}, converted);
+      // replaces the field in the copy with the same name and association
+      dom.AddField(vtkm::cont::Field(field_name,
+                                     field.GetAssociation(),
+                                     converted));
     }
   }
+  return res;
+}
 
+std::string
+VTKHCollection::field_association(const std::string field_name) const
+{
+  auto it = m_field_info.find(field_name);
+  if(it == m_field_info.end())
+  {
+    return "";
+  }
+  return it->second.m_association;
+}
 
-  return detail::global_has(has);
+std::vector<vtkm::Range>
+VTKHCollection::field_range(const std::string field_name) const
+{
+  sync_ranges();
+  auto it = m_field_info.find(field_name);
+  if(it == m_field_info.end())
+  {
+    return std::vector<vtkm::Range>();
+  }
+  return it->second.m_ranges;
+}
+
+bool VTKHCollection::has_field(const std::string field_name) const
+{
+  return m_field_info.count(field_name) != 0;
 }
 
 vtkm::Bounds VTKHCollection::global_bounds() const
 {
   // ranks may have different numbers of local vtk-h datasets
-  // depending on the toplogies at play
-  // can't use vtk-h to get global bounds b/c could create
-  // unmatched collectives.
-
-  // to get the global bounds, we include all local bounds
-  // then do a mpi reduce here
+  // depending on the toplogies at play, the catalog already
+  // holds the global bounds of each topology
   vtkm::Bounds bounds;
-  for(auto it = m_datasets.begin(); it != m_datasets.end(); ++it)
+  for(auto it = m_topo_bounds.begin(); it != m_topo_bounds.end(); ++it)
   {
-    bounds.Include(it->second.GetBounds());
+    bounds.Include(it->second);
   }
-
-#if defined(ASCENT_MPI_ENABLED)
-    MPI_Comm mpi_comm = MPI_Comm_f2c(vtkh::GetMPICommHandle());
-
-    vtkm::Float64 loc_mins[3];
-    //x,y,z
-    loc_mins[0] = bounds.X.Min;
-    loc_mins[1] = bounds.Y.Min;
-    loc_mins[2] = bounds.Z.Min;
-
-    vtkm::Float64 loc_maxs[3];
-    //x,y,z
-    loc_maxs[0] = bounds.X.Max;
-    loc_maxs[1] = bounds.Y.Max;
-    loc_maxs[2] = bounds.Z.Max;
-
-    vtkm::Float64 global_mins[3];
-    //x,y,z
-    global_mins[0] = 0.0;
-    global_mins[1] = 0.0;
-    global_mins[2] = 0.0;
-
-    vtkm::Float64 global_maxs[3];
-    //x,y,z
-    global_maxs[0] = 0.0;
-    global_maxs[1] = 0.0;
-    global_maxs[2] = 0.0;
-
-    MPI_Allreduce((void *)(&loc_mins),
-                  (void *)(&global_mins),
-                  3,
-                  MPI_DOUBLE,
-                  MPI_MIN,
-                  mpi_comm);
-
-    MPI_Allreduce((void *)(&loc_maxs),
-                  (void *)(&global_maxs),
-                  3,
-                  MPI_DOUBLE,
-                  MPI_MAX,
-                  mpi_comm);
-
-    bounds.X.Min = global_mins[0];
-    bounds.X.Max = global_maxs[0];
-
-    bounds.Y.Min = global_mins[1];
-    bounds.Y.Max = global_maxs[1];
-
-    bounds.Z.Min = global_mins[2];
-    bounds.Z.Max = global_maxs[2];
-  #endif
-
   return bounds;
 }
 
@@ -285,38 +518,21 @@ VTKHCollection::dataset_by_topology(const std::string topology_name)
 
 std::vector<std::string> VTKHCollection::topology_names() const
 {
-  std::set<std::string> names;
-  for(auto it = m_datasets.begin(); it != m_datasets.end(); ++it)
+  std::vector<std::string> res;
+  for(auto it = m_topo_bounds.begin(); it != m_topo_bounds.end(); ++it)
   {
-    names.insert(it->first);
+    res.push_back(it->first);
   }
-  gather_strings(names);
-  std::vector<std::string> res(names.size());
-  std::copy(names.begin(), names.end(), res.begin());
   return res;
 }
 
 std::vector<std::string> VTKHCollection::field_names() const
 {
-  // just grab the first domain of every topo and repo
-  // the known fields
-  std::set<std::string> names;
-  for(auto it = m_datasets.begin(); it != m_datasets.end(); ++it)
+  std::vector<std::string> res;
+  for(auto it = m_field_info.begin(); it != m_field_info.end(); ++it)
   {
-    vtkh::DataSet domains = it->second;
-    if(domains.GetNumberOfDomains() > 0)
-    {
-      vtkm::cont::DataSet dom = domains.GetDomain(0);
-      for(int i = 0; i < dom.GetNumberOfFields(); ++i)
-      {
-        names.insert(dom.GetField(i).GetName());
-      }
-    }
+    res.push_back(it->first);
   }
-
-  gather_strings(names);
-  std::vector<std::string> res(names.size());
-  std::copy(names.begin(), names.end(), res.begin());
   return res;
 }
 
@@ -343,10 +559,7 @@ VTKHCollection::by_domain_id()
 
 int VTKHCollection::number_of_topologies() const
 {
-  // this is not perfect. For example, we could
-  // random topology names on different ranks,
-  // but this is 99% of our possible use cases
-  return detail::global_max(m_datasets.size());
+  return (int) m_topo_bounds.size();
 }
 
 VTKHCollection* VTKHCollection::copy_without_topology(const std::string topology_name)
@@ -360,6 +573,21 @@ VTKHCollection* VTKHCollection::copy_without_topology(const std::string topology
   VTKHCollection *copy = new VTKHCollection(*this);
   copy->m_datasets.erase(topology_name);
 
+  // update the copied catalog instead of rebuilding it
+  copy->m_topo_bounds.erase(topology_name);
+  copy->m_unranged_topologies.erase(topology_name);
+  for(auto it = copy->m_field_info.begin(); it != copy->m_field_info.end();)
+  {
+    if(it->second.m_topology == topology_name)
+    {
+      it = copy->m_field_info.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
   return copy;
 }
 
@@ -379,10 +607,66 @@ std::string VTKHCollection::summary() const
   return msg.str();
 }
 
+conduit::index_t VTKHCollection::size_in_bytes() const
+{
+  using CoordsVec32 = vtkm::cont::ArrayHandle<vtkm::Vec<vtkm::Float32,3>>;
+  using Coords32 = vtkm::cont::ArrayHandleSOA<vtkm::Vec<vtkm::Float32, 3>>;
+
+  conduit::index_t bytes = 0;
+  for(auto it = m_datasets.begin(); it != m_datasets.end(); ++it)
+  {
+    // GetDomain is non-const, copies of vtk-h data sets are shallow
+    vtkh::DataSet vtkh_dataset = it->second;
+    const vtkm::Id num_domains = vtkh_dataset.GetNumberOfDomains();
+    for(vtkm::Id i = 0; i < num_domains; ++i)
+    {
+      vtkm::cont::DataSet dom = vtkh_dataset.GetDomain(i);
+      for(vtkm::IdComponent f = 0; f < dom.GetNumberOfFields(); ++f)
+      {
+        const vtkm::cont::VariantArrayHandle &data = dom.GetField(f).GetData();
+        bytes += data.GetNumberOfValues() *
+                 data.GetNumberOfComponents() *
+                 detail::component_bytes(data);
+      }
+
+      // uniform and rectilinear coordinates are (nearly) implicit
+      if(!vtkh::VTKMDataSetInfo::IsUniform(dom) &&
+         !vtkh::VTKMDataSetInfo::IsRectilinear(dom))
+      {
+        vtkm::cont::VariantArrayHandle coords(dom.GetCoordinateSystem().GetData());
+        conduit::index_t comp_bytes = 8;
+        if(coords.IsType<CoordsVec32>() || coords.IsType<Coords32>())
+        {
+          comp_bytes = 4;
+        }
+        bytes += coords.GetNumberOfValues() * 3 * comp_bytes;
+      }
+    }
+  }
+  return bytes;
+}
+
 VTKHCollection::VTKHCollection()
 {
 
 }
+
+VTKHCollection::VTKHCollection(const std::map<std::string, vtkh::DataSet> &datasets)
+  : m_datasets(datasets)
+{
+  // describe the local parts of all topologies
+  conduit::Node local;
+  conduit::Node &topos = local["topologies"];
+  topos.set(conduit::DataType::object());
+  for(auto it = m_datasets.begin(); it != m_datasets.end(); ++it)
+  {
+    detail::describe_topology(it->second, topos.add_child(it->first));
+  }
+
+  conduit::Node all;
+  detail::all_gather(local, all);
+  merge_catalog(all);
+}
 //-----------------------------------------------------------------------------
 };
 //-----------------------------------------------------------------------------
@@ -52,8 +52,11 @@
 //-----------------------------------------------------------------------------
 
 #include <ascent_exports.h>
+#include <conduit.hpp>
 #include <vtkh/DataSet.hpp>
 #include <map>
+#include <set>
+#include <vector>
 
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
@@ -71,12 +74,44 @@ namespace ascent
 // From a vtkm point of view, each topology and associated fields are
 // a distinct data set and can be treated as such within pipelines.
 //
+// Global queries (topologies, fields and bounds) are answered locally
+// from a catalog that all ranks agree on. The catalog is built with a
+// single exchange when a collection is created from the local data sets
+// of every rank, and add() merges the new topology into the catalog a
+// derived collection inherits with another single exchange. Field ranges
+// need a pass over the data, so they are exchanged the first time they
+// are asked for.
+//
 class ASCENT_API VTKHCollection
 {
 protected:
   std::map<std::string, vtkh::DataSet> m_datasets;
+
+  struct FieldInfo
+  {
+    std::string              m_topology;
+    std::string              m_association;
+    std::vector<vtkm::Range> m_ranges;
+  };
+
+  // global catalog
+  std::map<std::string, vtkm::Bounds>         m_topo_bounds;
+  mutable std::map<std::string, FieldInfo>    m_field_info;
+  // topologies whose field ranges have not been exchanged yet
+  mutable std::set<std::string>               m_unranged_topologies;
+
+  // merges the topologies described by every rank into the catalog
+  void merge_catalog(const conduit::Node &all);
+  void sync_ranges() const;
 public:
+  // an empty collection (no communication)
   VTKHCollection();
+  // a collection of this rank's data sets by topology name
+  // (collective, builds the catalog)
+  VTKHCollection(const std::map<std::string, vtkh::DataSet> &datasets);
+
+  // adds a topology, ranks without any domains of it pass
+  // an empty data set (collective)
   void add(vtkh::DataSet &dataset, const std::string topology_name);
 
   // returns true if the topology exists on any rank
@@ -92,28 +127,54 @@ public:
   // any rank
   std::string field_topology(const std::string field_name);
 
+  // returns a copy of the topology's local data set in which the
+  // given fields are converted to float64 if they were passed through
+  // with a native integer type. Filters whose worklets only support
+  // floating point fields run on this copy, the collection itself is
+  // not changed. (domains are shallow copies, only converted fields
+  // are new arrays)
+  vtkh::DataSet floating_point_dataset(const std::string topology_name,
+                                       const std::vector<std::string> &field_names) const;
+
+  // same as above for a data set that is not part of a collection
+  static vtkh::DataSet floating_point_copy(const vtkh::DataSet &dataset,
+                                           const std::vector<std::string> &field_names);
+
+  // returns the field association ('vertex', 'element' or 'other'),
+  // or an empty string if the field is not present on any rank
+  std::string field_association(const std::string field_name) const;
+
+  // returns the global range of each component of the field
+  // (empty if the field is not present on any rank). collective
+  // the first time it is called after a topology was added
+  std::vector<vtkm::Range> field_range(const std::string field_name) const;
+
   // returns an empty dataset if topology does not exist on
   // this rank
   vtkh::DataSet &dataset_by_topology(const std::string topology_name);
 
   vtkm::Bounds global_bounds() const;
 
-  // returns the local topology names
+  // returns the topology names on all ranks
   std::vector<std::string> topology_names() const;
 
-  // returns the local field names
+  // returns the field names on all ranks
   std::vector<std::string> field_names() const;
 
   // returns the local domain ids
   std::vector<vtkm::Id> domain_ids() const;
 
-  // returns the local number of topologies
+  // returns the number of topologies on all ranks
   int number_of_topologies() const;
 
   // returns a new collection without the specified topology
   // this is a shallow copy operation
   VTKHCollection* copy_without_topology(const std::string topology_name);
 
+  // returns an estimate of the local memory held by field and
+  // explicit coordinate arrays (cell connectivity is not counted)
+  conduit::index_t size_in_bytes() const;
+
   // re-organize by 'domian_id / topology / data set'
   std::map<int, std::map<std::string,vtkm::cont::DataSet>> by_domain_id();
 
@@ -57,6 +57,8 @@
 #include <cstdlib>
 #include <sstream>
 #include <type_traits>
+#include <algorithm>
+#include <set>
 
 // third party includes
 
@@ -95,6 +97,15 @@ namespace ascent
 namespace detail
 {
 
+//
+// integer field types the user asked us to pass to vtk-m as is
+//
+std::set<std::string> &native_field_types()
+{
+  static std::set<std::string> types;
+  return types;
+}
+
 vtkm::Id3 topo_origin(const conduit::Node &n_topo)
 {
   vtkm::Id3 topo_origin(0,0,0);
@@ -383,7 +394,37 @@ vtkm::cont::Field GetVectorField(T *values_ptr,
 }
 
 //
-// extract a vector from 3 separate arrays
+// interleave N separate component arrays into an array of vecs.
+// The transposition is done in blocks so each thread streams through
+// contiguous chunks of the inputs and the output.
+//
+template<typename T, int N>
+void InterleaveComponents(const T *comps[N],
+                          const int num_vals,
+                          vtkm::Vec<T,N> *out)
+{
+  const int block_size = 1024;
+  const int num_blocks = (num_vals + block_size - 1) / block_size;
+#ifdef ASCENT_USE_OPENMP
+  #pragma omp parallel for schedule(static)
+#endif
+  for(int b = 0; b < num_blocks; ++b)
+  {
+    const int begin = b * block_size;
+    const int end = std::min(begin + block_size, num_vals);
+    for(int c = 0; c < N; ++c)
+    {
+      const T *comp = comps[c];
+      for(int i = begin; i < end; ++i)
+      {
+        out[i][c] = comp[i];
+      }
+    }
+  }
+}
+
+//
+// extract a vector from 2 or 3 separate arrays
 //
 template<typename T>
 void ExtractVector(vtkm::cont::DataSet *dset,
@@ -397,8 +438,6 @@ void ExtractVector(vtkm::cont::DataSet *dset,
                    const std::string topo_name,
                    bool zero_copy)
 {
-  // TODO: Do we need to fix this for striding?
-  // GetField<T> expects compact
   if(dims != 2 && dims != 3)
   {
     ASCENT_ERROR("Extract vector: only 2 and 3 dims supported given "<<dims);
@@ -419,29 +458,34 @@ void ExtractVector(vtkm::cont::DataSet *dset,
                  <<assoc_str<<" field_name "<<field_name);
   }
 
-  if(dims == 2)
+  // GetNodePointer expects compact components, so compact any
+  // strided ones first.
+  conduit::Node compact;
+  const conduit::Node *comps[3] = {&u, &v, &w};
+  for(int c = 0; c < dims; ++c)
   {
-    const T *x_ptr = GetNodePointer<T>(u);
-    const T *y_ptr = GetNodePointer<T>(v);
-
-    vtkm::cont::ArrayHandle<T> x_handle;
-    vtkm::cont::ArrayHandle<T> y_handle;
-
-    // always zero copy because we are about to make a copy
-    detail::CopyArray(x_handle, x_ptr, num_vals, true);
-    detail::CopyArray(y_handle, y_ptr, num_vals, true);
-
+    if(!comps[c]->is_compact())
+    {
+      comps[c]->compact_to(compact.append());
+      comps[c] = &compact.child(compact.number_of_children() - 1);
+    }
+  }
 
-    auto composite  = make_ArrayHandleSOA(x_handle,
-                                          y_handle);
+  // The vtk-h filters only accept basic storage for fields, so the
+  // components are interleaved into a new array on the host. The
+  // collection holding the result is cached by the data object, so
+  // this happens once per published data set no matter how many
+  // filters consume the field.
+  if(dims == 2)
+  {
+    const T *ptrs[2] = {GetNodePointer<T>(*comps[0]),
+                        GetNodePointer<T>(*comps[1])};
 
     vtkm::cont::ArrayHandle<vtkm::Vec<T,2>> interleaved_handle;
     interleaved_handle.Allocate(num_vals);
-    // Calling this without forcing serial could cause serious problems
-    {
-      vtkm::cont::ScopedRuntimeDeviceTracker tracker(vtkm::cont::DeviceAdapterTagSerial{});
-      vtkm::cont::ArrayCopy(composite, interleaved_handle);
-    }
+    InterleaveComponents<T,2>(ptrs,
+                              num_vals,
+                              vtkh::GetVTKMPointer(interleaved_handle));
 
     vtkm::cont::Field field(field_name, vtkm_assoc, interleaved_handle);
     dset->AddField(field);
@@ -449,30 +493,15 @@ void ExtractVector(vtkm::cont::DataSet *dset,
 
   if(dims == 3)
   {
-    const T *x_ptr = GetNodePointer<T>(u);
-    const T *y_ptr = GetNodePointer<T>(v);
-    const T *z_ptr = GetNodePointer<T>(w);
-
-    vtkm::cont::ArrayHandle<T> x_handle;
-    vtkm::cont::ArrayHandle<T> y_handle;
-    vtkm::cont::ArrayHandle<T> z_handle;
-
-    // always zero copy because we are about to make a copy
-    detail::CopyArray(x_handle, x_ptr, num_vals, true);
-    detail::CopyArray(y_handle, y_ptr, num_vals, true);
-    detail::CopyArray(z_handle, z_ptr, num_vals, true);
-
-    auto composite  = make_ArrayHandleSOA(x_handle,
-                                          y_handle,
-                                          z_handle);
+    const T *ptrs[3] = {GetNodePointer<T>(*comps[0]),
+                        GetNodePointer<T>(*comps[1]),
+                        GetNodePointer<T>(*comps[2])};
 
     vtkm::cont::ArrayHandle<vtkm::Vec<T,3>> interleaved_handle;
     interleaved_handle.Allocate(num_vals);
-    // Calling this without forcing serial could cause serious problems
-    {
-      vtkm::cont::ScopedRuntimeDeviceTracker tracker(vtkm::cont::DeviceAdapterTagSerial{});
-      vtkm::cont::ArrayCopy(composite, interleaved_handle);
-    }
+    InterleaveComponents<T,3>(ptrs,
+                              num_vals,
+                              vtkh::GetVTKMPointer(interleaved_handle));
 
     vtkm::cont::Field field(field_name, vtkm_assoc, interleaved_handle);
     dset->AddField(field);
@@ -531,6 +560,48 @@ void VTKmCellShape(const std::string shape_type,
 // VTKHDataAdapter public methods
 //-----------------------------------------------------------------------------
 
+//---------------------------------------------------------------------------//
+std::vector<std::string>
+VTKHDataAdapter::SupportedNativeFieldTypes()
+{
+  // only integer types in vtk-m's default type list, so
+  // filters can dispatch on the fields without converting them
+  std::vector<std::string> types = {"uint8", "int32", "int64"};
+  return types;
+}
+
+//---------------------------------------------------------------------------//
+void
+VTKHDataAdapter::SetNativeFieldTypes(const std::vector<std::string> &dtype_names)
+{
+  const std::vector<std::string> supported = SupportedNativeFieldTypes();
+  std::set<std::string> types;
+  for(const auto &name : dtype_names)
+  {
+    if(std::find(supported.begin(), supported.end(), name) == supported.end())
+    {
+      std::stringstream ss;
+      for(const auto &s : supported)
+      {
+        ss<<" '"<<s<<"'";
+      }
+      ASCENT_ERROR("Unsupported native field type '"<<name<<"'."
+                   <<" Supported types:"<<ss.str());
+    }
+    types.insert(name);
+  }
+  detail::native_field_types() = types;
+}
+
+//---------------------------------------------------------------------------//
+std::vector<std::string>
+VTKHDataAdapter::NativeFieldTypes()
+{
+  const std::set<std::string> &types = detail::native_field_types();
+  return std::vector<std::string>(types.begin(), types.end());
+}
+
+
 VTKHCollection*
 VTKHDataAdapter::BlueprintToVTKHCollection(const conduit::Node &n,
                                            bool zero_copy)
@@ -540,7 +611,6 @@ VTKHDataAdapter::BlueprintToVTKHCollection(const conduit::Node &n,
 
     const int num_domains = n.number_of_children();
 
-    VTKHCollection *res = new VTKHCollection();
     std::map<std::string, vtkh::DataSet> datasets;
     vtkm::UInt64 cycle = 0;
     double time = 0;
@@ -577,12 +647,9 @@ VTKHDataAdapter::BlueprintToVTKHCollection(const conduit::Node &n,
 
     }
 
-    for(auto dset_it : datasets)
-    {
-      res->add(dset_it.second, dset_it.first);
-    }
-
-    return res;
+    // ranks can have different topologies, the collection
+    // agrees on all of them in one exchange
+    return new VTKHCollection(datasets);
 }
 
 //-----------------------------------------------------------------------------
@@ -1358,18 +1425,59 @@ VTKHDataAdapter::AddField(const std::string &field_name,
     {
         bool supported_type = false;
 
-        if(n_vals.is_compact())
+        const bool is_float = n_vals.dtype().is_float32() ||
+                              n_vals.dtype().is_float64();
+        const bool is_native = is_float ||
+            detail::native_field_types().count(n_vals.dtype().name()) > 0;
+
+        // strided values are compacted into their own type rather than
+        // widened, so they cannot be zero copied
+        Node n_compact;
+        const Node *n_src = &n_vals;
+        if(is_native && !n_vals.is_compact())
         {
-            // we compile vtk-h with fp types
-            if(n_vals.dtype().is_float32())
+            n_vals.compact_to(n_compact);
+            n_src = &n_compact;
+            zero_copy = false;
+        }
+
+        if(is_native)
+        {
+            // we compile vtk-h with fp types, other native types are
+            // converted by the filters that need floating point
+            supported_type = true;
+            const DataType &dtype = n_src->dtype();
+            if(dtype.is_float32())
             {
-                dset->AddField(detail::GetField<float32>(n_vals, field_name, assoc_str, topo_name, zero_copy));
-                supported_type = true;
+                dset->AddField(detail::GetField<float32>(*n_src, field_name, assoc_str, topo_name, zero_copy));
             }
-            else if(n_vals.dtype().is_float64())
+            else if(dtype.is_float64())
             {
-                dset->AddField(detail::GetField<float64>(n_vals, field_name, assoc_str, topo_name, zero_copy));
-                supported_type = true;
+                dset->AddField(detail::GetField<float64>(*n_src, field_name, assoc_str, topo_name, zero_copy));
+            }
+            else if(dtype.is_uint8())
+            {
+                dset->AddField(detail::GetField<uint8>(*n_src, field_name, assoc_str, topo_name, zero_copy));
+            }
+            else if(dtype.is_int32())
+            {
+                dset->AddField(detail::GetField<int32>(*n_src, field_name, assoc_str, topo_name, zero_copy));
+            }
+            else if(dtype.is_int64())
+            {
+                // conduit int64 and vtkm::Int64 can be different types
+                const vtkm::Int64 *values_ptr =
+                  reinterpret_cast<const vtkm::Int64*>(n_src->as_int64_ptr());
+                dset->AddField(vtkm::cont::make_Field(field_name,
+                                                      vtkm_assoc,
+                                                      values_ptr,
+                                                      num_vals,
+                                                      zero_copy ? vtkm::CopyFlag::Off
+                                                                : vtkm::CopyFlag::On));
+            }
+            else
+            {
+                supported_type = false;
             }
         }
 
@@ -1520,9 +1628,9 @@ VTKHDataAdapter::AddVectorField(const std::string &field_name,
         else
         {
           // we have a vector with 2/3 separate arrays
-          // While vtkm supports ArrayHandleCompositeVectors for
-          // coordinate systems, it does not support composites
-          // for fields. Thus we have to copy the data.
+          // While vtkm supports ArrayHandleSOA for coordinate
+          // systems, the vtk-h field storage list only contains
+          // basic storage. Thus we have to interleave the data.
           if(dims == 3)
           {
             const conduit::Node &v = n_field["values"].child(1);
@@ -2154,8 +2262,19 @@ VTKHDataAdapter::VTKmFieldToBlueprint(conduit::Node &output,
   {
     using HandleType = vtkm::cont::ArrayHandle<vtkm::Int64>;
     HandleType handle = dyn_handle.Cast<HandleType>();
-    ASCENT_ERROR("Conduit int64 and vtkm::Int64 are different. Cannot convert vtkm::Int64\n");
-    //output[path + "/values"].set(vtkh::GetVTKMPointer(handle), handle.GetNumberOfValues());
+    // conduit int64 and vtkm::Int64 can be different (but same sized)
+    // types, so go through the raw pointer
+    static_assert(sizeof(vtkm::Int64) == sizeof(conduit::int64),
+                  "vtkm::Int64 and conduit::int64 must be the same size");
+    conduit::int64 *ptr = reinterpret_cast<conduit::int64*>(vtkh::GetVTKMPointer(handle));
+    if(zero_copy)
+    {
+      output[path + "/values"].set_external(ptr, handle.GetNumberOfValues());
+    }
+    else
+    {
+      output[path + "/values"].set(ptr, handle.GetNumberOfValues());
+    }
   }
   else if(dyn_handle.IsType<vtkm::cont::ArrayHandle<vtkm::UInt32>>())
   {
@@ -76,6 +76,9 @@ class DataSet;
 // conduit includes
 #include <conduit.hpp>
 
+#include <string>
+#include <vector>
+
 
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
@@ -135,6 +138,15 @@ public:
     static void              VTKHCollectionToBlueprintDataSet(VTKHCollection *collection,
                                                               conduit::Node &node,
                                                               bool zero_copy = false);
+
+    // integer field types (conduit dtype names, e.g. "int32", "uint8")
+    // that are passed to vtk-m with their native type instead of being
+    // converted to floating point. Filters that need floating point
+    // convert their own copy (see VTKHCollection::floating_point_dataset)
+    static void                     SetNativeFieldTypes(const std::vector<std::string> &dtype_names);
+    static std::vector<std::string> NativeFieldTypes();
+    // all of the integer types that can be passed natively
+    static std::vector<std::string> SupportedNativeFieldTypes();
 private:
     // helpers for specific conversion cases
     static vtkm::cont::DataSet  *UniformBlueprintToVTKmDataSet(const std::string &coords_name,
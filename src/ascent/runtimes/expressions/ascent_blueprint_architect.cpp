@@ -50,6 +50,9 @@
 
 #include "ascent_blueprint_architect.hpp"
 #include "ascent_conduit_reductions.hpp"
+#include "ascent_point_locator.hpp"
+#include "ascent_quantile_sketch.hpp"
+#include "ascent_topology_metadata.hpp"
 
 #include <ascent_logging.hpp>
 
@@ -63,6 +66,10 @@
 
 #include <flow_workspace.hpp>
 
+#ifdef ASCENT_USE_OPENMP
+#include <omp.h>
+#endif
+
 #ifdef ASCENT_MPI_ENABLED
 #include <conduit_relay_mpi.hpp>
 #include <mpi.h>
@@ -112,57 +119,6 @@ at_least_one(bool local)
   return agreement;
 }
 
-struct UniformCoords
-{
-  conduit::float64 m_origin[3] = {0., 0., 0.};
-  conduit::float64 m_spacing[3] = {1., 1., 1.};
-  int m_dims[3] = {0, 0, 0};
-  bool m_is_2d = true;
-
-  UniformCoords(const conduit::Node &n_coords)
-  {
-    populate(n_coords);
-  }
-
-  void
-  populate(const conduit::Node &n_coords)
-  {
-
-    const conduit::Node &n_dims = n_coords["dims"];
-
-    m_dims[0] = n_dims["i"].to_int();
-    m_dims[1] = n_dims["j"].to_int();
-    m_dims[2] = 1;
-
-    // check for 3d
-    if(n_dims.has_path("k"))
-    {
-      m_dims[2] = n_dims["k"].to_int();
-      m_is_2d = false;
-    }
-
-    const conduit::Node &n_origin = n_coords["origin"];
-
-    m_origin[0] = n_origin["x"].to_float64();
-    m_origin[1] = n_origin["y"].to_float64();
-
-    if(n_origin.has_child("z"))
-    {
-      m_origin[2] = n_origin["z"].to_float64();
-    }
-
-    const conduit::Node &n_spacing = n_coords["spacing"];
-
-    m_spacing[0] = n_spacing["dx"].to_float64();
-    m_spacing[1] = n_spacing["dy"].to_float64();
-
-    if(n_spacing.has_path("dz"))
-    {
-      m_spacing[2] = n_spacing["dz"].to_float64();
-    }
-  }
-};
-
 int
 get_num_indices(const std::string &shape_type)
 {
@@ -194,343 +150,17 @@ get_num_indices(const std::string &shape_type)
   return num;
 }
 
-void
-logical_index_2d(int *idx, const int vert_index, const int *dims)
-{
-  idx[0] = vert_index % dims[0];
-  idx[1] = vert_index / dims[0];
-}
-
-void
-logical_index_3d(int *idx, const int vert_index, const int *dims)
-{
-  idx[0] = vert_index % dims[0];
-  idx[1] = (vert_index / dims[0]) % dims[1];
-  idx[2] = vert_index / (dims[0] * dims[1]);
-}
-
-void
-get_element_indices(const conduit::Node &n_topo,
-                    const int index,
-                    std::vector<int> &indices)
-{
-
-  const std::string mesh_type = n_topo["type"].as_string();
-  if(mesh_type == "unstructured")
-  {
-    // supports only single element type
-    const conduit::Node &n_topo_eles = n_topo["elements"];
-
-    // get the shape
-    const std::string ele_shape = n_topo_eles["shape"].as_string();
-    const int num_indices = get_num_indices(ele_shape);
-
-    indices.resize(num_indices);
-    // look up the connectivity
-    const conduit::Node &n_topo_conn = n_topo_eles["connectivity"];
-    const conduit::int32_array conn_a = n_topo_conn.value();
-    const int offset = index * num_indices;
-    for(int i = 0; i < num_indices; ++i)
-    {
-      indices[i] = conn_a[offset + i];
-    }
-  }
-  else
-  {
-    bool is_2d = true;
-    int vert_dims[3] = {0, 0, 0};
-    vert_dims[0] = n_topo["elements/dims/i"].to_int32() + 1;
-    vert_dims[1] = n_topo["elements/dims/j"].to_int32() + 1;
-
-    if(n_topo.has_path("elements/dims/k"))
-    {
-      vert_dims[2] = n_topo["elements/dims/k"].to_int32() + 1;
-      is_2d = false;
-    }
-
-    const int element_dims[3] = {
-        vert_dims[0] - 1, vert_dims[1] - 1, vert_dims[2] - 1};
-
-    int element_index[3] = {0, 0, 0};
-    if(is_2d)
-    {
-      indices.resize(4);
-      logical_index_2d(element_index, index, element_dims);
-
-      indices[0] = element_index[1] * vert_dims[0] + element_index[0];
-      indices[1] = indices[0] + 1;
-      indices[2] = indices[1] + vert_dims[0];
-      indices[3] = indices[2] - 1;
-    }
-    else
-    {
-      indices.resize(8);
-      logical_index_3d(element_index, index, element_dims);
-
-      indices[0] =
-          (element_index[2] * vert_dims[1] + element_index[1]) * vert_dims[0] +
-          element_index[0];
-      indices[1] = indices[0] + 1;
-      indices[2] = indices[1] + vert_dims[1];
-      indices[3] = indices[2] - 1;
-      indices[4] = indices[0] + vert_dims[0] * vert_dims[2];
-      indices[5] = indices[4] + 1;
-      indices[6] = indices[5] + vert_dims[1];
-      indices[7] = indices[6] - 1;
-    }
-  }
-}
-
-conduit::Node
-get_uniform_vert(const conduit::Node &n_coords, const int &index)
-{
-
-  UniformCoords coords(n_coords);
-
-  int logical_index[3] = {0, 0, 0};
-
-  if(coords.m_is_2d)
-  {
-    logical_index_2d(logical_index, index, coords.m_dims);
-  }
-  else
-  {
-    logical_index_3d(logical_index, index, coords.m_dims);
-  }
-
-  double vert[3];
-  vert[0] = coords.m_origin[0] + logical_index[0] * coords.m_spacing[0];
-  vert[1] = coords.m_origin[1] + logical_index[1] * coords.m_spacing[1];
-  vert[2] = coords.m_origin[2] + logical_index[2] * coords.m_spacing[2];
-
-  conduit::Node res;
-  res.set(vert, 3);
-  return res;
-}
-
-conduit::Node
-get_explicit_vert(const conduit::Node &n_coords, const int &index)
-{
-  bool is_float64 = true;
-  if(n_coords["values/x"].dtype().is_float32())
-  {
-    is_float64 = false;
-  }
-  double vert[3] = {0., 0., 0.};
-  if(is_float64)
-  {
-    conduit::float64_array x_a = n_coords["values/x"].value();
-    conduit::float64_array y_a = n_coords["values/y"].value();
-    vert[0] = x_a[index];
-    vert[1] = y_a[index];
-    if(n_coords.has_path("values/z"))
-    {
-      conduit::float64_array z_a = n_coords["values/z"].value();
-      vert[2] = z_a[index];
-    }
-  }
-  else
-  {
-    conduit::float32_array x_a = n_coords["values/x"].value();
-    conduit::float32_array y_a = n_coords["values/y"].value();
-    vert[0] = x_a[index];
-    vert[1] = y_a[index];
-    if(n_coords.has_path("values/z"))
-    {
-      conduit::float32_array z_a = n_coords["values/z"].value();
-      vert[2] = z_a[index];
-    }
-  }
-
-  conduit::Node res;
-  res.set(vert, 3);
-  return res;
-}
-
-conduit::Node
-get_rectilinear_vert(const conduit::Node &n_coords, const int &index)
-{
-  bool is_float64 = true;
-
-  int dims[3] = {0, 0, 0};
-  dims[0] = n_coords["values/x"].dtype().number_of_elements();
-  dims[1] = n_coords["values/y"].dtype().number_of_elements();
-
-  if(n_coords.has_path("values/z"))
-  {
-    dims[2] = n_coords["values/z"].dtype().number_of_elements();
-  }
-
-  if(n_coords["values/x"].dtype().is_float32())
-  {
-    is_float64 = false;
-  }
-  double vert[3] = {0., 0., 0.};
-
-  int logical_index[3] = {0, 0, 0};
-
-  if(dims[2] == 0)
-  {
-    logical_index_2d(logical_index, index, dims);
-  }
-  else
-  {
-    logical_index_3d(logical_index, index, dims);
-  }
-
-  if(is_float64)
-  {
-    conduit::float64_array x_a = n_coords["values/x"].value();
-    conduit::float64_array y_a = n_coords["values/y"].value();
-    vert[0] = x_a[logical_index[0]];
-    vert[1] = y_a[logical_index[1]];
-    if(dims[2] != 0)
-    {
-      conduit::float64_array z_a = n_coords["values/z"].value();
-      vert[2] = z_a[logical_index[2]];
-    }
-  }
-  else
-  {
-    conduit::float32_array x_a = n_coords["values/x"].value();
-    conduit::float32_array y_a = n_coords["values/y"].value();
-    vert[0] = x_a[logical_index[0]];
-    vert[1] = y_a[logical_index[1]];
-    if(dims[2] != 0)
-    {
-      conduit::float32_array z_a = n_coords["values/z"].value();
-      vert[2] = z_a[logical_index[2]];
-    }
-  }
-
-  conduit::Node res;
-  res.set(vert, 3);
-  return res;
-}
-// ----------------------  element locations ---------------------------------
-conduit::Node
-get_uniform_element(const conduit::Node &n_coords, const int &index)
-{
-
-  UniformCoords coords(n_coords);
-
-  int logical_index[3] = {0, 0, 0};
-  const int element_dims[3] = {
-      coords.m_dims[0] - 1, coords.m_dims[1] - 1, coords.m_dims[2] - 1};
-
-  if(coords.m_is_2d)
-  {
-    logical_index_2d(logical_index, index, element_dims);
-  }
-  else
-  {
-    logical_index_3d(logical_index, index, element_dims);
-  }
-
-  // element logical index will be the lower left point index
-
-  double vert[3] = {0., 0., 0.};
-  vert[0] = coords.m_origin[0] + logical_index[0] * coords.m_spacing[0] +
-            coords.m_spacing[0] * 0.5;
-  vert[1] = coords.m_origin[1] + logical_index[1] * coords.m_spacing[1] +
-            coords.m_spacing[1] * 0.5;
-  vert[2] = coords.m_origin[2] + logical_index[2] * coords.m_spacing[2] +
-            coords.m_spacing[2] * 0.5;
-
-  conduit::Node res;
-  res.set(vert, 3);
-  return res;
-}
-
-conduit::Node
-get_rectilinear_element(const conduit::Node &n_coords, const int &index)
-{
-  bool is_float64 = true;
-
-  int dims[3] = {0, 0, 0};
-  dims[0] = n_coords["values/x"].dtype().number_of_elements();
-  dims[1] = n_coords["values/y"].dtype().number_of_elements();
-
-  if(n_coords.has_path("values/z"))
-  {
-    dims[2] = n_coords["values/z"].dtype().number_of_elements();
-  }
-
-  if(n_coords["values/x"].dtype().is_float32())
-  {
-    is_float64 = false;
-  }
-  const int element_dims[3] = {dims[0] - 1, dims[1] - 1, dims[2] - 1};
-
-  double vert[3] = {0., 0., 0.};
-
-  int logical_index[3] = {0, 0, 0};
-
-  if(dims[2] == 0)
-  {
-    logical_index_2d(logical_index, index, element_dims);
-  }
-  else
-  {
-    logical_index_3d(logical_index, index, element_dims);
-  }
-
-  if(is_float64)
-  {
-    conduit::float64_array x_a = n_coords["values/x"].value();
-    conduit::float64_array y_a = n_coords["values/y"].value();
-    vert[0] = (x_a[logical_index[0]] + x_a[logical_index[0] + 1]) * 0.5;
-    vert[1] = (y_a[logical_index[1]] + y_a[logical_index[1] + 1]) * 0.5;
-    if(dims[2] != 0)
-    {
-      conduit::float64_array z_a = n_coords["values/z"].value();
-      vert[2] = (z_a[logical_index[2]] + z_a[logical_index[2] + 1]) * 0.5;
-    }
-  }
-  else
-  {
-    conduit::float32_array x_a = n_coords["values/x"].value();
-    conduit::float32_array y_a = n_coords["values/y"].value();
-    vert[0] = (x_a[logical_index[0]] + x_a[logical_index[0] + 1]) * 0.5;
-    vert[1] = (y_a[logical_index[1]] + y_a[logical_index[1] + 1]) * 0.5;
-    if(dims[2] != 0)
-    {
-      conduit::float32_array z_a = n_coords["values/z"].value();
-      vert[2] = (z_a[logical_index[2]] + z_a[logical_index[2] + 1]) * 0.5;
-    }
-  }
-
-  conduit::Node res;
-  res.set(vert, 3);
-  return res;
-}
-
-conduit::Node
-get_explicit_element(const conduit::Node &n_coords,
-                     const conduit::Node &n_topo,
-                     const int &index)
+std::string
+default_topology(const conduit::Node &domain, const std::string &topo_name)
 {
-  std::vector<int> conn;
-  get_element_indices(n_topo, index, conn);
-  const int num_indices = conn.size();
-  double vert[3] = {0., 0., 0.};
-  for(int i = 0; i < num_indices; ++i)
+  // if we don't specify a topology, find the first topology ...
+  if(topo_name == "")
   {
-    int vert_index = conn[i];
-    conduit::Node n_vert = get_explicit_vert(n_coords, vert_index);
-    double *ptr = n_vert.value();
-    vert[0] += ptr[0];
-    vert[1] += ptr[1];
-    vert[2] += ptr[2];
+    conduit::NodeConstIterator itr = domain["topologies"].children();
+    itr.next();
+    return itr.name();
   }
-
-  vert[0] /= double(num_indices);
-  vert[1] /= double(num_indices);
-  vert[2] /= double(num_indices);
-
-  conduit::Node res;
-  res.set(vert, 3);
-  return res;
+  return topo_name;
 }
 
 //-----------------------------------------------------------------------------
@@ -544,39 +174,12 @@ vert_location(const conduit::Node &domain,
               const int &index,
               const std::string &topo_name)
 {
-  std::string topo = topo_name;
-  // if we don't specify a topology, find the first topology ...
-  if(topo_name == "")
-  {
-    conduit::NodeConstIterator itr = domain["topologies"].children();
-    itr.next();
-    topo = itr.name();
-  }
-
-  const conduit::Node &n_topo = domain["topologies"][topo];
-  const std::string mesh_type = n_topo["type"].as_string();
-  const std::string coords_name = n_topo["coordset"].as_string();
-
-  const conduit::Node &n_coords = domain["coordsets"][coords_name];
+  DomainLocator locator(domain, detail::default_topology(domain, topo_name));
+  double vert[3];
+  locator.vertex(index, vert);
 
   conduit::Node res;
-  if(mesh_type == "uniform")
-  {
-    res = detail::get_uniform_vert(n_coords, index);
-  }
-  else if(mesh_type == "rectilinear")
-  {
-    res = detail::get_rectilinear_vert(n_coords, index);
-  }
-  else if(mesh_type == "unstructured" || mesh_type == "structured")
-  {
-    res = detail::get_explicit_vert(n_coords, index);
-  }
-  else
-  {
-    ASCENT_ERROR("The Architect: unknown mesh type: '" << mesh_type << "'");
-  }
-
+  res.set(vert, 3);
   return res;
 }
 
@@ -585,39 +188,12 @@ element_location(const conduit::Node &domain,
                  const int &index,
                  const std::string &topo_name)
 {
-  std::string topo = topo_name;
-  // if we don't specify a topology, find the first topology ...
-  if(topo_name == "")
-  {
-    conduit::NodeConstIterator itr = domain["topologies"].children();
-    itr.next();
-    topo = itr.name();
-  }
-
-  const conduit::Node &n_topo = domain["topologies"][topo];
-  const std::string mesh_type = n_topo["type"].as_string();
-  const std::string coords_name = n_topo["coordset"].as_string();
-
-  const conduit::Node &n_coords = domain["coordsets"][coords_name];
+  DomainLocator locator(domain, detail::default_topology(domain, topo_name));
+  double vert[3];
+  locator.element(index, vert);
 
   conduit::Node res;
-  if(mesh_type == "uniform")
-  {
-    res = detail::get_uniform_element(n_coords, index);
-  }
-  else if(mesh_type == "rectilinear")
-  {
-    res = detail::get_rectilinear_element(n_coords, index);
-  }
-  else if(mesh_type == "unstructured" || mesh_type == "structured")
-  {
-    res = detail::get_explicit_element(n_coords, n_topo, index);
-  }
-  else
-  {
-    ASCENT_ERROR("The Architect: unknown mesh type: '" << mesh_type << "'");
-  }
-
+  res.set(vert, 3);
   return res;
 }
 
@@ -717,122 +293,6 @@ is_xyz(const std::string &axis_name)
   return axis_name == "x" || axis_name == "y" || axis_name == "z";
 }
 
-int
-num_points(const conduit::Node &domain, const std::string &topo_name)
-{
-  int res = 0;
-
-  const conduit::Node &n_topo = domain["topologies/" + topo_name];
-
-  const std::string c_name = n_topo["coordset"].as_string();
-  const conduit::Node &n_coords = domain["coordsets/" + c_name];
-  const std::string c_type = n_coords["type"].as_string();
-
-  if(c_type == "uniform")
-  {
-    res = n_coords["dims/i"].to_int32();
-    if(n_coords.has_path("dims/j"))
-    {
-      res *= n_coords["dims/j"].to_int32();
-    }
-    if(n_coords.has_path("dims/k"))
-    {
-      res *= n_coords["dims/k"].to_int32();
-    }
-  }
-
-  if(c_type == "rectilinear")
-  {
-    res = n_coords["values/x"].dtype().number_of_elements();
-
-    if(n_coords.has_path("values/y"))
-    {
-      res *= n_coords["values/y"].dtype().number_of_elements();
-    }
-
-    if(n_coords.has_path("values/z"))
-    {
-      res *= n_coords["values/z"].dtype().number_of_elements();
-    }
-  }
-
-  if(c_type == "explicit")
-  {
-    res = n_coords["values/x"].dtype().number_of_elements();
-  }
-
-  return res;
-}
-
-int
-num_cells(const conduit::Node &domain, const std::string &topo_name)
-{
-  const conduit::Node &n_topo = domain["topologies/" + topo_name];
-  const std::string topo_type = n_topo["type"].as_string();
-
-  int res = -1;
-
-  if(topo_type == "unstructured")
-  {
-    const std::string shape = n_topo["elements/shape"].as_string();
-    const int conn_size =
-        n_topo["elements/connectivity"].dtype().number_of_elements();
-    const int per_cell = detail::get_num_indices(shape);
-    res = conn_size / per_cell;
-  }
-
-  if(topo_type == "points")
-  {
-    return num_points(domain, topo_name);
-  }
-
-  const std::string c_name = n_topo["coordset"].as_string();
-  const conduit::Node &n_coords = domain["coordsets/" + c_name];
-
-  if(topo_type == "uniform")
-  {
-    res = n_coords["dims/i"].to_int32() - 1;
-    if(n_coords.has_path("dims/j"))
-    {
-      res *= n_coords["dims/j"].to_int32() - 1;
-    }
-    if(n_coords.has_path("dims/k"))
-    {
-      res *= n_coords["dims/k"].to_int32() - 1;
-    }
-  }
-
-  if(topo_type == "rectilinear")
-  {
-    res = n_coords["values/x"].dtype().number_of_elements() - 1;
-
-    if(n_coords.has_path("values/y"))
-    {
-      res *= n_coords["values/y"].dtype().number_of_elements() - 1;
-    }
-
-    if(n_coords.has_path("values/z"))
-    {
-      res *= n_coords["values/z"].dtype().number_of_elements() - 1;
-    }
-  }
-
-  if(topo_type == "structured")
-  {
-    res = n_topo["elements/dims/i"].to_int32() - 1;
-    if(n_topo.has_path("elements/dims/j"))
-    {
-      res *= n_topo["elements/dims/j"].to_int32() - 1;
-    }
-    if(n_topo.has_path("elements/dims/k"))
-    {
-      res *= n_topo["elements/dims/k"].to_int32() - 1;
-    }
-  }
-
-  return res;
-}
-
 conduit::Node
 field_histogram(const conduit::Node &dataset,
                 const std::string &field,
@@ -853,214 +313,31 @@ field_histogram(const conduit::Node &dataset,
       res = array_histogram(dom[path], min_val, max_val, num_bins);
 
       double *dom_hist = res["value"].value();
-#ifdef ASCENT_USE_OPENMP
-#pragma omp parallel for
-#endif
-      for(int bin_index = 0; bin_index < num_bins; ++bin_index)
-      {
-        bins[bin_index] += dom_hist[bin_index];
-      }
-    }
-  }
-  conduit::Node res;
-
-#ifdef ASCENT_MPI_ENABLED
-  double *global_bins = new double[num_bins];
-
-  MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
-  MPI_Allreduce(bins, global_bins, num_bins, MPI_DOUBLE, MPI_SUM, mpi_comm);
-
-  delete[] bins;
-  bins = global_bins;
-#endif
-  res["value"].set(bins, num_bins);
-  res["min_val"] = min_val;
-  res["max_val"] = max_val;
-  res["num_bins"] = num_bins;
-  delete[] bins;
-  return res;
-}
-
-// returns a Node containing the min, max and dim for x,y,z given a topology
-conduit::Node
-global_bounds(const conduit::Node &dataset, const std::string &topo_name)
-{
-  double min_coords[3] = {std::numeric_limits<double>::max(),
-                          std::numeric_limits<double>::max(),
-                          std::numeric_limits<double>::max()};
-  double max_coords[3] = {std::numeric_limits<double>::lowest(),
-                          std::numeric_limits<double>::lowest(),
-                          std::numeric_limits<double>::lowest()};
-  const std::string axes[3][3] = {
-      {"x", "i", "dx"}, {"y", "j", "dy"}, {"z", "k", "dz"}};
-  for(int dom_index = 0; dom_index < dataset.number_of_children(); ++dom_index)
-  {
-    const conduit::Node &dom = dataset.child(dom_index);
-    if(!dom.has_path("topologies/"+topo_name))
-    {
-      continue;
-    }
-    const conduit::Node &n_topo = dom["topologies/" + topo_name];
-    const std::string topo_type = n_topo["type"].as_string();
-    const std::string coords_name = n_topo["coordset"].as_string();
-    const conduit::Node &n_coords = dom["coordsets/" + coords_name];
-
-    if(topo_type == "uniform")
-    {
-      int num_dims = n_coords["dims"].number_of_children();
-      for(int i = 0; i < num_dims; ++i)
-      {
-        double origin = n_coords["origin/" + axes[i][0]].to_float64();
-        int dim = n_coords["dims/" + axes[i][1]].to_int();
-        double spacing = n_coords["spacing/" + axes[i][2]].to_float64();
-
-        min_coords[i] = std::min(min_coords[i], origin);
-        max_coords[i] = std::max(min_coords[i], origin + (dim - 1) * spacing);
-      }
-    }
-    else if(topo_type == "rectilinear" || topo_type == "structured" ||
-            topo_type == "unstructured")
-    {
-      int num_dims = n_coords["values"].number_of_children();
-      for(int i = 0; i < num_dims; ++i)
-      {
-        const std::string axis_path = "values/" + axes[i][0];
-        min_coords[i] = std::min(
-            min_coords[i], array_min(n_coords[axis_path])["value"].as_double());
-        max_coords[i] = std::max(
-            max_coords[i], array_max(n_coords[axis_path])["value"].as_double());
-      }
-    }
-    else
-    {
-      ASCENT_ERROR("The Architect: unknown topology type: '" << topo_type
-                                                             << "'");
-    }
-  }
-#ifdef ASCENT_MPI_ENABLED
-  MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
-  MPI_Allreduce(MPI_IN_PLACE, min_coords, 3, MPI_DOUBLE, MPI_MIN, mpi_comm);
-  MPI_Allreduce(MPI_IN_PLACE, max_coords, 3, MPI_DOUBLE, MPI_MAX, mpi_comm);
-#endif
-  conduit::Node res;
-  res["max_coords"].set(max_coords, 3);
-  res["min_coords"].set(min_coords, 3);
-  return res;
-}
-
-// get the association and topology and ensure they are the same
-conduit::Node
-global_topo_and_assoc(const conduit::Node &dataset,
-                      const std::vector<std::string> var_names)
-{
-  std::string assoc_str;
-  std::string topo_name;
-  bool error = false;
-  conduit::Node error_msg;
-
-  for(int dom_index = 0; dom_index < dataset.number_of_children(); ++dom_index)
-  {
-    const conduit::Node &dom = dataset.child(dom_index);
-    for(const std::string &var_name : var_names)
-    {
-      if(dom.has_path("fields/" + var_name))
-      {
-        const std::string cur_assoc_str =
-            dom["fields/" + var_name + "/association"].as_string();
-        if(assoc_str.empty())
-        {
-          assoc_str = cur_assoc_str;
-        }
-        else if(assoc_str != cur_assoc_str)
-        {
-          error_msg.append() = "All Binning fields must have the same association.";
-          error = true;
-        }
-
-        const std::string cur_topo_name =
-            dom["fields/" + var_name + "/topology"].as_string();
-        if(topo_name.empty())
-        {
-          topo_name = cur_topo_name;
-        }
-        else if(topo_name != cur_topo_name)
-        {
-          error_msg.append() = "All Binning fields must have the same topology.";
-          error = true;
-        }
-      }
-    }
-  }
-#ifdef ASCENT_MPI_ENABLED
-  int rank;
-  MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
-  MPI_Comm_rank(mpi_comm, &rank);
-
-  struct MaxLoc
-  {
-    double size;
-    int rank;
-  };
-
-  // there is no MPI_INT_INT so shove the "small" size into double
-  MaxLoc maxloc = {(double)topo_name.length(), rank};
-  MaxLoc maxloc_res;
-  MPI_Allreduce(&maxloc, &maxloc_res, 1, MPI_DOUBLE_INT, MPI_MAXLOC, mpi_comm);
-
-  conduit::Node msg;
-  msg["assoc_str"] = assoc_str;
-  msg["topo_name"] = topo_name;
-  conduit::relay::mpi::broadcast_using_schema(msg, maxloc_res.rank, mpi_comm);
-
-
-  if(assoc_str != "" && assoc_str != msg["assoc_str"].as_string())
-  {
-    error_msg.append() = "All Binning fields must have the same association.";
-    error = true;
-  }
-  if(topo_name != "" && topo_name != msg["topo_name"].as_string())
-  {
-    error_msg.append() = "All Binning fields must have the same topology.";
-    error = true;
-  }
-  assoc_str = msg["assoc_str"].as_string();
-  topo_name = msg["topo_name"].as_string();
-#endif
-  if(assoc_str.empty())
-  {
-
-    error_msg.append() = "Could not determine the associate from the given "
-                          "reduction_var and axes. Try supplying a field.";
-    error = true;
-  }
-  else if(assoc_str != "vertex" && assoc_str != "element")
-  {
-    error_msg.append() = "Unknown association: '"
-                       + assoc_str
-                       + "'. Binning only supports vertex and element association.";
+#ifdef ASCENT_USE_OPENMP
+#pragma omp parallel for
+#endif
+      for(int bin_index = 0; bin_index < num_bins; ++bin_index)
+      {
+        bins[bin_index] += dom_hist[bin_index];
+      }
+    }
   }
+  conduit::Node res;
 
-  int error_int = error ? 1 : 0;
 #ifdef ASCENT_MPI_ENABLED
-  int global_error;
-  MPI_Allreduce(&error_int, &global_error, 1, MPI_INT, MPI_MAX, mpi_comm);
-  conduit::Node global_msg;
-  error = global_error == 1;
-  if(global_error == 1)
-  {
-    conduit::relay::mpi::all_gather_using_schema(error_msg, global_msg, mpi_comm);
-    error_msg = global_msg;
-  }
-#endif
+  double *global_bins = new double[num_bins];
 
-  if(error)
-  {
-    ASCENT_ERROR(error_msg.to_yaml());
-  }
+  MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
+  MPI_Allreduce(bins, global_bins, num_bins, MPI_DOUBLE, MPI_SUM, mpi_comm);
 
-  conduit::Node res;
-  res["topo_name"] = topo_name;
-  res["assoc_str"] = assoc_str;
+  delete[] bins;
+  bins = global_bins;
+#endif
+  res["value"].set(bins, num_bins);
+  res["min_val"] = min_val;
+  res["max_val"] = max_val;
+  res["num_bins"] = num_bins;
+  delete[] bins;
   return res;
 }
 
@@ -1155,12 +432,14 @@ get_bin_index(const conduit::float64 value, const conduit::Node &axis)
 }
 
 void
-populate_homes(const conduit::Node &dom,
+populate_homes(const TopologyMetadata &metadata,
+               const int dom_index,
                const conduit::Node &bin_axes,
                const std::string &topo_name,
                const std::string &assoc_str,
                conduit::Node &res)
 {
+  const conduit::Node &dom = metadata.dataset().child(dom_index);
   int num_axes = bin_axes.number_of_children();
 
   // ensure this domain has the necessary fields
@@ -1171,7 +450,6 @@ populate_homes(const conduit::Node &dom,
     if(!dom.has_path("fields/" + axis_name) && !is_xyz(axis_name))
     {
       // return an error and skip the domain in binning
-      conduit::Node res;
       res["error/field_name"] = axis_name;
       return;
     }
@@ -1181,16 +459,19 @@ populate_homes(const conduit::Node &dom,
   conduit::index_t homes_size = 0;
   if(assoc_str == "vertex")
   {
-    homes_size = num_points(dom, topo_name);
+    homes_size = metadata.num_points(dom_index, topo_name);
   }
   else if(assoc_str == "element")
   {
-    homes_size = num_cells(dom, topo_name);
+    homes_size = metadata.num_cells(dom_index, topo_name);
   }
   // each domain has a homes array
   // homes maps each datapoint (or cell) to an index in bins
   res.set(conduit::DataType::c_int(homes_size));
   int *homes = res.value();
+#ifdef ASCENT_USE_OPENMP
+#pragma omp parallel for
+#endif
   for(int i = 0; i < homes_size; ++i)
   {
     homes[i] = 0;
@@ -1207,7 +488,11 @@ populate_homes(const conduit::Node &dom,
       if(dom[values_path].dtype().is_float32())
       {
         const conduit::float32_array values = dom[values_path].value();
-        for(int i = 0; i < values.number_of_elements(); ++i)
+        const int size = values.number_of_elements();
+#ifdef ASCENT_USE_OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < size; ++i)
         {
           const int bin_index = get_bin_index(values[i], axis);
           // don't set anything if we haven't found a bin yet
@@ -1227,7 +512,11 @@ populate_homes(const conduit::Node &dom,
       else
       {
         const conduit::float64_array values = dom[values_path].value();
-        for(int i = 0; i < values.number_of_elements(); ++i)
+        const int size = values.number_of_elements();
+#ifdef ASCENT_USE_OPENMP
+#pragma omp parallel for
+#endif
+        for(int i = 0; i < size; ++i)
         {
           const int bin_index = get_bin_index(values[i], axis);
           // don't set anything if we haven't found a bin yet
@@ -1248,18 +537,25 @@ populate_homes(const conduit::Node &dom,
     else if(is_xyz(axis_name))
     {
       int coord = axis_name[0] - 'x';
+      const DomainLocator &locator = *metadata.locator(dom_index, topo_name);
+      const double *centroids =
+          assoc_str == "element"
+              ? metadata.centroids(dom_index, topo_name).data()
+              : nullptr;
+#ifdef ASCENT_USE_OPENMP
+#pragma omp parallel for
+#endif
       for(int i = 0; i < homes_size; ++i)
       {
-        conduit::Node n_loc;
+        double loc[3] = {0., 0., 0.};
         if(assoc_str == "vertex")
         {
-          n_loc = vert_location(dom, i, topo_name);
+          locator.vertex(i, loc);
         }
         else if(assoc_str == "element")
         {
-          n_loc = element_location(dom, i, topo_name);
+          loc[coord] = centroids[i * 3 + coord];
         }
-        const double *loc = n_loc.value();
         const int bin_index = get_bin_index(loc[coord], axis);
         // don't set anything if we haven't found a bin yet
         if(homes[i] != -1)
@@ -1290,89 +586,585 @@ populate_homes(const conduit::Node &dom,
   }
 }
 
+namespace detail
+{
+
+// number of variables held per bin (e.g. sum and cnt for average)
+int
+num_bin_vars(const std::string &reduction_op)
+{
+  if(reduction_op == "var" || reduction_op == "std")
+  {
+    return 3;
+  }
+  else if(reduction_op == "min" || reduction_op == "max")
+  {
+    return 1;
+  }
+  return 2;
+}
+
+double
+bin_init_val(const std::string &reduction_op)
+{
+  if(reduction_op == "max")
+  {
+    return std::numeric_limits<double>::lowest();
+  }
+  else if(reduction_op == "min")
+  {
+    return std::numeric_limits<double>::max();
+  }
+  return 0.;
+}
+
 void
-update_bin(double *bins,
-           const int i,
-           const double value,
-           const std::string &reduction_op)
+update_bin(double *bin, const double value, const std::string &reduction_op)
 {
   if(reduction_op == "min")
   {
-    bins[i] = std::min(bins[i], value);
+    bin[0] = std::min(bin[0], value);
   }
   else if(reduction_op == "max")
   {
-    bins[i] = std::max(bins[i], value);
+    bin[0] = std::max(bin[0], value);
   }
   else if(reduction_op == "avg" || reduction_op == "sum" ||
           reduction_op == "pdf")
   {
-    bins[2 * i] += value;
-    bins[2 * i + 1] += 1;
+    bin[0] += value;
+    bin[1] += 1;
   }
   else if(reduction_op == "rms")
   {
-    bins[2 * i] += value * value;
-    bins[2 * i + 1] += 1;
+    bin[0] += value * value;
+    bin[1] += 1;
   }
   else if(reduction_op == "var" || reduction_op == "std")
   {
-    bins[3 * i] += value * value;
-    bins[3 * i + 1] += value;
-    bins[3 * i + 2] += 1;
+    bin[0] += value * value;
+    bin[1] += value;
+    bin[2] += 1;
   }
 }
 
-void init_bins(double *bins,
-               const int size,
-               const std::string reduction_op)
+// combines the partial results of the same bin
+void
+combine_bin(double *bin, const double *other, const std::string &reduction_op)
 {
-  if(reduction_op != "max" && reduction_op != "min")
+  if(reduction_op == "min")
   {
-    // already init to 0, so do nothing
-    return;
+    bin[0] = std::min(bin[0], other[0]);
   }
-
-  double init_val;
-  if(reduction_op == "max")
+  else if(reduction_op == "max")
   {
-    init_val = std::numeric_limits<double>::lowest();
+    bin[0] = std::max(bin[0], other[0]);
   }
   else
   {
-    init_val = std::numeric_limits<double>::max();
+    const int num_vars = num_bin_vars(reduction_op);
+    for(int v = 0; v < num_vars; ++v)
+    {
+      bin[v] += other[v];
+    }
+  }
+}
+
+bool
+bin_is_empty(const double *bin, const std::string &reduction_op)
+{
+  if(reduction_op == "min")
+  {
+    return bin[0] == std::numeric_limits<double>::max();
+  }
+  else if(reduction_op == "max")
+  {
+    return bin[0] == std::numeric_limits<double>::lowest();
+  }
+  // the count is the last variable
+  return bin[num_bin_vars(reduction_op) - 1] == 0;
+}
+
+// total is the sum over all bins, only used by pdf
+double
+bin_result(const double *bin, const std::string &reduction_op, double total)
+{
+  if(reduction_op == "pdf")
+  {
+    return bin[0] / total;
+  }
+  else if(reduction_op == "avg")
+  {
+    return bin[0] / bin[1];
+  }
+  else if(reduction_op == "rms")
+  {
+    return std::sqrt(bin[0] / bin[1]);
+  }
+  else if(reduction_op == "var" || reduction_op == "std")
+  {
+    const double n = bin[2];
+    const double var = (bin[0] / n) - std::pow(bin[1] / n, 2);
+    return reduction_op == "var" ? var : std::sqrt(var);
+  }
+  // sum, min, max
+  return bin[0];
+}
+
+//
+// Open addressing hash map from bin index to the variables of the bin,
+// for binnings where only a small part of the bins are occupied.
+//
+class SparseBins
+{
+public:
+  SparseBins(const int num_vars, const double init_val)
+    : m_num_vars(num_vars),
+      m_init_val(init_val),
+      m_size(0)
+  {
+    resize(64);
+  }
+
+  // the variables of the bin, inserted if needed
+  double *bin(const conduit::int64 key)
+  {
+    conduit::index_t slot = find(key);
+    if(m_keys[slot] == empty_key)
+    {
+      if(2 * (m_size + 1) > conduit::index_t(m_keys.size()))
+      {
+        resize(2 * m_keys.size());
+        slot = find(key);
+      }
+      m_keys[slot] = key;
+      m_size++;
+    }
+    return &m_values[slot * m_num_vars];
+  }
+
+  void merge(const SparseBins &other, const std::string &reduction_op)
+  {
+    const conduit::index_t capacity = other.m_keys.size();
+    for(conduit::index_t slot = 0; slot < capacity; ++slot)
+    {
+      if(other.m_keys[slot] != empty_key)
+      {
+        combine_bin(bin(other.m_keys[slot]),
+                    &other.m_values[slot * m_num_vars],
+                    reduction_op);
+      }
+    }
+  }
+
+  conduit::index_t size() const
+  {
+    return m_size;
+  }
+
+  // flat keys and values of the occupied bins
+  void pack(std::vector<conduit::int64> &keys,
+            std::vector<double> &values) const
+  {
+    const conduit::index_t capacity = m_keys.size();
+    for(conduit::index_t slot = 0; slot < capacity; ++slot)
+    {
+      if(m_keys[slot] != empty_key)
+      {
+        keys.push_back(m_keys[slot]);
+        values.insert(values.end(),
+                      m_values.begin() + slot * m_num_vars,
+                      m_values.begin() + (slot + 1) * m_num_vars);
+      }
+    }
+  }
+
+private:
+  static const conduit::int64 empty_key = -1;
+
+  conduit::index_t find(const conduit::int64 key) const
+  {
+    const conduit::index_t mask = m_keys.size() - 1;
+    conduit::index_t slot =
+        (conduit::uint64(key) * 0x9E3779B97F4A7C15ull >> 17) & mask;
+    while(m_keys[slot] != empty_key && m_keys[slot] != key)
+    {
+      slot = (slot + 1) & mask;
+    }
+    return slot;
+  }
+
+  void resize(const conduit::index_t capacity)
+  {
+    std::vector<conduit::int64> keys(capacity, conduit::int64(empty_key));
+    std::vector<double> values(capacity * m_num_vars, m_init_val);
+    keys.swap(m_keys);
+    values.swap(m_values);
+    const conduit::index_t old_capacity = keys.size();
+    for(conduit::index_t slot = 0; slot < old_capacity; ++slot)
+    {
+      if(keys[slot] != empty_key)
+      {
+        const conduit::index_t new_slot = find(keys[slot]);
+        m_keys[new_slot] = keys[slot];
+        std::copy(values.begin() + slot * m_num_vars,
+                  values.begin() + (slot + 1) * m_num_vars,
+                  m_values.begin() + new_slot * m_num_vars);
+      }
+    }
+  }
+
+  int m_num_vars;
+  double m_init_val;
+  conduit::index_t m_size;
+  std::vector<conduit::int64> m_keys;
+  std::vector<double> m_values;
+};
+
+#ifdef ASCENT_MPI_ENABLED
+// MPI counts are ints, so larger messages are sent in pieces
+const conduit::int64 max_message_size = std::numeric_limits<int>::max();
+
+//
+// sends send_counts[r] values from send_ptrs[r] to each rank r, and
+// receives what each rank r sends to this rank in recv[r]. Counts are
+// 64 bit.
+//
+template<typename T>
+void exchange(const std::vector<const T*> &send_ptrs,
+              const std::vector<conduit::int64> &send_counts,
+              std::vector<std::vector<T>> &recv,
+              MPI_Datatype mpi_type,
+              MPI_Comm mpi_comm)
+{
+  int procs;
+  MPI_Comm_size(mpi_comm, &procs);
+
+  std::vector<conduit::int64> recv_counts(procs);
+  MPI_Alltoall(send_counts.data(), 1, MPI_LONG_LONG_INT,
+               recv_counts.data(), 1, MPI_LONG_LONG_INT,
+               mpi_comm);
+
+  // pieces between two ranks are matched in order
+  std::vector<MPI_Request> requests;
+  recv.resize(procs);
+  for(int r = 0; r < procs; ++r)
+  {
+    recv[r].resize(recv_counts[r]);
+    for(conduit::int64 offset = 0; offset < recv_counts[r]; offset += max_message_size)
+    {
+      const int count = int(std::min(max_message_size, recv_counts[r] - offset));
+      requests.push_back(MPI_REQUEST_NULL);
+      MPI_Irecv(recv[r].data() + offset, count, mpi_type, r, 0, mpi_comm,
+                &requests.back());
+    }
+  }
+  for(int r = 0; r < procs; ++r)
+  {
+    for(conduit::int64 offset = 0; offset < send_counts[r]; offset += max_message_size)
+    {
+      const int count = int(std::min(max_message_size, send_counts[r] - offset));
+      requests.push_back(MPI_REQUEST_NULL);
+      MPI_Isend(send_ptrs[r] + offset, count, mpi_type, r, 0, mpi_comm,
+                &requests.back());
+    }
+  }
+  MPI_Waitall(int(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+}
+#endif
+
+//
+// Dense or sparse storage of the bins. Sparse bins are accumulated per
+// thread and merged by merge_threads.
+//
+class Bins
+{
+public:
+  Bins(const conduit::index_t num_bins,
+       const std::string &reduction_op,
+       const bool sparse)
+    : m_reduction_op(reduction_op),
+      m_num_vars(num_bin_vars(reduction_op)),
+      m_sparse(sparse)
+  {
+    const double init_val = bin_init_val(reduction_op);
+    if(m_sparse)
+    {
+      int num_threads = 1;
+#ifdef ASCENT_USE_OPENMP
+      num_threads = omp_get_max_threads();
+#endif
+      m_thread_bins.resize(num_threads, SparseBins(m_num_vars, init_val));
+    }
+    else
+    {
+      m_dense.resize(num_bins * m_num_vars, init_val);
+    }
+  }
+
+  bool sparse() const
+  {
+    return m_sparse;
+  }
+
+  // bins a value for each home, value(i) gives the value of home i
+  template<typename ValueFunc>
+  void update(const int *homes, const int homes_size, ValueFunc value)
+  {
+    if(!m_sparse)
+    {
+      for(int i = 0; i < homes_size; ++i)
+      {
+        if(homes[i] != -1)
+        {
+          update_bin(&m_dense[conduit::index_t(homes[i]) * m_num_vars],
+                     value(i),
+                     m_reduction_op);
+        }
+      }
+      return;
+    }
+
+#ifdef ASCENT_USE_OPENMP
+#pragma omp parallel
+#endif
+    {
+      int thread = 0;
+#ifdef ASCENT_USE_OPENMP
+      thread = omp_get_thread_num();
+#endif
+      SparseBins &bins = m_thread_bins[thread];
+#ifdef ASCENT_USE_OPENMP
+#pragma omp for schedule(static)
+#endif
+      for(int i = 0; i < homes_size; ++i)
+      {
+        if(homes[i] != -1)
+        {
+          update_bin(bins.bin(homes[i]), value(i), m_reduction_op);
+        }
+      }
+    }
+  }
+
+  // combine the bins of all ranks
+  void reduce()
+  {
+    if(!m_sparse)
+    {
+#ifdef ASCENT_MPI_ENABLED
+      MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
+      MPI_Op op = MPI_SUM;
+      if(m_reduction_op == "min")
+      {
+        op = MPI_MIN;
+      }
+      else if(m_reduction_op == "max")
+      {
+        op = MPI_MAX;
+      }
+      const conduit::int64 size = m_dense.size();
+      for(conduit::int64 offset = 0; offset < size; offset += max_message_size)
+      {
+        const int count = int(std::min(max_message_size, size - offset));
+        MPI_Allreduce(MPI_IN_PLACE, m_dense.data() + offset, count,
+                      MPI_DOUBLE, op, mpi_comm);
+      }
+#endif
+      return;
+    }
+
+    // merge the threads in order
+    for(size_t t = 1; t < m_thread_bins.size(); ++t)
+    {
+      m_thread_bins[0].merge(m_thread_bins[t], m_reduction_op);
+    }
+    m_thread_bins.resize(1, SparseBins(m_num_vars, 0.));
+
+#ifdef ASCENT_MPI_ENABLED
+    // sparse key value exchange of the occupied bins. Each bin is owned
+    // by one rank (by a hash of its key), which combines what every rank
+    // has for it, so only the combined bins are sent to all ranks
+    MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
+    int procs;
+    MPI_Comm_size(mpi_comm, &procs);
+
+    std::vector<conduit::int64> keys;
+    std::vector<double> values;
+    m_thread_bins[0].pack(keys, values);
+    const conduit::int64 num_keys = keys.size();
+
+    // group the bins by owner
+    std::vector<int> owners(num_keys);
+    std::vector<conduit::int64> key_counts(procs, 0);
+    for(conduit::int64 k = 0; k < num_keys; ++k)
+    {
+      owners[k] = int((conduit::uint64(keys[k]) * 0x9E3779B97F4A7C15ull >> 32) % procs);
+      key_counts[owners[k]]++;
+    }
+    std::vector<conduit::int64> key_offsets(procs, 0);
+    for(int r = 1; r < procs; ++r)
+    {
+      key_offsets[r] = key_offsets[r - 1] + key_counts[r - 1];
+    }
+    std::vector<conduit::int64> owner_keys(num_keys);
+    std::vector<double> owner_values(num_keys * m_num_vars);
+    std::vector<conduit::int64> fill(key_offsets);
+    for(conduit::int64 k = 0; k < num_keys; ++k)
+    {
+      const conduit::int64 dest = fill[owners[k]]++;
+      owner_keys[dest] = keys[k];
+      std::copy(values.begin() + k * m_num_vars,
+                values.begin() + (k + 1) * m_num_vars,
+                owner_values.begin() + dest * m_num_vars);
+    }
+
+    std::vector<const conduit::int64*> key_ptrs(procs);
+    std::vector<const double*> value_ptrs(procs);
+    std::vector<conduit::int64> value_counts(procs);
+    for(int r = 0; r < procs; ++r)
+    {
+      key_ptrs[r] = owner_keys.data() + key_offsets[r];
+      value_ptrs[r] = owner_values.data() + key_offsets[r] * m_num_vars;
+      value_counts[r] = key_counts[r] * m_num_vars;
+    }
+    std::vector<std::vector<conduit::int64>> recv_keys;
+    std::vector<std::vector<double>> recv_values;
+    exchange(key_ptrs, key_counts, recv_keys, MPI_LONG_LONG_INT, mpi_comm);
+    exchange(value_ptrs, value_counts, recv_values, MPI_DOUBLE, mpi_comm);
+
+    // the owner combines its bins in rank order
+    SparseBins owned(m_num_vars, bin_init_val(m_reduction_op));
+    for(int r = 0; r < procs; ++r)
+    {
+      const conduit::int64 size = recv_keys[r].size();
+      for(conduit::int64 k = 0; k < size; ++k)
+      {
+        combine_bin(owned.bin(recv_keys[r][k]),
+                    &recv_values[r][k * m_num_vars],
+                    m_reduction_op);
+      }
+    }
+
+    // and sends the result to everyone
+    keys.clear();
+    values.clear();
+    owned.pack(keys, values);
+    const conduit::int64 num_owned = keys.size();
+    std::fill(key_ptrs.begin(), key_ptrs.end(), keys.data());
+    std::fill(value_ptrs.begin(), value_ptrs.end(), values.data());
+    std::fill(key_counts.begin(), key_counts.end(), num_owned);
+    std::fill(value_counts.begin(), value_counts.end(), num_owned * m_num_vars);
+    exchange(key_ptrs, key_counts, recv_keys, MPI_LONG_LONG_INT, mpi_comm);
+    exchange(value_ptrs, value_counts, recv_values, MPI_DOUBLE, mpi_comm);
+
+    // every bin has one owner, so this only gathers them
+    SparseBins global(m_num_vars, bin_init_val(m_reduction_op));
+    for(int r = 0; r < procs; ++r)
+    {
+      const conduit::int64 size = recv_keys[r].size();
+      for(conduit::int64 k = 0; k < size; ++k)
+      {
+        combine_bin(global.bin(recv_keys[r][k]),
+                    &recv_values[r][k * m_num_vars],
+                    m_reduction_op);
+      }
+    }
+    m_thread_bins[0] = global;
+#endif
+  }
+
+  // final value of every bin
+  void result(const double empty_bin_val,
+              const conduit::index_t num_bins,
+              double *res_bins)
+  {
+    std::vector<conduit::int64> keys;
+    std::vector<double> values;
+    const double *bins = m_dense.data();
+    conduit::index_t size = num_bins;
+    if(m_sparse)
+    {
+      m_thread_bins[0].pack(keys, values);
+      bins = values.data();
+      size = keys.size();
+#ifdef ASCENT_USE_OPENMP
+#pragma omp parallel for
+#endif
+      for(conduit::index_t i = 0; i < num_bins; ++i)
+      {
+        res_bins[i] = empty_bin_val;
+      }
+    }
+
+    double total = 0;
+    if(m_reduction_op == "pdf")
+    {
+#ifdef ASCENT_USE_OPENMP
+#pragma omp parallel for reduction(+ : total)
+#endif
+      for(conduit::index_t i = 0; i < size; ++i)
+      {
+        total += bins[2 * i];
+      }
+    }
+
+#ifdef ASCENT_USE_OPENMP
+#pragma omp parallel for
+#endif
+    for(conduit::index_t i = 0; i < size; ++i)
+    {
+      const double *bin = bins + i * m_num_vars;
+      const conduit::index_t res_index = m_sparse ? keys[i] : i;
+      if(bin_is_empty(bin, m_reduction_op))
+      {
+        res_bins[res_index] = empty_bin_val;
+      }
+      else
+      {
+        res_bins[res_index] = bin_result(bin, m_reduction_op, total);
+      }
+    }
   }
 
-#ifdef ASCENT_USE_OPENMP
-#pragma omp parallel for
-#endif
-  for(int i = 0; i < size; ++i)
-  {
-    bins[i] = init_val;
-  }
+private:
+  std::string m_reduction_op;
+  int m_num_vars;
+  bool m_sparse;
+  std::vector<double> m_dense;
+  std::vector<SparseBins> m_thread_bins;
+};
 
-}
+} // namespace detail
 
 // reduction_op: sum, min, max, avg, pdf, std, var, rms
-conduit::Node
-binning(const conduit::Node &dataset,
+void
+binning(const TopologyMetadata &metadata,
         conduit::Node &bin_axes,
         const std::string &reduction_var,
         const std::string &reduction_op,
         const double empty_bin_val,
-        const std::string &component)
+        const std::string &component,
+        conduit::Node &res,
+        conduit::Node *dom_homes,
+        const std::string &storage)
 {
+  if(storage != "auto" && storage != "dense" && storage != "sparse")
+  {
+    ASCENT_ERROR("Binning: unknown storage '" << storage
+                 << "'. Known storage: auto, dense, sparse");
+  }
+  const conduit::Node &dataset = metadata.dataset();
   std::vector<std::string> var_names = bin_axes.child_names();
   if(!reduction_var.empty())
   {
     var_names.push_back(reduction_var);
   }
-  const conduit::Node &topo_and_assoc =
-      global_topo_and_assoc(dataset, var_names);
+  const conduit::Node topo_and_assoc = metadata.topo_and_assoc(var_names);
   const std::string topo_name = topo_and_assoc["topo_name"].as_string();
   const std::string assoc_str = topo_and_assoc["assoc_str"].as_string();
 
-  const conduit::Node &bounds = global_bounds(dataset, topo_name);
+  const conduit::Node bounds = metadata.global_bounds(topo_name);
   const double *min_coords = bounds["min_coords"].value();
   const double *max_coords = bounds["max_coords"].value();
   const std::string axes[3][3] = {
@@ -1432,30 +1224,35 @@ binning(const conduit::Node &dataset,
           bin_axes.child(axis_index)["bins"].dtype().number_of_elements() - 1;
     }
   }
-  // number of variables held per bin (e.g. sum and cnt for average)
-  int num_bin_vars = 2;
-  if(reduction_op == "var" || reduction_op == "std")
-  {
-    num_bin_vars = 3;
-  }
-  else if(reduction_op == "min" || reduction_op == "max")
+  // most bins stay empty when there are far fewer values than bins, so
+  // only keep the occupied ones
+  const conduit::index_t num_values =
+      assoc_str == "vertex" ? metadata.global_num_points(topo_name)
+                            : metadata.global_num_cells(topo_name);
+  const bool sparse =
+      storage == "auto" ? conduit::index_t(num_bins) > 4 * num_values
+                        : storage == "sparse";
+  detail::Bins bins(num_bins, reduction_op, sparse);
+
+  if(dom_homes != nullptr)
   {
-    num_bin_vars = 1;
+    dom_homes->reset();
   }
-  const int bins_size = num_bins * num_bin_vars;
-  double *bins = new double[bins_size]();
-  init_bins(bins, bins_size, reduction_op);
-
   for(int dom_index = 0; dom_index < dataset.number_of_children(); ++dom_index)
   {
+    // keep the index of every domain for painting if asked to, domains
+    // that aren't binned get an empty one
+    conduit::Node local_homes;
+    conduit::Node &n_homes =
+      dom_homes != nullptr ? dom_homes->append() : local_homes;
+
     const conduit::Node &dom = dataset.child(dom_index);
     if(!dom.has_path("topologies/"+topo_name))
     {
       continue;
     }
 
-    conduit::Node n_homes;
-    populate_homes(dom, bin_axes, topo_name, assoc_str, n_homes);
+    populate_homes(metadata, dom_index, bin_axes, topo_name, assoc_str, n_homes);
 
     if(n_homes.has_path("error"))
     {
@@ -1471,16 +1268,7 @@ binning(const conduit::Node &dataset,
     // update bins
     if(reduction_var.empty())
     {
-//#ifdef ASCENT_USE_OPENMP
-//#pragma omp parallel for
-//#endif
-      for(int i = 0; i < homes_size; ++i)
-      {
-        if(homes[i] != -1)
-        {
-          update_bin(bins, homes[i], 1, reduction_op);
-        }
-      }
+      bins.update(homes, homes_size, [](const int) { return 1.; });
     }
     else if(dom.has_path("fields/" + reduction_var))
     {
@@ -1491,54 +1279,35 @@ binning(const conduit::Node &dataset,
       if(dom[values_path].dtype().is_float32())
       {
         const conduit::float32_array values = dom[values_path].value();
-//#ifdef ASCENT_USE_OPENMP
-//#pragma omp parallel for
-//#endif
-        for(int i = 0; i < homes_size; ++i)
-        {
-          if(homes[i] != -1)
-          {
-            update_bin(bins, homes[i], values[i], reduction_op);
-          }
-        }
+        bins.update(homes, homes_size,
+                    [&values](const int i) { return double(values[i]); });
       }
       else
       {
         const conduit::float64_array values = dom[values_path].value();
-//#ifdef ASCENT_USE_OPENMP
-//#pragma omp parallel for
-//#endif
-        for(int i = 0; i < homes_size; ++i)
-        {
-          if(homes[i] != -1)
-          {
-            update_bin(bins, homes[i], values[i], reduction_op);
-          }
-        }
+        bins.update(homes, homes_size,
+                    [&values](const int i) { return values[i]; });
       }
     }
     else if(is_xyz(reduction_var))
     {
       int coord = reduction_var[0] - 'x';
-//#ifdef ASCENT_USE_OPENMP
-//#pragma omp parallel for
-//#endif
-      for(int i = 0; i < homes_size; ++i)
+      const DomainLocator &locator = *metadata.locator(dom_index, topo_name);
+      if(assoc_str == "vertex")
       {
-        conduit::Node n_loc;
-        if(assoc_str == "vertex")
-        {
-          n_loc = vert_location(dom, i, topo_name);
-        }
-        else if(assoc_str == "element")
-        {
-          n_loc = element_location(dom, i, topo_name);
-        }
-        const double *loc = n_loc.value();
-        if(homes[i] != -1)
-        {
-          update_bin(bins, homes[i], loc[coord], reduction_op);
-        }
+        bins.update(homes, homes_size, [&locator, coord](const int i) {
+          double loc[3] = {0., 0., 0.};
+          locator.vertex(i, loc);
+          return loc[coord];
+        });
+      }
+      else if(assoc_str == "element")
+      {
+        const double *centroids =
+            metadata.centroids(dom_index, topo_name).data();
+        bins.update(homes, homes_size, [centroids, coord](const int i) {
+          return centroids[i * 3 + coord];
+        });
       }
     }
     else
@@ -1549,195 +1318,31 @@ binning(const conduit::Node &dataset,
     }
   }
 
-#ifdef ASCENT_MPI_ENABLED
-  MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
-  double *global_bins = new double[bins_size];
-  if(reduction_op == "sum" || reduction_op == "pdf" || reduction_op == "avg" ||
-     reduction_op == "std" || reduction_op == "var" || reduction_op == "rms")
-  {
-    MPI_Allreduce(bins, global_bins, bins_size, MPI_DOUBLE, MPI_SUM, mpi_comm);
-  }
-  else if(reduction_op == "min")
-  {
-    MPI_Allreduce(bins, global_bins, bins_size, MPI_DOUBLE, MPI_MIN, mpi_comm);
-  }
-  else if(reduction_op == "max")
-  {
-    MPI_Allreduce(bins, global_bins, bins_size, MPI_DOUBLE, MPI_MAX, mpi_comm);
-  }
-  delete[] bins;
-  bins = global_bins;
-#endif
+  bins.reduce();
 
-  conduit::Node res;
   res["value"].set(conduit::DataType::c_double(num_bins));
   double *res_bins = res["value"].value();
-  if(reduction_op == "pdf")
-  {
-    double total = 0;
-#ifdef ASCENT_USE_OPENMP
-#pragma omp parallel for reduction(+ : total)
-#endif
-    for(int i = 0; i < num_bins; ++i)
-    {
-      total += bins[2 * i];
-    }
-#ifdef ASCENT_USE_OPENMP
-#pragma omp parallel for
-#endif
-    for(int i = 0; i < num_bins; ++i)
-    {
-      if(bins[2 * i + 1] == 0)
-      {
-        res_bins[i] = empty_bin_val;
-      }
-      else
-      {
-        res_bins[i] = bins[2 * i] / total;
-      }
-    }
-  }
-  else if(reduction_op == "min")
-  {
-#ifdef ASCENT_USE_OPENMP
-#pragma omp parallel for
-#endif
-    for(int i = 0; i < num_bins; ++i)
-    {
-      if(bins[i] == std::numeric_limits<double>::max())
-      {
-        res_bins[i] = empty_bin_val;
-      }
-      else
-      {
-        res_bins[i] = bins[i];
-      }
-    }
-  }
-  else if(reduction_op == "max")
-  {
-#ifdef ASCENT_USE_OPENMP
-#pragma omp parallel for
-#endif
-    for(int i = 0; i < num_bins; ++i)
-    {
-      if(bins[i] == std::numeric_limits<double>::lowest())
-      {
-        res_bins[i] = empty_bin_val;
-      }
-      else
-      {
-        res_bins[i] = bins[i];
-      }
-    }
-
-  }
-  else if(reduction_op == "sum")
-  {
-#ifdef ASCENT_USE_OPENMP
-#pragma omp parallel for
-#endif
-    for(int i = 0; i < num_bins; ++i)
-    {
-      if(bins[2 * i + 1] == 0)
-      {
-        res_bins[i] = empty_bin_val;
-      }
-      else
-      {
-        res_bins[i] = bins[2 * i];
-      }
-    }
-  }
-  else if(reduction_op == "avg")
-  {
-#ifdef ASCENT_USE_OPENMP
-#pragma omp parallel for
-#endif
-    for(int i = 0; i < num_bins; ++i)
-    {
-      const double sumX = bins[2 * i];
-      const double n = bins[2 * i + 1];
-      if(n == 0)
-      {
-        res_bins[i] = empty_bin_val;
-      }
-      else
-      {
-        res_bins[i] = sumX / n;
-      }
-    }
-  }
-  else if(reduction_op == "rms")
-  {
-#ifdef ASCENT_USE_OPENMP
-#pragma omp parallel for
-#endif
-    for(int i = 0; i < num_bins; ++i)
-    {
-      const double sumX = bins[2 * i];
-      const double n = bins[2 * i + 1];
-      if(n == 0)
-      {
-        res_bins[i] = empty_bin_val;
-      }
-      else
-      {
-        res_bins[i] = std::sqrt(sumX / n);
-      }
-    }
-  }
-  else if(reduction_op == "var")
-  {
-#ifdef ASCENT_USE_OPENMP
-#pragma omp parallel for
-#endif
-    for(int i = 0; i < num_bins; ++i)
-    {
-      const double sumX2 = bins[3 * i];
-      const double sumX = bins[3 * i + 1];
-      const double n = bins[3 * i + 2];
-      if(n == 0)
-      {
-        res_bins[i] = empty_bin_val;
-      }
-      else
-      {
-        res_bins[i] = (sumX2 / n) - std::pow(sumX / n, 2);
-      }
-    }
-  }
-  else if(reduction_op == "std")
-  {
-#ifdef ASCENT_USE_OPENMP
-#pragma omp parallel for
-#endif
-    for(int i = 0; i < num_bins; ++i)
-    {
-      const double sumX2 = bins[3 * i];
-      const double sumX = bins[3 * i + 1];
-      const double n = bins[3 * i + 2];
-      if(n == 0)
-      {
-        res_bins[i] = empty_bin_val;
-      }
-      else
-      {
-        res_bins[i] = std::sqrt((sumX2 / n) - std::pow(sumX / n, 2));
-      }
-    }
-  }
+  bins.result(empty_bin_val, num_bins, res_bins);
   res["association"] = assoc_str;
-  delete[] bins;
-  return res;
 }
 
 void
 paint_binning(const conduit::Node &binning,
               conduit::Node &dataset,
-              const std::string field_name)
+              const std::string field_name,
+              const conduit::Node *dom_homes)
 {
   const conduit::Node &bin_axes = binning["attrs/bin_axes/value"];
+  // the fields painted below change the data set, so its metadata is
+  // not shared
+  const TopologyMetadata metadata(dataset);
+
+  // use the bin indexes kept by binning() when they are for this data set
+  if(dom_homes != nullptr &&
+     dom_homes->number_of_children() != dataset.number_of_children())
+  {
+    dom_homes = nullptr;
+  }
 
   // get assoc_str and topo_name
   std::vector<std::string> axis_names = bin_axes.child_names();
@@ -1757,8 +1362,7 @@ paint_binning(const conduit::Node &binning,
   }
   else
   {
-    const conduit::Node &topo_and_assoc =
-        global_topo_and_assoc(dataset, axis_names);
+    const conduit::Node topo_and_assoc = metadata.topo_and_assoc(axis_names);
     topo_name = topo_and_assoc["topo_name"].as_string();
     assoc_str = topo_and_assoc["assoc_str"].as_string();
   }
@@ -1769,8 +1373,29 @@ paint_binning(const conduit::Node &binning,
   {
     conduit::Node &dom = dataset.child(dom_index);
 
-    conduit::Node n_homes;
-    populate_homes(dom, bin_axes, topo_name, assoc_str, n_homes);
+    // painting is a gather from the bins when binning kept the bin of
+    // every value. They were binned on the same topology unless it had to
+    // be picked above, so check that they fit.
+    const conduit::Node *n_kept =
+      dom_homes != nullptr ? &dom_homes->child(dom_index) : nullptr;
+    if(n_kept != nullptr && !n_kept->has_path("error") &&
+       dom.has_path("topologies/" + topo_name))
+    {
+      const conduit::index_t expected =
+        assoc_str == "vertex" ? metadata.num_points(dom_index, topo_name)
+                              : metadata.num_cells(dom_index, topo_name);
+      if(n_kept->dtype().number_of_elements() != expected)
+      {
+        n_kept = nullptr;
+      }
+    }
+    conduit::Node local_homes;
+    if(n_kept == nullptr)
+    {
+      populate_homes(metadata, dom_index, bin_axes, topo_name, assoc_str,
+                     local_homes);
+    }
+    const conduit::Node &n_homes = n_kept != nullptr ? *n_kept : local_homes;
     if(n_homes.has_path("error"))
     {
       ASCENT_INFO("Binning: not painting domain "
@@ -1779,6 +1404,11 @@ paint_binning(const conduit::Node &binning,
                   << "' was not found.");
       continue;
     }
+    if(n_homes.dtype().is_empty())
+    {
+      // the domain wasn't binned
+      continue;
+    }
     const int *homes = n_homes.as_int_ptr();
     const int homes_size = n_homes.dtype().number_of_elements();
 
@@ -1799,16 +1429,22 @@ paint_binning(const conduit::Node &binning,
 
     dom["fields/" + fname + "/association"] = assoc_str;
     dom["fields/" + fname + "/topology"] = topo_name;
-    dom["fields/" + fname + "/values"].set(
-        conduit::DataType::float64(homes_size));
-    conduit::float64_array values =
-        dom["fields/" + field_name + "/values"].value();
+    conduit::Node &n_values = dom["fields/" + fname + "/values"];
+    // reuse the values of an earlier painting when they fit
+    if(!n_values.dtype().is_float64() ||
+       !n_values.dtype().is_compact() ||
+       n_values.dtype().number_of_elements() != homes_size)
+    {
+      n_values.set(conduit::DataType::float64(homes_size));
+    }
+    double *values = n_values.as_float64_ptr();
 #ifdef ASCENT_USE_OPENMP
 #pragma omp parallel for
 #endif
     for(int i = 0; i < homes_size; ++i)
     {
-      values[i] = bins[homes[i]];
+      // values outside of the bins have no bin to take a value from
+      values[i] = homes[i] == -1 ? 0. : bins[homes[i]];
     }
   }
 
@@ -2032,6 +1668,139 @@ quantile(const conduit::Node &cdf,
   return res;
 }
 
+conduit::Node
+field_quantile(const conduit::Node &dataset,
+               const std::string &field,
+               const double q,
+               const double error)
+{
+  std::vector<ArrayView> arrays;
+  long long int count = 0;
+  for(int i = 0; i < dataset.number_of_children(); ++i)
+  {
+    const conduit::Node &dom = dataset.child(i);
+    if(dom.has_path("fields/" + field))
+    {
+      const conduit::Node &n_values = dom["fields/" + field + "/values"];
+      arrays.emplace_back();
+      arrays.back().set(n_values.number_of_children() == 1 ? n_values.child(0)
+                                                           : n_values);
+      count += arrays.back().size();
+    }
+  }
+
+#ifdef ASCENT_MPI_ENABLED
+  MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
+  int rank, procs;
+  MPI_Comm_rank(mpi_comm, &rank);
+  MPI_Comm_size(mpi_comm, &procs);
+  long long int global_count;
+  MPI_Allreduce(&count, &global_count, 1, MPI_LONG_LONG_INT, MPI_SUM, mpi_comm);
+  count = global_count;
+#endif
+
+  // every sketch is sized for the global count so the error bound
+  // holds for the merge of all of them
+  const conduit::int64 capacity = QuantileSketch::capacity(error, count);
+
+  // one sketch per thread, merged in thread order
+  int num_threads = 1;
+#ifdef ASCENT_USE_OPENMP
+  num_threads = omp_get_max_threads();
+#endif
+  std::vector<QuantileSketch> sketches(num_threads, QuantileSketch(capacity));
+
+#ifdef ASCENT_USE_OPENMP
+#pragma omp parallel
+#endif
+  {
+    int thread = 0;
+#ifdef ASCENT_USE_OPENMP
+    thread = omp_get_thread_num();
+#endif
+    QuantileSketch &sketch = sketches[thread];
+    for(const ArrayView &values : arrays)
+    {
+      const conduit::index_t size = values.size();
+#ifdef ASCENT_USE_OPENMP
+#pragma omp for schedule(static)
+#endif
+      for(conduit::index_t v = 0; v < size; ++v)
+      {
+        const double value = values.value(v);
+        if(!std::isnan(value))
+        {
+          sketch.insert(value);
+        }
+      }
+    }
+  }
+
+  QuantileSketch local(capacity);
+  for(const QuantileSketch &sketch : sketches)
+  {
+    local.merge(sketch);
+  }
+
+  conduit::Node res;
+#ifdef ASCENT_MPI_ENABLED
+  // gather the sketches on rank 0 and send back the answer
+  std::vector<double> buffer;
+  local.pack(buffer);
+  int buffer_size = buffer.size();
+  std::vector<int> buffer_sizes(procs);
+  MPI_Gather(&buffer_size, 1, MPI_INT,
+             buffer_sizes.data(), 1, MPI_INT, 0, mpi_comm);
+
+  std::vector<int> offsets(procs, 0);
+  std::vector<double> buffers;
+  if(rank == 0)
+  {
+    for(int i = 1; i < procs; ++i)
+    {
+      offsets[i] = offsets[i - 1] + buffer_sizes[i - 1];
+    }
+    buffers.resize(offsets[procs - 1] + buffer_sizes[procs - 1]);
+  }
+  MPI_Gatherv(buffer.data(), buffer_size, MPI_DOUBLE,
+              buffers.data(), buffer_sizes.data(), offsets.data(), MPI_DOUBLE,
+              0, mpi_comm);
+
+  double answer[3] = {0., 0., 0.};
+  if(rank == 0)
+  {
+    QuantileSketch global(capacity);
+    for(int i = 0; i < procs; ++i)
+    {
+      global.unpack(buffers.data() + offsets[i]);
+    }
+    if(global.count() > 0)
+    {
+      answer[0] = global.quantile(q);
+      answer[1] = global.rank_error() / global.count();
+    }
+    answer[2] = global.count();
+  }
+  MPI_Bcast(answer, 3, MPI_DOUBLE, 0, mpi_comm);
+  if(answer[2] == 0.)
+  {
+    ASCENT_ERROR("Quantile: field '" << field << "' has no values");
+  }
+  res["value"] = answer[0];
+  res["error"] = answer[1];
+  res["count"] = conduit::int64(answer[2]);
+#else
+  if(local.count() == 0)
+  {
+    ASCENT_ERROR("Quantile: field '" << field << "' has no values");
+  }
+  res["value"] = local.quantile(q);
+  res["error"] = local.rank_error() / local.count();
+  res["count"] = local.count();
+#endif
+  return res;
+}
+
 conduit::Node
 field_nan_count(const conduit::Node &dataset, const std::string &field)
 {
@@ -2114,14 +1883,16 @@ field_min(const conduit::Node &dataset, const std::string &field)
   if(domain != -1)
   {
     assoc_str = dataset.child(domain)["fields/" + field + "/association"].as_string();
+    const std::string topo_name =
+        dataset.child(domain)["fields/" + field + "/topology"].as_string();
 
     if(assoc_str == "vertex")
     {
-      loc = vert_location(dataset.child(domain), index);
+      loc = vert_location(dataset.child(domain), index, topo_name);
     }
     else if(assoc_str == "element")
     {
-      loc = element_location(dataset.child(domain), index);
+      loc = element_location(dataset.child(domain), index, topo_name);
     }
     else
     {
@@ -2264,14 +2035,16 @@ field_max(const conduit::Node &dataset, const std::string &field)
   {
     const std::string assoc_str =
         dataset.child(domain)["fields/" + field + "/association"].as_string();
+    const std::string topo_name =
+        dataset.child(domain)["fields/" + field + "/topology"].as_string();
 
     if(assoc_str == "vertex")
     {
-      loc = vert_location(dataset.child(domain), index);
+      loc = vert_location(dataset.child(domain), index, topo_name);
     }
     else if(assoc_str == "element")
     {
-      loc = element_location(dataset.child(domain), index);
+      loc = element_location(dataset.child(domain), index, topo_name);
     }
     else
     {
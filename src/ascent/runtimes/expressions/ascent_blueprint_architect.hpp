@@ -111,19 +111,30 @@ conduit::Node field_entropy(const conduit::Node &hist);
 conduit::Node field_pdf(const conduit::Node &hist);
 conduit::Node field_cdf(const conduit::Node &hist);
 
-conduit::Node global_bounds(const conduit::Node &dataset,
-                            const std::string &topo_name);
-
-conduit::Node binning(const conduit::Node &dataset,
-                      conduit::Node &bin_axes,
-                      const std::string &reduction_var,
-                      const std::string &reduction_op,
-                      const double empty_bin_val,
-                      const std::string &component);
-
+class TopologyMetadata;
+
+// writes the bins to res/value and their association to res/association
+// so callers can bin straight into their output. If dom_homes is given, it
+// gets a child per domain with the bin of each of its values (-1 outside
+// of the bins) that can be passed to paint_binning. storage is one of
+// "auto", "dense", or "sparse". "auto" keeps only the occupied bins when
+// there are far more bins than values.
+void ASCENT_API binning(const TopologyMetadata &metadata,
+                        conduit::Node &bin_axes,
+                        const std::string &reduction_var,
+                        const std::string &reduction_op,
+                        const double empty_bin_val,
+                        const std::string &component,
+                        conduit::Node &res,
+                        conduit::Node *dom_homes = nullptr,
+                        const std::string &storage = "auto");
+
+// dom_homes from binning() over the same data set skip recomputing the bin
+// of every value
 void ASCENT_API paint_binning(const conduit::Node &binning,
                               conduit::Node &dataset,
-                              const std::string field_name = "");
+                              const std::string field_name = "",
+                              const conduit::Node *dom_homes = nullptr);
 
 void ASCENT_API binning_mesh(const conduit::Node &binning,
                              conduit::Node &mesh,
@@ -158,6 +169,13 @@ conduit::Node quantile(const conduit::Node &cdf,
                        const double val,
                        const std::string &interpolation);
 
+// q-th quantile of a field from mergeable sketches, with a rank error
+// of at most error * (number of values). A zero error is exact.
+conduit::Node field_quantile(const conduit::Node &dataset,
+                             const std::string &field,
+                             const double q,
+                             const double error);
+
 // if the field node is empty, we will allocate space
 void paint_nestsets(const std::string nestset_name,
                     const std::string topo_name,
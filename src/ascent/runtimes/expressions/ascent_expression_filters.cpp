@@ -62,9 +62,12 @@
 //-----------------------------------------------------------------------------
 #include "ascent_blueprint_architect.hpp"
 #include "ascent_conduit_reductions.hpp"
+#include "ascent_point_locator.hpp"
+#include "ascent_topology_metadata.hpp"
 #include <ascent_config.h>
 #include <ascent_logging.hpp>
 #include <ascent_data_object.hpp>
+#include <ascent_expression_eval.hpp>
 #include <utils/ascent_mpi_utils.hpp>
 #include <flow_graph.hpp>
 #include <flow_timer.hpp>
@@ -294,6 +297,172 @@ logic_op(const bool lhs, const bool rhs, const std::string &op)
   return res;
 }
 
+// (x,y,z) of a vector or of every vector in a list. Returns true for a list.
+bool
+vector_list(const conduit::Node &n_vectors,
+            const std::string &filter_name,
+            std::vector<double> &res)
+{
+  res.clear();
+  // list items have types, lists don't
+  if(n_vectors.has_child("type"))
+  {
+    const double *p = n_vectors["value"].as_float64_ptr();
+    res.insert(res.end(), p, p + 3);
+    return false;
+  }
+  for(int i = 0; i < n_vectors.number_of_children(); ++i)
+  {
+    const conduit::Node &item = n_vectors.child(i);
+    if(item["type"].as_string() != "vector")
+    {
+      ASCENT_ERROR(filter_name << ": list item is not a vector");
+    }
+    const double *p = item["value"].as_float64_ptr();
+    res.insert(res.end(), p, p + 3);
+  }
+  return true;
+}
+
+// the scalar fields to sample: the fields in the list, or every scalar
+// field when the list is empty. Checked over all ranks in one exchange.
+std::vector<std::string>
+sample_fields(const conduit::Node &dataset,
+              const conduit::Node &n_fields,
+              const std::string &filter_name)
+{
+  std::vector<std::string> fields;
+  const int num_fields = n_fields.number_of_children();
+  const int num_domains = dataset.number_of_children();
+  if(num_fields == 0)
+  {
+    std::set<std::string> field_names;
+    for(int d = 0; d < num_domains; ++d)
+    {
+      const conduit::Node &dom = dataset.child(d);
+      if(!dom.has_path("fields"))
+      {
+        continue;
+      }
+      for(int f = 0; f < dom["fields"].number_of_children(); ++f)
+      {
+        const conduit::Node &n_field = dom["fields"].child(f);
+        if(n_field["values"].number_of_children() <= 1)
+        {
+          field_names.insert(n_field.name());
+        }
+      }
+    }
+    gather_strings(field_names);
+    fields.assign(field_names.begin(), field_names.end());
+    return fields;
+  }
+
+  for(int i = 0; i < num_fields; ++i)
+  {
+    const conduit::Node &n_field = n_fields.child(i);
+    if(n_field["type"].as_string() != "string")
+    {
+      ASCENT_ERROR(filter_name << ": field list item is not a string");
+    }
+    fields.push_back(n_field["value"].as_string());
+  }
+
+  // 1 if a rank has the field, 2 if it isn't scalar
+  std::vector<int> flags(num_fields, 0);
+  for(int f = 0; f < num_fields; ++f)
+  {
+    for(int d = 0; d < num_domains; ++d)
+    {
+      const conduit::Node &dom = dataset.child(d);
+      if(dom.has_path("fields/" + fields[f]))
+      {
+        flags[f] |= 1;
+        if(dom["fields/" + fields[f] + "/values"].number_of_children() > 1)
+        {
+          flags[f] |= 2;
+        }
+      }
+    }
+  }
+#ifdef ASCENT_MPI_ENABLED
+  MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
+  MPI_Allreduce(MPI_IN_PLACE, flags.data(), num_fields, MPI_INT, MPI_BOR,
+                mpi_comm);
+#endif
+  for(int f = 0; f < num_fields; ++f)
+  {
+    if((flags[f] & 1) == 0)
+    {
+      ASCENT_ERROR(filter_name << ": unknown field '" << fields[f] << "'");
+    }
+    if((flags[f] & 2) != 0)
+    {
+      ASCENT_ERROR(filter_name << ": field '" << fields[f]
+                               << "' is not a scalar field");
+    }
+  }
+  return fields;
+}
+
+// the sample coordinates and the values of every field
+void
+sample_output(const std::vector<double> &points,
+              const std::vector<std::string> &fields,
+              const conduit::Node &values,
+              const double empty_val,
+              conduit::Node &output)
+{
+  output["attrs/empty_value/value"] = empty_val;
+  output["attrs/empty_value/type"] = "double";
+  const int size = static_cast<int>(points.size() / 3);
+  const std::string axes[3] = {"x", "y", "z"};
+  for(int a = 0; a < 3; ++a)
+  {
+    conduit::Node &n_coords = output["attrs/coordinates/" + axes[a]];
+    n_coords["value"].set(conduit::DataType::float64(size));
+    n_coords["type"] = "array";
+    float64_array coords = n_coords["value"].value();
+    for(int i = 0; i < size; ++i)
+    {
+      coords[i] = points[static_cast<size_t>(i) * 3 + a];
+    }
+  }
+  for(const std::string &field : fields)
+  {
+    output["attrs/vars/" + field + "/value"] = values[field];
+    output["attrs/vars/" + field + "/type"] = "array";
+  }
+}
+
+// windowed statistic over the cached history of the expression that
+// n_expr (an identifier) refers to
+conduit::Node *
+history_window(::flow::Registry &registry,
+               const conduit::Node &n_expr,
+               const std::string &op,
+               const double param)
+{
+  if(!n_expr.has_path("name"))
+  {
+    ASCENT_ERROR(op << ": the first argument must be the name of an "
+                    "expression evaluated in the past");
+  }
+  const std::string expr_name = n_expr["name"].as_string();
+
+  Cache *cache = registry.fetch<Cache>("cache");
+  double value = 0.;
+  if(!cache->window_value(expr_name, op, param, value))
+  {
+    ASCENT_ERROR(op << ": unknown identifier " << expr_name);
+  }
+
+  conduit::Node *output = new conduit::Node();
+  (*output)["value"] = value;
+  (*output)["type"] = "double";
+  return output;
+}
+
 } // namespace detail
 
 //-----------------------------------------------------------------------------
@@ -376,20 +545,12 @@ Identifier::execute()
   conduit::Node *output = new conduit::Node();
   std::string i_name = params()["value"].as_string();
 
-  const conduit::Node *const cache =
-      graph().workspace().registry().fetch<Node>("cache");
-  if(!cache->has_path(i_name))
+  Cache *cache = graph().workspace().registry().fetch<Cache>("cache");
+  // grab the last one calculated so we have type info
+  if(!cache->last_entry(i_name, *output))
   {
     ASCENT_ERROR("Unknown expression identifier: '" << i_name << "'");
   }
-
-  const int entries = (*cache)[i_name].number_of_children();
-  if(entries < 1)
-  {
-    ASCENT_ERROR("Expression identifier: needs at least one entry");
-  }
-  // grab the last one calculated so we have type info
-  (*output) = (*cache)[i_name].child(entries - 1);
   // we need to keep the name to retrieve the chache
   // if history is called.
   (*output)["name"] = i_name;
@@ -1454,14 +1615,7 @@ History::execute()
 
   const std::string expr_name  = (*input<Node>("expr_name"))["name"].as_string();
 
-  const conduit::Node *const cache =
-      graph().workspace().registry().fetch<Node>("cache");
-
-  if(!cache->has_path(expr_name))
-  {
-    ASCENT_ERROR("History: unknown identifier "<<  expr_name);
-  }
-  const conduit::Node &history = (*cache)[expr_name];
+  Cache *cache = graph().workspace().registry().fetch<Cache>("cache");
 
   const conduit::Node *n_absolute_index = input<Node>("absolute_index");
   const conduit::Node *n_relative_index = input<Node>("relative_index");
@@ -1475,21 +1629,21 @@ History::execute()
   }
 
 
-  const int entries = history.number_of_children();
+  // only the requested entry is copied out of the cache, other
+  // expressions may be adding to it
+  int entries = 0;
   if(!n_relative_index->dtype().is_empty())
   {
     int relative_index = (*n_relative_index)["value"].to_int32();
-    if(relative_index >= entries)
-    {
-      // clamp to first if its gone too far
-      relative_index = 0;
-    }
     if(relative_index < 0)
     {
       ASCENT_ERROR("History: relative_index must be a non-negative integer.");
     }
     // grab the value from relative_index cycles ago
-    (*output) = history.child(entries - relative_index - 1);
+    if(!cache->history_entry(expr_name, relative_index, true, *output, entries))
+    {
+      ASCENT_ERROR("History: unknown identifier "<<  expr_name);
+    }
   }
   else
   {
@@ -1501,24 +1655,229 @@ History::execute()
           "History: internal error. absolute index does not have child value");
     }
     absolute_index = (*n_absolute_index)["value"].to_int32();
+    if(absolute_index < 0)
+    {
+      ASCENT_ERROR("History: absolute_index must be a non-negative integer.");
+    }
 
+    if(!cache->history_entry(expr_name, absolute_index, false, *output, entries))
+    {
+      ASCENT_ERROR("History: unknown identifier "<<  expr_name);
+    }
     if(absolute_index >= entries)
     {
       ASCENT_ERROR("History: found only " << entries
                                           << " entries, cannot get entry at "
                                           << absolute_index);
     }
-    if(absolute_index < 0)
-    {
-      ASCENT_ERROR("History: absolute_index must be a non-negative integer.");
-    }
-
-    (*output) = history.child(absolute_index);
   }
 
   set_output<conduit::Node>(output);
 }
 
+//-----------------------------------------------------------------------------
+RollingAvg::RollingAvg() : Filter()
+{
+  // empty
+}
+
+//-----------------------------------------------------------------------------
+RollingAvg::~RollingAvg()
+{
+  // empty
+}
+
+//-----------------------------------------------------------------------------
+void
+RollingAvg::declare_interface(Node &i)
+{
+  i["type_name"] = "rolling_avg";
+  i["port_names"].append() = "expr_name";
+  i["port_names"].append() = "window";
+  i["output_port"] = "true";
+}
+
+//-----------------------------------------------------------------------------
+bool
+RollingAvg::verify_params(const conduit::Node &params, conduit::Node &info)
+{
+  info.reset();
+  bool res = true;
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+void
+RollingAvg::execute()
+{
+  const double window = (*input<Node>("window"))["value"].to_float64();
+  set_output<conduit::Node>(detail::history_window(
+      graph().workspace().registry(), *input<Node>("expr_name"),
+      "rolling_avg", window));
+}
+
+//-----------------------------------------------------------------------------
+RollingMax::RollingMax() : Filter()
+{
+  // empty
+}
+
+//-----------------------------------------------------------------------------
+RollingMax::~RollingMax()
+{
+  // empty
+}
+
+//-----------------------------------------------------------------------------
+void
+RollingMax::declare_interface(Node &i)
+{
+  i["type_name"] = "rolling_max";
+  i["port_names"].append() = "expr_name";
+  i["port_names"].append() = "window";
+  i["output_port"] = "true";
+}
+
+//-----------------------------------------------------------------------------
+bool
+RollingMax::verify_params(const conduit::Node &params, conduit::Node &info)
+{
+  info.reset();
+  bool res = true;
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+void
+RollingMax::execute()
+{
+  const double window = (*input<Node>("window"))["value"].to_float64();
+  set_output<conduit::Node>(detail::history_window(
+      graph().workspace().registry(), *input<Node>("expr_name"),
+      "rolling_max", window));
+}
+
+//-----------------------------------------------------------------------------
+RollingMin::RollingMin() : Filter()
+{
+  // empty
+}
+
+//-----------------------------------------------------------------------------
+RollingMin::~RollingMin()
+{
+  // empty
+}
+
+//-----------------------------------------------------------------------------
+void
+RollingMin::declare_interface(Node &i)
+{
+  i["type_name"] = "rolling_min";
+  i["port_names"].append() = "expr_name";
+  i["port_names"].append() = "window";
+  i["output_port"] = "true";
+}
+
+//-----------------------------------------------------------------------------
+bool
+RollingMin::verify_params(const conduit::Node &params, conduit::Node &info)
+{
+  info.reset();
+  bool res = true;
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+void
+RollingMin::execute()
+{
+  const double window = (*input<Node>("window"))["value"].to_float64();
+  set_output<conduit::Node>(detail::history_window(
+      graph().workspace().registry(), *input<Node>("expr_name"),
+      "rolling_min", window));
+}
+
+//-----------------------------------------------------------------------------
+Ema::Ema() : Filter()
+{
+  // empty
+}
+
+//-----------------------------------------------------------------------------
+Ema::~Ema()
+{
+  // empty
+}
+
+//-----------------------------------------------------------------------------
+void
+Ema::declare_interface(Node &i)
+{
+  i["type_name"] = "ema";
+  i["port_names"].append() = "expr_name";
+  i["port_names"].append() = "alpha";
+  i["output_port"] = "true";
+}
+
+//-----------------------------------------------------------------------------
+bool
+Ema::verify_params(const conduit::Node &params, conduit::Node &info)
+{
+  info.reset();
+  bool res = true;
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+void
+Ema::execute()
+{
+  const double alpha = (*input<Node>("alpha"))["value"].to_float64();
+  set_output<conduit::Node>(detail::history_window(
+      graph().workspace().registry(), *input<Node>("expr_name"),
+      "ema", alpha));
+}
+
+//-----------------------------------------------------------------------------
+Derivative::Derivative() : Filter()
+{
+  // empty
+}
+
+//-----------------------------------------------------------------------------
+Derivative::~Derivative()
+{
+  // empty
+}
+
+//-----------------------------------------------------------------------------
+void
+Derivative::declare_interface(Node &i)
+{
+  i["type_name"] = "derivative";
+  i["port_names"].append() = "expr_name";
+  i["output_port"] = "true";
+}
+
+//-----------------------------------------------------------------------------
+bool
+Derivative::verify_params(const conduit::Node &params, conduit::Node &info)
+{
+  info.reset();
+  bool res = true;
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+void
+Derivative::execute()
+{
+  set_output<conduit::Node>(detail::history_window(
+      graph().workspace().registry(), *input<Node>("expr_name"),
+      "derivative", 0.));
+}
+
 //-----------------------------------------------------------------------------
 Vector::Vector() : Filter()
 {
@@ -2203,10 +2562,12 @@ void binning_interface(const std::string &reduction_var,
                        const conduit::Node &n_empty_bin_val,
                        const conduit::Node &n_component,
                        const conduit::Node &n_axis_list,
-                       conduit::Node &dataset,
+                       const TopologyMetadata &metadata,
                        conduit::Node &n_binning,
-                       conduit::Node &n_output_axes)
+                       conduit::Node &n_output_axes,
+                       conduit::Node *n_homes)
 {
+  const conduit::Node &dataset = metadata.dataset();
   std::string component = "";
   if(!n_component.dtype().is_empty())
   {
@@ -2305,12 +2666,14 @@ void binning_interface(const std::string &reduction_var,
     empty_bin_val = n_empty_bin_val["value"].to_float64();
   }
 
-  n_binning = binning(dataset,
-                      n_output_axes,
-                      reduction_var,
-                      reduction_op,
-                      empty_bin_val,
-                      component);
+  binning(metadata,
+          n_output_axes,
+          reduction_var,
+          reduction_op,
+          empty_bin_val,
+          component,
+          n_binning,
+          n_homes);
 
 }
 //-----------------------------------------------------------------------------
@@ -2320,7 +2683,8 @@ Binning::execute()
   DataObject *data_object =
     graph().workspace().registry().fetch<DataObject>("dataset");
 
-  conduit::Node *dataset = data_object->as_low_order_bp().get();
+  std::shared_ptr<TopologyMetadata> metadata =
+    data_object->topology_metadata();
 
   const std::string reduction_var =
       (*input<Node>("reduction_var"))["value"].as_string();
@@ -2331,30 +2695,30 @@ Binning::execute()
   const conduit::Node *n_empty_bin_val = input<conduit::Node>("empty_bin_val");
   const conduit::Node *n_component = input<conduit::Node>("component");
 
-  conduit::Node n_binning;
-  conduit::Node n_bin_axes;
+  conduit::Node *output = new conduit::Node();
+  (*output)["type"] = "binning";
+  // bin straight into the output instead of copying the bins over
+  conduit::Node &n_binning = (*output)["attrs/value"];
 
   binning_interface(reduction_var,
                     reduction_op,
                     *n_empty_bin_val,
                     *n_component,
                     *n_axes_list,
-                    *dataset,
+                    *metadata,
                     n_binning,
-                    n_bin_axes);
+                    (*output)["attrs/bin_axes/value"]);
 
+  const std::string association = n_binning["association"].as_string();
+  n_binning.remove("association");
 
-  conduit::Node *output = new conduit::Node();
-  (*output)["type"] = "binning";
-  (*output)["attrs/value/value"] = n_binning["value"];
   (*output)["attrs/value/type"] = "array";
   (*output)["attrs/reduction_var/value"] = reduction_var;
   (*output)["attrs/reduction_var/type"] = "string";
   (*output)["attrs/reduction_op/value"] = reduction_op;
   (*output)["attrs/reduction_op/type"] = "string";
-  (*output)["attrs/bin_axes/value"] = n_bin_axes;
   //(*output)["attrs/bin_axes/type"] = "list";
-  (*output)["attrs/association/value"] = n_binning["association"];
+  (*output)["attrs/association/value"] = association;
   (*output)["attrs/association/type"] = "string";
   set_output<conduit::Node>(output);
 
@@ -2567,6 +2931,99 @@ Quantile::execute()
   set_output<conduit::Node>(output);
 }
 
+//-----------------------------------------------------------------------------
+FieldQuantile::FieldQuantile() : Filter()
+{
+  // empty
+}
+
+//-----------------------------------------------------------------------------
+FieldQuantile::~FieldQuantile()
+{
+  // empty
+}
+
+//-----------------------------------------------------------------------------
+void
+FieldQuantile::declare_interface(Node &i)
+{
+  i["type_name"] = "field_quantile";
+  i["port_names"].append() = "arg1";
+  i["port_names"].append() = "q";
+  i["port_names"].append() = "method";
+  i["port_names"].append() = "error";
+  i["output_port"] = "true";
+}
+
+//-----------------------------------------------------------------------------
+bool
+FieldQuantile::verify_params(const conduit::Node &params, conduit::Node &info)
+{
+  info.reset();
+  bool res = true;
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+void
+FieldQuantile::execute()
+{
+  const std::string field = (*input<Node>("arg1"))["value"].as_string();
+  const double val = (*input<Node>("q"))["value"].to_float64();
+  // optional inputs
+  const conduit::Node *n_method = input<Node>("method");
+  const conduit::Node *n_error = input<Node>("error");
+
+  if(val < 0 || val > 1)
+  {
+    ASCENT_ERROR("Quantile: val must be between 0 and 1");
+  }
+
+  std::string method = "sketch";
+  if(!n_method->dtype().is_empty())
+  {
+    method = (*n_method)["value"].as_string();
+    if(method != "sketch" && method != "exact")
+    {
+      ASCENT_ERROR("Quantile: known methods are: sketch, exact");
+    }
+  }
+
+  double error = 0.001;
+  if(!n_error->dtype().is_empty())
+  {
+    error = (*n_error)["value"].to_float64();
+    if(error <= 0 || error >= 1)
+    {
+      ASCENT_ERROR("Quantile: error must be between 0 and 1");
+    }
+  }
+  if(method == "exact")
+  {
+    error = 0.;
+  }
+
+  DataObject *data_object =
+    graph().workspace().registry().fetch<DataObject>("dataset");
+  const conduit::Node *const dataset = data_object->as_low_order_bp().get();
+
+  if(!is_scalar_field(*dataset, field))
+  {
+    ASCENT_ERROR("Quantile: field '" << field << "' is not a scalar field");
+  }
+
+  const conduit::Node n_quantile = field_quantile(*dataset, field, val, error);
+  conduit::Node *output = new conduit::Node();
+  (*output)["value"] = n_quantile["value"];
+  (*output)["type"] = "double";
+  // rank error bound of the answer as a fraction of the number of values
+  (*output)["attrs/error/value"] = n_quantile["error"];
+  (*output)["attrs/error/type"] = "double";
+  (*output)["attrs/count/value"] = n_quantile["count"];
+  (*output)["attrs/count/type"] = "int";
+  set_output<conduit::Node>(output);
+}
+
 //-----------------------------------------------------------------------------
 BinByIndex::BinByIndex() : Filter()
 {
@@ -3223,11 +3680,6 @@ Lineout::verify_params(const conduit::Node &params, conduit::Node &info)
 void
 Lineout::execute()
 {
-
-#if not defined(ASCENT_DRAY_ENABLED)
-  ASCENT_ERROR("Lineout only supported when Devil Ray is built");
-#else
-
   conduit::Node &n_samples = *input<Node>("samples");
   int32 samples = n_samples["value"].to_int32();;
   if(samples < 1)
@@ -3235,44 +3687,50 @@ Lineout::execute()
     ASCENT_ERROR("Lineout: samples must be greater than zero: '"<<samples<<"'\n");
   }
 
-  conduit::Node &n_start = *input<Node>("start");
-  double *p_start = n_start["value"].as_float64_ptr();
-
-  dray::Vec<dray::Float,3> start;
-  start[0] = static_cast<dray::Float>(p_start[0]);
-  start[1] = static_cast<dray::Float>(p_start[1]);
-  start[2] = static_cast<dray::Float>(p_start[2]);
-
-  conduit::Node &n_end= *input<Node>("end");
-  double *p_end = n_end["value"].as_float64_ptr();
+  // one line or a list of lines
+  std::vector<double> starts, ends;
+  detail::vector_list(*input<Node>("start"), "Lineout", starts);
+  detail::vector_list(*input<Node>("end"), "Lineout", ends);
+  if(starts.size() != ends.size())
+  {
+    ASCENT_ERROR("Lineout: got " << starts.size() / 3 << " start points and "
+                 << ends.size() / 3 << " end points");
+  }
+  const int num_lines = static_cast<int>(starts.size() / 3);
 
-  dray::Vec<dray::Float,3> end;
-  end[0] = static_cast<dray::Float>(p_end[0]);
-  end[1] = static_cast<dray::Float>(p_end[1]);
-  end[2] = static_cast<dray::Float>(p_end[2]);
+  double empty_val = 0.;
+  conduit::Node &n_empty_val = *input<Node>("empty_val");
+  if(!n_empty_val.dtype().is_empty())
+  {
+    empty_val = n_empty_val["value"].to_float64();
+  }
 
-  conduit::Node *output = new conduit::Node();
+  const conduit::Node &n_fields = *input<Node>("fields");
 
   DataObject *data_object =
     graph().workspace().registry().fetch<DataObject>("dataset");
-  dray::Collection * collection = data_object->as_dray_collection().get();
-
-  dray::Lineout lineout;
 
-  lineout.samples(samples);
-
-  conduit::Node &n_empty_val = *input<Node>("empty_val");
-  if(!n_empty_val.dtype().is_empty())
+  std::vector<double> points;
+  std::vector<std::string> fields;
+  conduit::Node values;
+  if(data_object->source() == DataObject::Source::HIGH_BP ||
+     data_object->source() == DataObject::Source::DRAY)
   {
-    double empty_val = n_empty_val["value"].to_float64();
-    lineout.empty_val(empty_val);
-  }
+    // high order elements are sampled by Devil Ray
+#if not defined(ASCENT_DRAY_ENABLED)
+    ASCENT_ERROR("Lineout: high order data is only supported when Devil Ray "
+                 "is built");
+#else
+    dray::Collection * collection = data_object->as_dray_collection().get();
 
-  // figure out the number of fields we will use
-  conduit::Node &n_fields = *input<Node>("fields");
-  const int num_fields = n_fields.number_of_children();
-  if(num_fields > 0)
-  {
+    dray::Lineout lineout;
+    lineout.samples(samples);
+    if(!n_empty_val.dtype().is_empty())
+    {
+      lineout.empty_val(empty_val);
+    }
+
+    const int num_fields = n_fields.number_of_children();
     for(int i = 0; i < num_fields; ++i)
     {
       const conduit::Node &n_field = n_fields.child(i);
@@ -3280,71 +3738,318 @@ Lineout::execute()
       {
         ASCENT_ERROR("Lineout: field list item is not a string");
       }
+      fields.push_back(n_field["value"].as_string());
+    }
+    if(num_fields == 0)
+    {
+      std::set<std::string> field_names;
+      // use all fields
+      for(int i = 0; i < collection->size(); ++i)
+      {
+        dray::DataSet dset = collection->domain(i);
+        std::vector<std::string> d_names = dset.fields();
+        for(int n = 0; n < d_names.size(); ++n)
+        {
+          field_names.insert(d_names[n]);
+        }
+      }
+      gather_strings(field_names);
+      fields.assign(field_names.begin(), field_names.end());
+    }
+    for(const std::string &field : fields)
+    {
+      lineout.add_var(field);
+    }
 
-      lineout.add_var(n_field["value"].as_string());
+    for(int l = 0; l < num_lines; ++l)
+    {
+      dray::Vec<dray::Float,3> start, end;
+      for(int a = 0; a < 3; ++a)
+      {
+        start[a] = static_cast<dray::Float>(starts[l * 3 + a]);
+        end[a] = static_cast<dray::Float>(ends[l * 3 + a]);
+      }
+      lineout.add_line(start, end);
     }
+
+    dray::Lineout::Result res = lineout.execute(*collection);
+    empty_val = double(res.m_empty_val);
+    const int size = res.m_points.size();
+    points.resize(size * 3);
+    for(int i = 0; i < size; ++i)
+    {
+      dray::Vec<dray::Float,3> p = res.m_points.get_value(i);
+      for(int a = 0; a < 3; ++a)
+      {
+        points[i * 3 + a] = static_cast<double>(p[a]);
+      }
+    }
+    fields = res.m_vars;
+    for(size_t v = 0; v < res.m_vars.size(); ++v)
+    {
+      values[res.m_vars[v]].set(conduit::DataType::float64(size));
+      float64_array var_array = values[res.m_vars[v]].value();
+      for(int i = 0; i < size; ++i)
+      {
+        var_array[i] = static_cast<double>(res.m_values[v].get_value(i));
+      }
+    }
+#endif
   }
   else
   {
-    std::set<std::string> field_names;
-    // use all fields
-    for(int i = 0; i < collection->size(); ++i)
+    // every sample of every line is located with the same index and
+    // all of the values are exchanged at once
+    points.resize(static_cast<size_t>(num_lines) * samples * 3);
+    for(int l = 0; l < num_lines; ++l)
     {
-      dray::DataSet dset = collection->domain(i);
-      std::vector<std::string> d_names = dset.fields();
-      for(int n = 0; n < d_names.size(); ++n)
+      for(int i = 0; i < samples; ++i)
       {
-        field_names.insert(d_names[n]);
+        const double t = samples == 1 ? 0. : double(i) / double(samples - 1);
+        double *point = &points[(static_cast<size_t>(l) * samples + i) * 3];
+        for(int a = 0; a < 3; ++a)
+        {
+          point[a] = starts[l * 3 + a] + t * (ends[l * 3 + a] - starts[l * 3 + a]);
+        }
       }
     }
-    gather_strings(field_names);
+
+    std::shared_ptr<conduit::Node> bp_dset = data_object->as_low_order_bp();
+    fields = detail::sample_fields(*bp_dset, n_fields, "Lineout");
+    values = probe(bp_dset, fields, points, empty_val);
   }
 
+  conduit::Node *output = new conduit::Node();
+  (*output)["type"] = "lineout";
+  (*output)["attrs/samples/value"] = samples;
+  (*output)["attrs/samples/type"] = "int";
+  (*output)["attrs/lines/value"] = num_lines;
+  (*output)["attrs/lines/type"] = "int";
+  detail::sample_output(points, fields, values, empty_val, *output);
+  set_output<conduit::Node>(output);
+}
 
+//-----------------------------------------------------------------------------
+SamplePoints::SamplePoints() : Filter()
+{
+  // empty
+}
 
-  lineout.add_line(start, end);
+//-----------------------------------------------------------------------------
+SamplePoints::~SamplePoints()
+{
+  // empty
+}
 
-  dray::Lineout::Result res = lineout.execute(*collection);
-  (*output)["type"] = "lineout";
-  (*output)["attrs/empty_value/value"] = double(res.m_empty_val);
-  (*output)["attrs/empty_value/type"] = "double";
-  (*output)["attrs/samples/value"] = int(res.m_points_per_line);
-  (*output)["attrs/samples/type"] = "int";
-  // we only have one line so the size of points is the size of everything
-  const int size = res.m_points.size();
-  (*output)["attrs/coordinates/x/value"] = conduit::DataType::float64(size);
-  (*output)["attrs/coordinates/x/type"] = "array";
-  (*output)["attrs/coordinates/y/value"] = conduit::DataType::float64(size);
-  (*output)["attrs/coordinates/y/type"] = "array";
-  (*output)["attrs/coordinates/z/value"] = conduit::DataType::float64(size);
-  (*output)["attrs/coordinates/z/type"] = "array";
-  float64_array x = (*output)["attrs/coordinates/x/value"].value();
-  float64_array y = (*output)["attrs/coordinates/y/value"].value();
-  float64_array z = (*output)["attrs/coordinates/z/value"].value();
-  for(int i = 0; i < size; ++i)
-  {
-    dray::Vec<dray::Float,3> p = res.m_points.get_value(i);
-    x[i] = static_cast<double>(p[0]);
-    y[i] = static_cast<double>(p[1]);
-    z[i] = static_cast<double>(p[2]);
-  }
-
-  const int var_size = res.m_vars.size();
-  for(int v = 0; v < var_size; ++v)
-  {
-    std::string var = res.m_vars[v];
-    (*output)["attrs/vars/"+var+"/value"] = conduit::DataType::float64(size);
-    (*output)["attrs/vars/"+var+"/type"] = "array";
-    float64_array var_array = (*output)["attrs/vars/"+var+"/value"].value();
-    for(int i = 0; i < size; ++i)
-    {
-      var_array[i] = static_cast<double>(res.m_values[v].get_value(i));
-    }
+//-----------------------------------------------------------------------------
+void
+SamplePoints::declare_interface(Node &i)
+{
+  i["type_name"] = "sample_points";
+  i["port_names"].append() = "points";
+  i["port_names"].append() = "fields";
+  i["port_names"].append() = "empty_val";
+  i["output_port"] = "true";
+}
+
+//-----------------------------------------------------------------------------
+bool
+SamplePoints::verify_params(const conduit::Node &params, conduit::Node &info)
+{
+  info.reset();
+  bool res = true;
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+void
+SamplePoints::execute()
+{
+  std::vector<double> points;
+  detail::vector_list(*input<Node>("points"), "SamplePoints", points);
+
+  double empty_val = 0.;
+  const conduit::Node &n_empty_val = *input<Node>("empty_val");
+  if(!n_empty_val.dtype().is_empty())
+  {
+    empty_val = n_empty_val["value"].to_float64();
   }
 
+  DataObject *data_object =
+    graph().workspace().registry().fetch<DataObject>("dataset");
+  std::shared_ptr<conduit::Node> bp_dset = data_object->as_low_order_bp();
+
+  const std::vector<std::string> fields =
+    detail::sample_fields(*bp_dset, *input<Node>("fields"), "SamplePoints");
+  const conduit::Node values = probe(bp_dset, fields, points, empty_val);
+
+  conduit::Node *output = new conduit::Node();
+  (*output)["type"] = "sample_points";
+  detail::sample_output(points, fields, values, empty_val, *output);
   set_output<conduit::Node>(output);
-#endif
+}
+
+//-----------------------------------------------------------------------------
+Probe::Probe() : Filter()
+{
+  // empty
+}
+
+//-----------------------------------------------------------------------------
+Probe::~Probe()
+{
+  // empty
+}
+
+//-----------------------------------------------------------------------------
+void
+Probe::declare_interface(Node &i)
+{
+  i["type_name"] = "probe";
+  i["port_names"].append() = "arg1";
+  i["port_names"].append() = "points";
+  i["port_names"].append() = "empty_val";
+  i["output_port"] = "true";
+}
+
+//-----------------------------------------------------------------------------
+bool
+Probe::verify_params(const conduit::Node &params, conduit::Node &info)
+{
+  info.reset();
+  bool res = true;
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+void
+Probe::execute()
+{
+  const std::string field = (*input<Node>("arg1"))["value"].as_string();
+
+  DataObject *data_object =
+    graph().workspace().registry().fetch<DataObject>("dataset");
+  std::shared_ptr<conduit::Node> bp_dset = data_object->as_low_order_bp();
+  const conduit::Node &dataset = *bp_dset;
+
+  if(!is_scalar_field(dataset, field))
+  {
+    ASCENT_ERROR("Probe: field '" << field << "' is not a scalar field");
+  }
 
+  // a single point or a list of points
+  std::vector<double> points;
+  const bool is_list =
+    detail::vector_list(*input<Node>("points"), "Probe", points);
+
+  double empty_val = 0.;
+  const conduit::Node &n_empty_val = *input<Node>("empty_val");
+  if(!n_empty_val.dtype().is_empty())
+  {
+    empty_val = n_empty_val["value"].to_float64();
+  }
+
+  conduit::Node res = probe(bp_dset, {field}, points, empty_val);
+
+  conduit::Node *output = new conduit::Node();
+  if(is_list)
+  {
+    (*output)["value"] = res[field];
+    (*output)["type"] = "array";
+  }
+  else
+  {
+    (*output)["value"] = res[field].as_float64_ptr()[0];
+    (*output)["type"] = "double";
+  }
+  set_output<conduit::Node>(output);
+}
+
+//-----------------------------------------------------------------------------
+NearestVertex::NearestVertex() : Filter()
+{
+  // empty
+}
+
+//-----------------------------------------------------------------------------
+NearestVertex::~NearestVertex()
+{
+  // empty
+}
+
+//-----------------------------------------------------------------------------
+void
+NearestVertex::declare_interface(Node &i)
+{
+  i["type_name"] = "nearest_vertex";
+  i["port_names"].append() = "arg1";
+  i["port_names"].append() = "points";
+  i["output_port"] = "true";
+}
+
+//-----------------------------------------------------------------------------
+bool
+NearestVertex::verify_params(const conduit::Node &params, conduit::Node &info)
+{
+  info.reset();
+  bool res = true;
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+void
+NearestVertex::execute()
+{
+  const std::string field = (*input<Node>("arg1"))["value"].as_string();
+
+  DataObject *data_object =
+    graph().workspace().registry().fetch<DataObject>("dataset");
+  std::shared_ptr<conduit::Node> bp_dset = data_object->as_low_order_bp();
+
+  if(!is_scalar_field(*bp_dset, field))
+  {
+    ASCENT_ERROR("NearestVertex: field '" << field
+                 << "' is not a scalar field");
+  }
+  // agreed on by every rank before the exchange
+  const conduit::Node topo_and_assoc =
+    data_object->topology_metadata()->topo_and_assoc({field});
+  if(topo_and_assoc["assoc_str"].as_string() != "vertex")
+  {
+    ASCENT_ERROR("NearestVertex: field '" << field
+                 << "' is not associated with vertices");
+  }
+
+  // a single point or a list of points
+  std::vector<double> points;
+  const bool is_list =
+    detail::vector_list(*input<Node>("points"), "NearestVertex", points);
+
+  conduit::Node res = nearest_vertices(bp_dset, field, points);
+
+  conduit::Node *output = new conduit::Node();
+  if(is_list)
+  {
+    (*output)["value"] = res["value"];
+    (*output)["type"] = "array";
+  }
+  else
+  {
+    (*output)["type"] = "value_position";
+    (*output)["attrs/value/value"] = res["value"].as_float64_ptr()[0];
+    (*output)["attrs/value/type"] = "double";
+    (*output)["attrs/position/value"].set(res["position"].as_float64_ptr(), 3);
+    (*output)["attrs/position/type"] = "vector";
+    (*output)["attrs/distance/value"] = res["distance"].as_float64_ptr()[0];
+    (*output)["attrs/distance/type"] = "double";
+    // information about the vertex
+    (*output)["attrs/element/rank"] = res["rank"].as_int32_ptr()[0];
+    (*output)["attrs/element/domain_index"] =
+      res["domain_id"].as_int32_ptr()[0];
+    (*output)["attrs/element/index"] = res["index"].as_int32_ptr()[0];
+    (*output)["attrs/element/assoc"] = "vertex";
+  }
+  set_output<conduit::Node>(output);
 }
 
 //-----------------------------------------------------------------------------
@@ -3386,16 +4091,17 @@ Bounds::execute()
 
   DataObject *data_object =
     graph().workspace().registry().fetch<DataObject>("dataset");
-  const conduit::Node *const dataset = data_object->as_low_order_bp().get();
+  std::shared_ptr<TopologyMetadata> metadata =
+    data_object->topology_metadata();
 
   std::set<std::string> topos;
 
   if(!n_topology.dtype().is_empty())
   {
     std::string topo = n_topology["value"].as_string();
-    if(!has_topology(*dataset, topo))
+    if(!metadata->has_topology(topo))
     {
-      std::set<std::string> names = topology_names(*dataset);
+      std::set<std::string> names = metadata->topology_names();
       std::stringstream msg;
       msg<<"Unknown topology: '"<<topo<<"'. Known topologies: [";
       for(auto &name : names)
@@ -3409,7 +4115,7 @@ Bounds::execute()
   }
   else
   {
-    topos = topology_names(*dataset);
+    topos = metadata->topology_names();
   }
 
   double inf = std::numeric_limits<double>::infinity();
@@ -3417,7 +4123,7 @@ Bounds::execute()
   double max_vec[3] = {-inf, -inf, -inf};
   for(auto &topo_name : topos)
   {
-    conduit::Node n_aabb = global_bounds(*dataset, topo_name);
+    conduit::Node n_aabb = metadata->global_bounds(topo_name);
     double *t_min = n_aabb["min_coords"].as_float64_ptr();
     double *t_max = n_aabb["max_coords"].as_float64_ptr();
     for(int i = 0; i < 3; ++i)
@@ -73,6 +73,8 @@ namespace runtime
 namespace expressions
 {
 
+class TopologyMetadata;
+
 // Need to validate the binning input in several places
 // so consolidate this call
 void binning_interface(const std::string &reduction_var,
@@ -80,9 +82,10 @@ void binning_interface(const std::string &reduction_var,
                        const conduit::Node &n_empty_bin_val,
                        const conduit::Node &n_component,
                        const conduit::Node &n_axis_list,
-                       conduit::Node &dataset,
+                       const TopologyMetadata &metadata,
                        conduit::Node &n_binning,
-                       conduit::Node &n_output_axes);
+                       conduit::Node &n_output_axes,
+                       conduit::Node *n_homes = nullptr);
 
 //-----------------------------------------------------------------------------
 ///
@@ -124,6 +127,61 @@ public:
   virtual void execute();
 };
 
+class RollingAvg : public ::flow::Filter
+{
+public:
+  RollingAvg();
+  ~RollingAvg();
+
+  virtual void declare_interface(conduit::Node &i);
+  virtual bool verify_params(const conduit::Node &params, conduit::Node &info);
+  virtual void execute();
+};
+
+class RollingMax : public ::flow::Filter
+{
+public:
+  RollingMax();
+  ~RollingMax();
+
+  virtual void declare_interface(conduit::Node &i);
+  virtual bool verify_params(const conduit::Node &params, conduit::Node &info);
+  virtual void execute();
+};
+
+class RollingMin : public ::flow::Filter
+{
+public:
+  RollingMin();
+  ~RollingMin();
+
+  virtual void declare_interface(conduit::Node &i);
+  virtual bool verify_params(const conduit::Node &params, conduit::Node &info);
+  virtual void execute();
+};
+
+class Ema : public ::flow::Filter
+{
+public:
+  Ema();
+  ~Ema();
+
+  virtual void declare_interface(conduit::Node &i);
+  virtual bool verify_params(const conduit::Node &params, conduit::Node &info);
+  virtual void execute();
+};
+
+class Derivative : public ::flow::Filter
+{
+public:
+  Derivative();
+  ~Derivative();
+
+  virtual void declare_interface(conduit::Node &i);
+  virtual bool verify_params(const conduit::Node &params, conduit::Node &info);
+  virtual void execute();
+};
+
 class Boolean : public ::flow::Filter
 {
 public:
@@ -543,6 +601,17 @@ public:
   virtual void execute();
 };
 
+class FieldQuantile : public ::flow::Filter
+{
+public:
+  FieldQuantile();
+  ~FieldQuantile();
+
+  virtual void declare_interface(conduit::Node &i);
+  virtual bool verify_params(const conduit::Node &params, conduit::Node &info);
+  virtual void execute();
+};
+
 class PointAndAxis : public ::flow::Filter
 {
 public:
@@ -598,6 +667,39 @@ public:
   virtual void execute();
 };
 
+class SamplePoints : public ::flow::Filter
+{
+public:
+  SamplePoints();
+  ~SamplePoints();
+
+  virtual void declare_interface(conduit::Node &i);
+  virtual bool verify_params(const conduit::Node &params, conduit::Node &info);
+  virtual void execute();
+};
+
+class Probe : public ::flow::Filter
+{
+public:
+  Probe();
+  ~Probe();
+
+  virtual void declare_interface(conduit::Node &i);
+  virtual bool verify_params(const conduit::Node &params, conduit::Node &info);
+  virtual void execute();
+};
+
+class NearestVertex : public ::flow::Filter
+{
+public:
+  NearestVertex();
+  ~NearestVertex();
+
+  virtual void declare_interface(conduit::Node &i);
+  virtual bool verify_params(const conduit::Node &params, conduit::Node &info);
+  virtual void execute();
+};
+
 };
 //-----------------------------------------------------------------------------
 // -- end ascent::runtime::expressions--
@@ -1,5 +1,6 @@
 #include "ascent_expressions_ast.hpp"
 #include "ascent_expressions_parser.hpp"
+#include <atomic>
 #include <typeinfo>
 #include <unordered_map>
 #include <unordered_set>
@@ -8,6 +9,7 @@
 // ascent includes
 //-----------------------------------------------------------------------------
 #include <ascent_logging.hpp>
+#include <ascent_expression_eval.hpp>
 
 using namespace std;
 /* -- Code Generation -- */
@@ -123,7 +125,7 @@ ASTInteger::access()
 conduit::Node
 ASTInteger::build_graph(flow::Workspace &w)
 {
-  static int ast_int_counter = 0;
+  static std::atomic<int> ast_int_counter(0);
   // std::cout << "Flow integer: " << m_value << endl;
 
   // create a unique name for the filter
@@ -153,7 +155,7 @@ conduit::Node
 ASTDouble::build_graph(flow::Workspace &w)
 {
   // std::cout << "Flow double: " << m_value << endl;
-  static int ast_double_counter = 0;
+  static std::atomic<int> ast_double_counter(0);
 
   // create a unique name for the filter
   std::stringstream ss;
@@ -190,7 +192,7 @@ conduit::Node
 ASTIdentifier::build_graph(flow::Workspace &w)
 {
   // std::cout << "Flow indent : " << m_name << endl;
-  static int ast_ident_counter = 0;
+  static std::atomic<int> ast_ident_counter(0);
 
   // create a unique name for the filter
   std::stringstream ss;
@@ -206,21 +208,15 @@ ASTIdentifier::build_graph(flow::Workspace &w)
   conduit::Node res;
   res["filter_name"] = name;
 
-  // get identifier type from cache
-  conduit::Node *cache = w.registry().fetch<conduit::Node>("cache");
-  if(!cache->has_path(m_name))
+  // get identifier type from the last one calculated
+  ascent::runtime::expressions::Cache *cache =
+    w.registry().fetch<ascent::runtime::expressions::Cache>("cache");
+  conduit::Node last;
+  if(!cache->last_entry(m_name, last))
   {
     ASCENT_ERROR("Unknown expression identifier: '" << m_name << "'");
   }
-
-  const int entries = (*cache)[m_name].number_of_children();
-  if(entries < 1)
-  {
-    ASCENT_ERROR("Expression identifier: needs a non-zero number of entires: "
-                 << entries);
-  }
-  // grab the last one calculated
-  res["type"] = (*cache)[m_name].child(entries - 1)["type"];
+  res["type"] = last["type"];
   return res;
 }
 
@@ -463,7 +459,7 @@ ASTMethodCall::build_graph(flow::Workspace &w)
     // std::cout << "Function matched\n";
     // func.print();
 
-    static int ast_method_counter = 0;
+    static std::atomic<int> ast_method_counter(0);
     // create a unique name for the filter
     std::stringstream ss;
     ss << "method_" << ast_method_counter++ << "_" << m_id->m_name;
@@ -591,7 +587,7 @@ ASTIfExpr::build_graph(flow::Workspace &w)
                                                 << ") branches must match");
   }
 
-  static int ast_if_counter = 0;
+  static std::atomic<int> ast_if_counter(0);
   std::stringstream ss;
   ss << "expr_if"
      << "_" << ast_if_counter++;
@@ -724,7 +720,7 @@ ASTBinaryOp::build_graph(flow::Workspace &w)
     res_type = "bool";
   }
 
-  static int ast_op_counter = 0;
+  static std::atomic<int> ast_op_counter(0);
   // create a unique name for the filter
   std::stringstream ss;
   // ss << "binary_op" << "_" << ast_op_counter << "_" << op_str;
@@ -767,7 +763,7 @@ ASTString::build_graph(flow::Workspace &w)
   }
 
   // create a unique name for the filter
-  static int ast_string_counter = 0;
+  static std::atomic<int> ast_string_counter(0);
   std::stringstream ss;
   ss << "string"
      << "_" << ast_string_counter++;
@@ -803,7 +799,7 @@ conduit::Node
 ASTBoolean::build_graph(flow::Workspace &w)
 {
   // create a unique name for the filter
-  static int ast_bool_counter = 0;
+  static std::atomic<int> ast_bool_counter(0);
   std::stringstream ss;
   ss << "bool"
      << "_" << ast_bool_counter++;
@@ -861,7 +857,7 @@ ASTArrayAccess::build_graph(flow::Workspace &w)
   }
 
   // create a unique name for the filter
-  static int ast_array_counter = 0;
+  static std::atomic<int> ast_array_counter(0);
   std::stringstream ss;
   ss << "array"
      << "_" << ast_array_counter++;
@@ -942,7 +938,7 @@ ASTDotAccess::build_graph(flow::Workspace &w)
   std::string res_type = obj[path].as_string();
 
   // create a unique name for the filter
-  static int ast_dot_counter = 0;
+  static std::atomic<int> ast_dot_counter(0);
   std::stringstream ss;
   ss << "dot"
      << "_" << ast_dot_counter++;
@@ -978,7 +974,7 @@ conduit::Node
 ASTExpressionList::build_graph(flow::Workspace &w)
 {
   // create a unique name for the filter
-  static int ast_list_counter = 0;
+  static std::atomic<int> ast_list_counter(0);
   std::stringstream ss;
   ss << "list"
      << "_" << ast_list_counter++;
@@ -755,6 +755,7 @@ int yy_flex_debug = 0;
 char *yytext;
 #line 1 "tokens.l"
 #line 2 "tokens.l"
+#include <mutex>
 #include <string>
 #include "ascent_expressions_ast.hpp"
 #include "ascent_expressions_parser.hpp"
@@ -2216,9 +2217,29 @@ void yyfree (void * ptr )
 void scan_string(const char* str)
 {
   YY_BUFFER_STATE buffer = ascent_scan_string(str);
-  ascentparse();
+  try
+  {
+    ascentparse();
+  }
+  catch(...)
+  {
+    // syntax errors are thrown from yyerror, don't leave the buffer behind
+    ascent_delete_buffer(buffer);
+    throw;
+  }
   ascent_delete_buffer(buffer);
 }
+
+ASTExpression *parse_expression(const char* str)
+{
+  // the scanner and parser keep their state in globals so only one
+  // expression can be in flight at a time. Parsing is cheap compared
+  // to executing the resulting graph, which is done outside the lock.
+  static std::mutex parse_mutex;
+  std::lock_guard<std::mutex> lock(parse_mutex);
+  scan_string(str);
+  return get_result();
+}
 /* A Bison parser, made by GNU Bison 3.6.  */
 
 /* Bison interface for Yacc-like parsers in C
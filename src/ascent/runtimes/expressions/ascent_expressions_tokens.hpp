@@ -1 +1,6 @@
+class ASTExpression;
+
 void scan_string(const char* str);
+// parses str and returns the root of its AST, which the caller owns.
+// Unlike scan_string/get_result, this is safe to call from multiple threads.
+ASTExpression *parse_expression(const char* str);
@@ -0,0 +1,252 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_history_window.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "ascent_history_window.hpp"
+
+#include <ascent_logging.hpp>
+
+#include <cmath>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime --
+//-----------------------------------------------------------------------------
+namespace runtime
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+namespace expressions
+{
+
+HistoryWindow::HistoryWindow(const std::string &op, const double param)
+  : m_op(op),
+    m_param(param),
+    m_count(0),
+    m_sum(0.),
+    m_value(0.),
+    m_time(0.),
+    m_prev_value(0.),
+    m_prev_time(0.)
+{
+  if(!is_op(op))
+  {
+    ASCENT_ERROR("HistoryWindow: unknown op '" << op << "'");
+  }
+  if(is_rolling(op))
+  {
+    if(param < 1 || param != std::floor(param))
+    {
+      ASCENT_ERROR(op << ": the window size must be a positive integer, got "
+                      << param);
+    }
+    if(op == "rolling_avg")
+    {
+      m_ring.reserve(static_cast<size_t>(param));
+    }
+  }
+  else if(op == "ema" && (param <= 0. || param > 1.))
+  {
+    ASCENT_ERROR("ema: alpha must be in (0, 1], got " << param);
+  }
+}
+
+bool
+HistoryWindow::is_op(const std::string &op)
+{
+  return is_rolling(op) || op == "ema" || op == "derivative";
+}
+
+bool
+HistoryWindow::is_rolling(const std::string &op)
+{
+  return op == "rolling_avg" || op == "rolling_max" || op == "rolling_min";
+}
+
+void
+HistoryWindow::push_rolling_avg(const double value)
+{
+  const conduit::int64 size = static_cast<conduit::int64>(m_param);
+  const size_t slot = static_cast<size_t>(m_count % size);
+  if(m_count < size)
+  {
+    m_ring.push_back(value);
+    m_sum += value;
+  }
+  else
+  {
+    m_sum += value - m_ring[slot];
+    m_ring[slot] = value;
+  }
+  // re-sum once per trip around the full ring so rounding errors in
+  // the running sum don't pile up
+  if(m_count >= size - 1 && slot == m_ring.size() - 1)
+  {
+    m_sum = 0.;
+    for(const double v : m_ring)
+    {
+      m_sum += v;
+    }
+  }
+}
+
+void
+HistoryWindow::push_rolling_extreme(const double value)
+{
+  const bool is_max = m_op == "rolling_max";
+  // anything the new value beats can never be the extreme again
+  while(!m_extremes.empty() &&
+        (is_max ? m_extremes.back().second <= value
+                : m_extremes.back().second >= value))
+  {
+    m_extremes.pop_back();
+  }
+  m_extremes.push_back(std::make_pair(m_count, value));
+  // drop the extreme once it falls out of the window
+  const conduit::int64 size = static_cast<conduit::int64>(m_param);
+  if(m_extremes.front().first <= m_count - size)
+  {
+    m_extremes.pop_front();
+  }
+}
+
+void
+HistoryWindow::push(const double value, const double time)
+{
+  if(m_op == "rolling_avg")
+  {
+    push_rolling_avg(value);
+  }
+  else if(m_op == "rolling_max" || m_op == "rolling_min")
+  {
+    push_rolling_extreme(value);
+  }
+  else if(m_op == "ema")
+  {
+    m_value = m_count == 0 ? value : m_param * value + (1. - m_param) * m_value;
+  }
+  else
+  {
+    m_prev_value = m_value;
+    m_prev_time = m_time;
+    m_value = value;
+    m_time = time;
+  }
+  m_count++;
+}
+
+conduit::int64
+HistoryWindow::count() const
+{
+  return m_count;
+}
+
+double
+HistoryWindow::value() const
+{
+  if(m_count == 0)
+  {
+    ASCENT_ERROR(m_op << ": the expression has no history");
+  }
+  if(m_op == "rolling_avg")
+  {
+    return m_sum / static_cast<double>(m_ring.size());
+  }
+  if(m_op == "rolling_max" || m_op == "rolling_min")
+  {
+    return m_extremes.front().second;
+  }
+  if(m_op == "derivative")
+  {
+    if(m_count < 2)
+    {
+      ASCENT_ERROR("derivative: needs at least two evaluations of the "
+                   "expression");
+    }
+    const double dt = m_time - m_prev_time;
+    if(dt == 0.)
+    {
+      ASCENT_ERROR("derivative: the last two evaluations have the same time ("
+                   << m_time << ")");
+    }
+    return (m_value - m_prev_value) / dt;
+  }
+  return m_value;
+}
+
+conduit::index_t
+HistoryWindow::size_in_bytes() const
+{
+  return static_cast<conduit::index_t>(
+      sizeof(HistoryWindow) + m_ring.capacity() * sizeof(double) +
+      m_extremes.size() * sizeof(std::pair<conduit::int64, double>));
+}
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
@@ -0,0 +1,148 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_history_window.hpp
+///
+//-----------------------------------------------------------------------------
+
+#ifndef ASCENT_HISTORY_WINDOW
+#define ASCENT_HISTORY_WINDOW
+
+#include <ascent_exports.h>
+#include <conduit.hpp>
+
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime --
+//-----------------------------------------------------------------------------
+namespace runtime
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+namespace expressions
+{
+
+//
+// Statistic over the scalar history of an expression, updated with
+// (amortized) constant work per value.
+//
+//   rolling_avg  mean of the last param values (ring buffer, running sum)
+//   rolling_max  max of the last param values (monotonic deque)
+//   rolling_min  min of the last param values (monotonic deque)
+//   ema          exponential moving average with smoothing factor param
+//   derivative   rate of change of the last two values over time
+//
+class ASCENT_API HistoryWindow
+{
+public:
+  HistoryWindow(const std::string &op, const double param);
+
+  static bool is_op(const std::string &op);
+  // ops whose param is the number of values in the window
+  static bool is_rolling(const std::string &op);
+
+  void push(const double value, const double time);
+
+  conduit::int64 count() const;
+  double value() const;
+
+  // local memory held by the window
+  conduit::index_t size_in_bytes() const;
+
+private:
+  void push_rolling_avg(const double value);
+  void push_rolling_extreme(const double value);
+
+  std::string m_op;
+  double m_param;
+  conduit::int64 m_count;
+  // rolling_avg: the last values and their sum
+  std::vector<double> m_ring;
+  double m_sum;
+  // rolling_max/min: (index, value) of the values that can still become
+  // the extreme, from the current extreme to the newest value
+  std::deque<std::pair<conduit::int64, double>> m_extremes;
+  // ema: the average. derivative: the last two values and times
+  double m_value;
+  double m_time;
+  double m_prev_value;
+  double m_prev_time;
+};
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
+
+
+#endif
+//-----------------------------------------------------------------------------
+// -- end header ifdef guard
+//-----------------------------------------------------------------------------
@@ -0,0 +1,1534 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_point_locator.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "ascent_point_locator.hpp"
+
+#include <ascent_config.h>
+#include <ascent_logging.hpp>
+#include <flow_workspace.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <mutex>
+
+#ifdef ASCENT_MPI_ENABLED
+#include <mpi.h>
+#endif
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime --
+//-----------------------------------------------------------------------------
+namespace runtime
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+namespace expressions
+{
+
+namespace detail
+{
+
+// relative tolerance for points on element faces
+const double locate_eps = 1e-10;
+
+// corners of quads and hexs in blueprint order as (i,j,k) offsets
+const int corner_offsets[8][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+                                  {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+
+// quads split along the 0-2 diagonal and hexs along the 0-6 diagonal
+const int quad_tris[2][3] = {{0, 1, 2}, {0, 2, 3}};
+const int hex_tets[6][4] = {{0, 1, 2, 6}, {0, 2, 3, 6}, {0, 3, 7, 6},
+                            {0, 7, 4, 6}, {0, 4, 5, 6}, {0, 5, 1, 6}};
+
+void
+shape_info(const std::string &shape, int &num_verts, int &dims)
+{
+  num_verts = 0;
+  dims = 0;
+  if(shape == "point")
+  {
+    num_verts = 1;
+  }
+  else if(shape == "line")
+  {
+    num_verts = 2;
+    dims = 1;
+  }
+  else if(shape == "tri")
+  {
+    num_verts = 3;
+    dims = 2;
+  }
+  else if(shape == "quad")
+  {
+    num_verts = 4;
+    dims = 2;
+  }
+  else if(shape == "tet")
+  {
+    num_verts = 4;
+    dims = 3;
+  }
+  else if(shape == "hex")
+  {
+    num_verts = 8;
+    dims = 3;
+  }
+}
+
+// barycentric coordinates of p in the triangle (xy only)
+bool
+in_triangle(const double *a,
+            const double *b,
+            const double *c,
+            const double *p,
+            double *l)
+{
+  const double e1[2] = {b[0] - a[0], b[1] - a[1]};
+  const double e2[2] = {c[0] - a[0], c[1] - a[1]};
+  const double d[2] = {p[0] - a[0], p[1] - a[1]};
+  const double det = e1[0] * e2[1] - e1[1] * e2[0];
+  if(det == 0.)
+  {
+    return false;
+  }
+  l[1] = (d[0] * e2[1] - d[1] * e2[0]) / det;
+  l[2] = (e1[0] * d[1] - e1[1] * d[0]) / det;
+  l[0] = 1. - l[1] - l[2];
+  return l[0] >= -locate_eps && l[1] >= -locate_eps && l[2] >= -locate_eps;
+}
+
+double
+det3(const double *c0, const double *c1, const double *c2)
+{
+  return c0[0] * (c1[1] * c2[2] - c1[2] * c2[1]) -
+         c1[0] * (c0[1] * c2[2] - c0[2] * c2[1]) +
+         c2[0] * (c0[1] * c1[2] - c0[2] * c1[1]);
+}
+
+// barycentric coordinates of p in the tetrahedron
+bool
+in_tet(const double *a,
+       const double *b,
+       const double *c,
+       const double *d,
+       const double *p,
+       double *l)
+{
+  const double e1[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+  const double e2[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+  const double e3[3] = {d[0] - a[0], d[1] - a[1], d[2] - a[2]};
+  const double r[3] = {p[0] - a[0], p[1] - a[1], p[2] - a[2]};
+  const double det = det3(e1, e2, e3);
+  if(det == 0.)
+  {
+    return false;
+  }
+  l[1] = det3(r, e2, e3) / det;
+  l[2] = det3(e1, r, e3) / det;
+  l[3] = det3(e1, e2, r) / det;
+  l[0] = 1. - l[1] - l[2] - l[3];
+  return l[0] >= -locate_eps && l[1] >= -locate_eps && l[2] >= -locate_eps &&
+         l[3] >= -locate_eps;
+}
+
+// cell index along an axis of a uniform or rectilinear grid and the
+// fractional position inside of the cell. Returns false if outside.
+bool
+axis_cell(const double t, const int num_cells, int &cell, double &frac)
+{
+  if(t < -locate_eps || t > num_cells + locate_eps)
+  {
+    return false;
+  }
+  cell = std::min(std::max(static_cast<int>(std::floor(t)), 0), num_cells - 1);
+  frac = std::min(std::max(t - cell, 0.), 1.);
+  return true;
+}
+
+struct LocatorCacheEntry
+{
+  std::weak_ptr<conduit::Node> m_dataset;
+  std::shared_ptr<PointLocator> m_locator;
+};
+
+std::map<std::pair<const conduit::Node *, std::string>, LocatorCacheEntry> &
+locator_cache()
+{
+  static std::map<std::pair<const conduit::Node *, std::string>,
+                  LocatorCacheEntry>
+      cache;
+  return cache;
+}
+
+} // namespace detail
+
+//-----------------------------------------------------------------------------
+// ArrayView
+//-----------------------------------------------------------------------------
+void
+ArrayView::set(const conduit::Node &values)
+{
+  const conduit::DataType &dtype = values.dtype();
+  m_type = dtype.id();
+  m_size = dtype.number_of_elements();
+  m_stride = dtype.stride();
+  m_ptr = m_size > 0 ? static_cast<const char *>(values.element_ptr(0))
+                     : nullptr;
+  if(!dtype.is_float32() && !dtype.is_float64() && !dtype.is_int32() &&
+     !dtype.is_int64() && !dtype.is_uint32() && !dtype.is_uint64())
+  {
+    ASCENT_ERROR("Unsupported array type '" << dtype.name() << "'");
+  }
+}
+
+conduit::index_t
+ArrayView::size() const
+{
+  return m_size;
+}
+
+double
+ArrayView::value(const conduit::index_t index) const
+{
+  const char *ptr = m_ptr + index * m_stride;
+  switch(m_type)
+  {
+  case conduit::DataType::FLOAT32_ID:
+  {
+    conduit::float32 v;
+    std::memcpy(&v, ptr, sizeof(v));
+    return v;
+  }
+  case conduit::DataType::FLOAT64_ID:
+  {
+    conduit::float64 v;
+    std::memcpy(&v, ptr, sizeof(v));
+    return v;
+  }
+  case conduit::DataType::INT32_ID:
+  {
+    conduit::int32 v;
+    std::memcpy(&v, ptr, sizeof(v));
+    return v;
+  }
+  case conduit::DataType::INT64_ID:
+  {
+    conduit::int64 v;
+    std::memcpy(&v, ptr, sizeof(v));
+    return static_cast<double>(v);
+  }
+  case conduit::DataType::UINT32_ID:
+  {
+    conduit::uint32 v;
+    std::memcpy(&v, ptr, sizeof(v));
+    return v;
+  }
+  default:
+  {
+    conduit::uint64 v;
+    std::memcpy(&v, ptr, sizeof(v));
+    return static_cast<double>(v);
+  }
+  }
+}
+
+conduit::int64
+ArrayView::index(const conduit::index_t index) const
+{
+  const char *ptr = m_ptr + index * m_stride;
+  switch(m_type)
+  {
+  case conduit::DataType::INT32_ID:
+  {
+    conduit::int32 v;
+    std::memcpy(&v, ptr, sizeof(v));
+    return v;
+  }
+  case conduit::DataType::INT64_ID:
+  {
+    conduit::int64 v;
+    std::memcpy(&v, ptr, sizeof(v));
+    return v;
+  }
+  default:
+    return static_cast<conduit::int64>(value(index));
+  }
+}
+
+//-----------------------------------------------------------------------------
+// BoxGrid
+//-----------------------------------------------------------------------------
+void
+BoxGrid::build(const std::vector<double> &boxes, const int bins_per_box)
+{
+  const int num_boxes = static_cast<int>(boxes.size() / 6);
+  m_offsets.clear();
+  m_items.clear();
+  m_dims[0] = m_dims[1] = m_dims[2] = 0;
+  if(num_boxes == 0)
+  {
+    return;
+  }
+
+  double max[3];
+  for(int a = 0; a < 3; ++a)
+  {
+    m_min[a] = std::numeric_limits<double>::max();
+    max[a] = std::numeric_limits<double>::lowest();
+  }
+  for(int b = 0; b < num_boxes; ++b)
+  {
+    for(int a = 0; a < 3; ++a)
+    {
+      m_min[a] = std::min(m_min[a], boxes[b * 6 + a]);
+      max[a] = std::max(max[a], boxes[b * 6 + 3 + a]);
+    }
+  }
+
+  // about bins_per_box bins for each box, with roughly cubic bins
+  // spread over the axes that have an extent
+  double volume = 1.;
+  int active = 0;
+  for(int a = 0; a < 3; ++a)
+  {
+    if(max[a] > m_min[a])
+    {
+      volume *= max[a] - m_min[a];
+      active++;
+    }
+  }
+  const double target = static_cast<double>(num_boxes) * bins_per_box;
+  const double bin_size =
+      active == 0 ? 1. : std::pow(volume / target, 1. / active);
+  for(int a = 0; a < 3; ++a)
+  {
+    const double extent = max[a] - m_min[a];
+    m_dims[a] = 1;
+    if(extent > 0. && bin_size > 0.)
+    {
+      m_dims[a] = std::min(
+          std::max(static_cast<int>(std::ceil(extent / bin_size)), 1), 1024);
+    }
+    m_bin_size[a] = extent > 0. ? extent / m_dims[a] : 1.;
+  }
+
+  const int num_bins = m_dims[0] * m_dims[1] * m_dims[2];
+  m_offsets.assign(num_bins + 1, 0);
+
+  // count, then fill the bins of each box
+  for(int pass = 0; pass < 2; ++pass)
+  {
+    std::vector<int> fill;
+    if(pass == 1)
+    {
+      for(int i = 0; i < num_bins; ++i)
+      {
+        m_offsets[i + 1] += m_offsets[i];
+      }
+      m_items.resize(m_offsets[num_bins]);
+      fill.assign(m_offsets.begin(), m_offsets.end() - 1);
+    }
+    for(int b = 0; b < num_boxes; ++b)
+    {
+      int lo[3], hi[3];
+      for(int a = 0; a < 3; ++a)
+      {
+        lo[a] = static_cast<int>((boxes[b * 6 + a] - m_min[a]) / m_bin_size[a]);
+        hi[a] =
+            static_cast<int>((boxes[b * 6 + 3 + a] - m_min[a]) / m_bin_size[a]);
+        lo[a] = std::min(std::max(lo[a], 0), m_dims[a] - 1);
+        hi[a] = std::min(std::max(hi[a], 0), m_dims[a] - 1);
+      }
+      for(int k = lo[2]; k <= hi[2]; ++k)
+      {
+        for(int j = lo[1]; j <= hi[1]; ++j)
+        {
+          for(int i = lo[0]; i <= hi[0]; ++i)
+          {
+            const int bin = (k * m_dims[1] + j) * m_dims[0] + i;
+            if(pass == 0)
+            {
+              m_offsets[bin + 1]++;
+            }
+            else
+            {
+              m_items[fill[bin]++] = b;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+bool
+BoxGrid::empty() const
+{
+  return m_offsets.empty();
+}
+
+bool
+BoxGrid::bin_index(const double *point, int *idx) const
+{
+  bool inside = true;
+  for(int a = 0; a < 3; ++a)
+  {
+    const double t = (point[a] - m_min[a]) / m_bin_size[a];
+    if(t < -detail::locate_eps || t > m_dims[a] + detail::locate_eps)
+    {
+      inside = false;
+    }
+    idx[a] = std::min(std::max(static_cast<int>(std::floor(t)), 0),
+                      m_dims[a] - 1);
+  }
+  return inside;
+}
+
+void
+BoxGrid::append_bin(const int *idx, std::vector<int> &boxes) const
+{
+  const int bin = (idx[2] * m_dims[1] + idx[1]) * m_dims[0] + idx[0];
+  boxes.insert(boxes.end(),
+               m_items.begin() + m_offsets[bin],
+               m_items.begin() + m_offsets[bin + 1]);
+}
+
+void
+BoxGrid::candidates(const double *point, std::vector<int> &boxes) const
+{
+  int idx[3];
+  if(!empty() && bin_index(point, idx))
+  {
+    append_bin(idx, boxes);
+  }
+}
+
+void
+BoxGrid::ring_candidates(const double *point,
+                         const int ring,
+                         std::vector<int> &boxes) const
+{
+  if(empty())
+  {
+    return;
+  }
+  int center[3];
+  bin_index(point, center);
+  int lo[3], hi[3];
+  for(int a = 0; a < 3; ++a)
+  {
+    lo[a] = std::max(center[a] - ring, 0);
+    hi[a] = std::min(center[a] + ring, m_dims[a] - 1);
+  }
+  int idx[3];
+  for(idx[2] = lo[2]; idx[2] <= hi[2]; ++idx[2])
+  {
+    for(idx[1] = lo[1]; idx[1] <= hi[1]; ++idx[1])
+    {
+      for(idx[0] = lo[0]; idx[0] <= hi[0]; ++idx[0])
+      {
+        const int dist = std::max(std::abs(idx[0] - center[0]),
+                         std::max(std::abs(idx[1] - center[1]),
+                                  std::abs(idx[2] - center[2])));
+        if(dist == ring)
+        {
+          append_bin(idx, boxes);
+        }
+      }
+    }
+  }
+}
+
+double
+BoxGrid::ring_distance(const double *point, const int ring) const
+{
+  double res = std::numeric_limits<double>::infinity();
+  if(empty())
+  {
+    return res;
+  }
+  int center[3];
+  bin_index(point, center);
+  for(int a = 0; a < 3; ++a)
+  {
+    if(center[a] - ring > 0)
+    {
+      const double lo = m_min[a] + (center[a] - ring) * m_bin_size[a];
+      res = std::min(res, std::max(point[a] - lo, 0.));
+    }
+    if(center[a] + ring < m_dims[a] - 1)
+    {
+      const double hi = m_min[a] + (center[a] + ring + 1) * m_bin_size[a];
+      res = std::min(res, std::max(hi - point[a], 0.));
+    }
+  }
+  return res;
+}
+
+int
+BoxGrid::max_ring() const
+{
+  return std::max(m_dims[0], std::max(m_dims[1], m_dims[2]));
+}
+
+//-----------------------------------------------------------------------------
+// DomainLocator
+//-----------------------------------------------------------------------------
+DomainLocator::DomainLocator(const conduit::Node &domain,
+                             const std::string &topo_name)
+{
+  const conduit::Node &n_topo = domain["topologies/" + topo_name];
+  const std::string topo_type = n_topo["type"].as_string();
+  const std::string coords_name = n_topo["coordset"].as_string();
+  const conduit::Node &n_coords = domain["coordsets/" + coords_name];
+  const std::string coords_type = n_coords["type"].as_string();
+
+  const std::string axes[3][3] = {
+      {"x", "i", "dx"}, {"y", "j", "dy"}, {"z", "k", "dz"}};
+
+  if(coords_type == "uniform")
+  {
+    m_dims = n_coords.has_path("dims/k") ? 3
+             : n_coords.has_path("dims/j") ? 2 : 1;
+    for(int a = 0; a < m_dims; ++a)
+    {
+      m_vert_dims[a] = n_coords["dims/" + axes[a][1]].to_int32();
+      if(n_coords.has_path("origin/" + axes[a][0]))
+      {
+        m_origin[a] = n_coords["origin/" + axes[a][0]].to_float64();
+      }
+      if(n_coords.has_path("spacing/" + axes[a][2]))
+      {
+        m_spacing[a] = n_coords["spacing/" + axes[a][2]].to_float64();
+      }
+    }
+    m_num_vertices = m_vert_dims[0] * m_vert_dims[1] * m_vert_dims[2];
+  }
+  else if(coords_type == "rectilinear" || coords_type == "explicit")
+  {
+    m_dims = n_coords.has_path("values/z") ? 3
+             : n_coords.has_path("values/y") ? 2 : 1;
+    for(int a = 0; a < m_dims; ++a)
+    {
+      m_coords[a].set(n_coords["values/" + axes[a][0]]);
+    }
+    if(coords_type == "rectilinear")
+    {
+      for(int a = 0; a < m_dims; ++a)
+      {
+        m_vert_dims[a] = static_cast<int>(m_coords[a].size());
+      }
+      m_num_vertices = m_vert_dims[0] * m_vert_dims[1] * m_vert_dims[2];
+    }
+    else
+    {
+      m_num_vertices = static_cast<int>(m_coords[0].size());
+    }
+  }
+  else
+  {
+    ASCENT_ERROR("Point locator: unknown coordinate set type '"
+                 << coords_type << "'");
+  }
+
+  if(topo_type == "uniform")
+  {
+    m_kind = Kind::Uniform;
+  }
+  else if(topo_type == "rectilinear")
+  {
+    m_kind = Kind::Rectilinear;
+  }
+  else if(topo_type == "structured")
+  {
+    m_kind = Kind::Structured;
+    m_dims = n_topo.has_path("elements/dims/k") ? 3
+             : n_topo.has_path("elements/dims/j") ? 2 : 1;
+    for(int a = 0; a < m_dims; ++a)
+    {
+      m_vert_dims[a] = n_topo["elements/dims/" + axes[a][1]].to_int32() + 1;
+    }
+  }
+  else if(topo_type == "unstructured" || topo_type == "points")
+  {
+    m_kind = Kind::Unstructured;
+  }
+  else
+  {
+    ASCENT_ERROR("Point locator: unknown topology type '" << topo_type << "'");
+  }
+
+  if(m_kind == Kind::Unstructured)
+  {
+    if(topo_type == "points")
+    {
+      m_shape_verts = 1;
+      m_num_elements = m_num_vertices;
+    }
+    else
+    {
+      detail::shape_info(n_topo["elements/shape"].as_string(),
+                         m_shape_verts,
+                         m_shape_dims);
+      m_conn.set(n_topo["elements/connectivity"]);
+      m_num_elements =
+          m_shape_verts == 0
+              ? 0
+              : static_cast<int>(m_conn.size() / m_shape_verts);
+    }
+  }
+  else
+  {
+    m_shape_dims = m_dims;
+    m_shape_verts = 1 << m_dims;
+    m_num_elements = 1;
+    for(int a = 0; a < m_dims; ++a)
+    {
+      m_num_elements *= m_vert_dims[a] - 1;
+    }
+  }
+
+  // bounds
+  for(int a = 0; a < 3; ++a)
+  {
+    m_bounds[a] = 0.;
+    m_bounds[3 + a] = 0.;
+  }
+  if(coords_type == "uniform")
+  {
+    for(int a = 0; a < m_dims; ++a)
+    {
+      const double end = m_origin[a] + (m_vert_dims[a] - 1) * m_spacing[a];
+      m_bounds[a] = std::min(m_origin[a], end);
+      m_bounds[3 + a] = std::max(m_origin[a], end);
+    }
+  }
+  else
+  {
+    for(int a = 0; a < m_dims; ++a)
+    {
+      double min = std::numeric_limits<double>::max();
+      double max = std::numeric_limits<double>::lowest();
+      const conduit::index_t size = m_coords[a].size();
+      for(conduit::index_t i = 0; i < size; ++i)
+      {
+        const double v = m_coords[a].value(i);
+        min = std::min(min, v);
+        max = std::max(max, v);
+      }
+      m_bounds[a] = min;
+      m_bounds[3 + a] = max;
+    }
+  }
+}
+
+int
+DomainLocator::num_vertices() const
+{
+  return m_num_vertices;
+}
+
+int
+DomainLocator::num_elements() const
+{
+  return m_num_elements;
+}
+
+int
+DomainLocator::dims() const
+{
+  return m_dims;
+}
+
+const double *
+DomainLocator::bounds() const
+{
+  return m_bounds;
+}
+
+void
+DomainLocator::logical_vertex(const int index, int *idx) const
+{
+  idx[0] = index % m_vert_dims[0];
+  idx[1] = (index / m_vert_dims[0]) % m_vert_dims[1];
+  idx[2] = index / (m_vert_dims[0] * m_vert_dims[1]);
+}
+
+void
+DomainLocator::logical_element(const int index, int *idx) const
+{
+  const int cell_dims[2] = {m_vert_dims[0] - 1, m_vert_dims[1] - 1};
+  idx[0] = index % cell_dims[0];
+  idx[1] = (index / cell_dims[0]) % std::max(cell_dims[1], 1);
+  idx[2] = m_dims == 3 ? index / (cell_dims[0] * cell_dims[1]) : 0;
+}
+
+void
+DomainLocator::vertex(const int index, double *pos) const
+{
+  pos[0] = pos[1] = pos[2] = 0.;
+  if(m_kind == Kind::Uniform || m_kind == Kind::Rectilinear)
+  {
+    int idx[3];
+    logical_vertex(index, idx);
+    for(int a = 0; a < m_dims; ++a)
+    {
+      pos[a] = m_kind == Kind::Uniform ? m_origin[a] + idx[a] * m_spacing[a]
+                                       : m_coords[a].value(idx[a]);
+    }
+  }
+  else
+  {
+    for(int a = 0; a < m_dims; ++a)
+    {
+      pos[a] = m_coords[a].value(index);
+    }
+  }
+}
+
+int
+DomainLocator::element_vertices(const int index, int *verts) const
+{
+  if(m_kind == Kind::Unstructured)
+  {
+    if(m_shape_verts == 0)
+    {
+      ASCENT_ERROR("Point locator: unsupported element shape");
+    }
+    if(m_conn.size() == 0)
+    {
+      // points topology
+      verts[0] = index;
+      return 1;
+    }
+    const conduit::index_t offset =
+        static_cast<conduit::index_t>(index) * m_shape_verts;
+    for(int i = 0; i < m_shape_verts; ++i)
+    {
+      verts[i] = static_cast<int>(m_conn.index(offset + i));
+    }
+    return m_shape_verts;
+  }
+
+  int idx[3];
+  logical_element(index, idx);
+  for(int c = 0; c < m_shape_verts; ++c)
+  {
+    const int *off = detail::corner_offsets[c];
+    verts[c] = ((idx[2] + off[2]) * m_vert_dims[1] + idx[1] + off[1]) *
+                   m_vert_dims[0] +
+               idx[0] + off[0];
+  }
+  return m_shape_verts;
+}
+
+void
+DomainLocator::element(const int index, double *pos) const
+{
+  int verts[max_verts];
+  const int num_verts = element_vertices(index, verts);
+  pos[0] = pos[1] = pos[2] = 0.;
+  for(int v = 0; v < num_verts; ++v)
+  {
+    double vert[3];
+    vertex(verts[v], vert);
+    pos[0] += vert[0];
+    pos[1] += vert[1];
+    pos[2] += vert[2];
+  }
+  pos[0] /= num_verts;
+  pos[1] /= num_verts;
+  pos[2] /= num_verts;
+}
+
+int
+DomainLocator::locate(const double *point, double *weights) const
+{
+  if(m_kind == Kind::Uniform || m_kind == Kind::Rectilinear)
+  {
+    return locate_structured(point, weights);
+  }
+  if(m_shape_dims != m_dims)
+  {
+    ASCENT_ERROR("Point locator: can only locate points in elements that "
+                 "have the dimension of the coordinates");
+  }
+  return locate_explicit(point, weights);
+}
+
+int
+DomainLocator::locate_structured(const double *point, double *weights) const
+{
+  int cell[3] = {0, 0, 0};
+  double frac[3] = {0., 0., 0.};
+  for(int a = 0; a < m_dims; ++a)
+  {
+    const int num_cells = m_vert_dims[a] - 1;
+    if(num_cells < 1)
+    {
+      return -1;
+    }
+    double t = 0.;
+    if(m_kind == Kind::Uniform)
+    {
+      t = (point[a] - m_origin[a]) / m_spacing[a];
+    }
+    else
+    {
+      // binary search for the cell (coordinates are increasing)
+      const double first = m_coords[a].value(0);
+      const double last = m_coords[a].value(num_cells);
+      const double tol = detail::locate_eps * (last - first);
+      if(point[a] < first - tol || point[a] > last + tol)
+      {
+        return -1;
+      }
+      const double p = std::min(std::max(point[a], first), last);
+      int lo = 0;
+      int hi = num_cells;
+      while(hi - lo > 1)
+      {
+        const int mid = (lo + hi) / 2;
+        if(m_coords[a].value(mid) <= p)
+        {
+          lo = mid;
+        }
+        else
+        {
+          hi = mid;
+        }
+      }
+      const double c0 = m_coords[a].value(lo);
+      const double c1 = m_coords[a].value(lo + 1);
+      t = lo + (c1 > c0 ? (p - c0) / (c1 - c0) : 0.);
+    }
+    if(!detail::axis_cell(t, num_cells, cell[a], frac[a]))
+    {
+      return -1;
+    }
+  }
+
+  const int cell_dims[2] = {m_vert_dims[0] - 1, m_vert_dims[1] - 1};
+  const int element = (cell[2] * cell_dims[1] + cell[1]) * cell_dims[0] + cell[0];
+  for(int c = 0; c < m_shape_verts; ++c)
+  {
+    double w = 1.;
+    for(int a = 0; a < m_dims; ++a)
+    {
+      w *= detail::corner_offsets[c][a] == 1 ? frac[a] : 1. - frac[a];
+    }
+    weights[c] = w;
+  }
+  return element;
+}
+
+bool
+DomainLocator::in_element(const int index,
+                          const double *point,
+                          double *weights) const
+{
+  int verts[max_verts];
+  const int num_verts = element_vertices(index, verts);
+  double pos[max_verts][3];
+  for(int v = 0; v < num_verts; ++v)
+  {
+    vertex(verts[v], pos[v]);
+    weights[v] = 0.;
+  }
+
+  double l[4];
+  if(num_verts == 3 && m_dims == 2)
+  {
+    if(detail::in_triangle(pos[0], pos[1], pos[2], point, l))
+    {
+      weights[0] = l[0];
+      weights[1] = l[1];
+      weights[2] = l[2];
+      return true;
+    }
+  }
+  else if(num_verts == 4 && m_dims == 2)
+  {
+    for(int t = 0; t < 2; ++t)
+    {
+      const int *tri = detail::quad_tris[t];
+      if(detail::in_triangle(pos[tri[0]], pos[tri[1]], pos[tri[2]], point, l))
+      {
+        for(int v = 0; v < 3; ++v)
+        {
+          weights[tri[v]] = l[v];
+        }
+        return true;
+      }
+    }
+  }
+  else if(num_verts == 4)
+  {
+    if(detail::in_tet(pos[0], pos[1], pos[2], pos[3], point, l))
+    {
+      for(int v = 0; v < 4; ++v)
+      {
+        weights[v] = l[v];
+      }
+      return true;
+    }
+  }
+  else if(num_verts == 8)
+  {
+    for(int t = 0; t < 6; ++t)
+    {
+      const int *tet = detail::hex_tets[t];
+      if(detail::in_tet(pos[tet[0]], pos[tet[1]], pos[tet[2]], pos[tet[3]],
+                        point, l))
+      {
+        for(int v = 0; v < 4; ++v)
+        {
+          weights[tet[v]] = l[v];
+        }
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void
+DomainLocator::build_element_grid() const
+{
+  std::vector<double> boxes(static_cast<size_t>(m_num_elements) * 6);
+  for(int e = 0; e < m_num_elements; ++e)
+  {
+    int verts[max_verts];
+    const int num_verts = element_vertices(e, verts);
+    double *box = &boxes[static_cast<size_t>(e) * 6];
+    for(int a = 0; a < 3; ++a)
+    {
+      box[a] = std::numeric_limits<double>::max();
+      box[3 + a] = std::numeric_limits<double>::lowest();
+    }
+    for(int v = 0; v < num_verts; ++v)
+    {
+      double pos[3];
+      vertex(verts[v], pos);
+      for(int a = 0; a < 3; ++a)
+      {
+        box[a] = std::min(box[a], pos[a]);
+        box[3 + a] = std::max(box[3 + a], pos[a]);
+      }
+    }
+  }
+  m_element_grid.build(boxes);
+}
+
+void
+DomainLocator::build_vertex_grid() const
+{
+  std::vector<double> boxes(static_cast<size_t>(m_num_vertices) * 6);
+  for(int v = 0; v < m_num_vertices; ++v)
+  {
+    double *box = &boxes[static_cast<size_t>(v) * 6];
+    vertex(v, box);
+    box[3] = box[0];
+    box[4] = box[1];
+    box[5] = box[2];
+  }
+  m_vertex_grid.build(boxes);
+}
+
+int
+DomainLocator::locate_explicit(const double *point, double *weights) const
+{
+  if(m_num_elements == 0)
+  {
+    return -1;
+  }
+  // locators are shared, so the grid is built by whoever gets here first
+  std::call_once(m_element_grid_once, [this]() { build_element_grid(); });
+  std::vector<int> candidates;
+  m_element_grid.candidates(point, candidates);
+  for(const int element : candidates)
+  {
+    if(in_element(element, point, weights))
+    {
+      return element;
+    }
+  }
+  return -1;
+}
+
+int
+DomainLocator::nearest_vertex(const double *point, double &dist2) const
+{
+  dist2 = std::numeric_limits<double>::infinity();
+  if(m_num_vertices == 0)
+  {
+    return -1;
+  }
+
+  if(m_kind == Kind::Uniform || m_kind == Kind::Rectilinear)
+  {
+    // the closest vertex along each axis
+    int idx[3] = {0, 0, 0};
+    for(int a = 0; a < m_dims; ++a)
+    {
+      const int last = m_vert_dims[a] - 1;
+      if(m_kind == Kind::Uniform)
+      {
+        const double t = (point[a] - m_origin[a]) / m_spacing[a];
+        idx[a] = std::min(std::max(static_cast<int>(std::round(t)), 0), last);
+      }
+      else
+      {
+        int best = 0;
+        double best_dist = std::numeric_limits<double>::infinity();
+        int lo = 0;
+        int hi = last;
+        while(hi - lo > 1)
+        {
+          const int mid = (lo + hi) / 2;
+          if(m_coords[a].value(mid) <= point[a])
+          {
+            lo = mid;
+          }
+          else
+          {
+            hi = mid;
+          }
+        }
+        for(int c = lo; c <= hi; ++c)
+        {
+          const double d = std::abs(m_coords[a].value(c) - point[a]);
+          if(d < best_dist)
+          {
+            best_dist = d;
+            best = c;
+          }
+        }
+        idx[a] = best;
+      }
+    }
+    const int index = (idx[2] * m_vert_dims[1] + idx[1]) * m_vert_dims[0] + idx[0];
+    double pos[3];
+    vertex(index, pos);
+    dist2 = 0.;
+    for(int a = 0; a < 3; ++a)
+    {
+      dist2 += (pos[a] - point[a]) * (pos[a] - point[a]);
+    }
+    return index;
+  }
+
+  std::call_once(m_vertex_grid_once, [this]() { build_vertex_grid(); });
+
+  // search rings of bins around the point until no closer vertex can be
+  // in the bins that are left
+  int res = -1;
+  std::vector<int> candidates;
+  const int max_ring = m_vertex_grid.max_ring();
+  for(int ring = 0; ring <= max_ring; ++ring)
+  {
+    candidates.clear();
+    m_vertex_grid.ring_candidates(point, ring, candidates);
+    for(const int v : candidates)
+    {
+      double pos[3];
+      vertex(v, pos);
+      double d = 0.;
+      for(int a = 0; a < 3; ++a)
+      {
+        d += (pos[a] - point[a]) * (pos[a] - point[a]);
+      }
+      if(d < dist2)
+      {
+        dist2 = d;
+        res = v;
+      }
+    }
+    const double left = m_vertex_grid.ring_distance(point, ring);
+    if(res != -1 && dist2 <= left * left)
+    {
+      break;
+    }
+  }
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+// PointLocator
+//-----------------------------------------------------------------------------
+PointLocator::PointLocator(const conduit::Node &dataset,
+                           const std::string &topo_name)
+  : m_topo_name(topo_name)
+{
+  const int num_children = dataset.number_of_children();
+  m_child_domain.assign(num_children, -1);
+  std::vector<double> boxes;
+  for(int i = 0; i < num_children; ++i)
+  {
+    const conduit::Node &dom = dataset.child(i);
+    if(!dom.has_path("topologies/" + topo_name))
+    {
+      continue;
+    }
+    std::shared_ptr<DomainLocator> locator =
+        std::make_shared<DomainLocator>(dom, topo_name);
+    m_child_domain[i] = static_cast<int>(m_domains.size());
+    m_domain_child.push_back(i);
+    m_domains.push_back(locator);
+    boxes.insert(boxes.end(), locator->bounds(), locator->bounds() + 6);
+  }
+  m_domain_grid.build(boxes);
+}
+
+std::shared_ptr<PointLocator>
+PointLocator::get(std::shared_ptr<conduit::Node> dataset,
+                  const std::string &topo_name)
+{
+  static std::mutex cache_mutex;
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  auto &cache = detail::locator_cache();
+  // drop locators of data sets that are gone
+  for(auto it = cache.begin(); it != cache.end();)
+  {
+    if(it->second.m_dataset.expired())
+    {
+      it = cache.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  const auto key = std::make_pair(
+      static_cast<const conduit::Node *>(dataset.get()), topo_name);
+  detail::LocatorCacheEntry &entry = cache[key];
+  if(entry.m_locator == nullptr || entry.m_dataset.lock() != dataset)
+  {
+    entry.m_dataset = dataset;
+    entry.m_locator = std::make_shared<PointLocator>(*dataset, topo_name);
+  }
+  return entry.m_locator;
+}
+
+const std::string &
+PointLocator::topology() const
+{
+  return m_topo_name;
+}
+
+const DomainLocator *
+PointLocator::domain(const int index) const
+{
+  if(index < 0 || index >= static_cast<int>(m_child_domain.size()) ||
+     m_child_domain[index] == -1)
+  {
+    return nullptr;
+  }
+  return m_domains[m_child_domain[index]].get();
+}
+
+int
+PointLocator::locate(const double *point, std::vector<Hit> &hits) const
+{
+  hits.clear();
+  std::vector<int> candidates;
+  m_domain_grid.candidates(point, candidates);
+  for(const int d : candidates)
+  {
+    const DomainLocator &locator = *m_domains[d];
+    Hit hit;
+    const int element = locator.locate(point, hit.m_weights);
+    if(element != -1)
+    {
+      hit.m_domain = m_domain_child[d];
+      hit.m_element = element;
+      hit.m_num_verts = locator.element_vertices(element, hit.m_verts);
+      hits.push_back(hit);
+    }
+  }
+  return static_cast<int>(hits.size());
+}
+
+bool
+PointLocator::nearest_vertex(const double *point,
+                             int &domain,
+                             int &index,
+                             double &dist2) const
+{
+  domain = -1;
+  index = -1;
+  dist2 = std::numeric_limits<double>::infinity();
+  for(size_t d = 0; d < m_domains.size(); ++d)
+  {
+    // skip domains whose bounds are farther than the best vertex
+    const double *bounds = m_domains[d]->bounds();
+    double box_dist2 = 0.;
+    for(int a = 0; a < 3; ++a)
+    {
+      const double out = std::max(bounds[a] - point[a],
+                                  std::max(point[a] - bounds[3 + a], 0.));
+      box_dist2 += out * out;
+    }
+    if(box_dist2 >= dist2)
+    {
+      continue;
+    }
+    double d2;
+    const int v = m_domains[d]->nearest_vertex(point, d2);
+    if(v != -1 && d2 < dist2)
+    {
+      dist2 = d2;
+      domain = m_domain_child[d];
+      index = v;
+    }
+  }
+  return index != -1;
+}
+
+//-----------------------------------------------------------------------------
+conduit::Node
+probe(std::shared_ptr<conduit::Node> dataset,
+      const std::vector<std::string> &field_names,
+      const std::vector<double> &points,
+      const double empty_val)
+{
+  const conduit::Node &dset = *dataset;
+  const int num_points = static_cast<int>(points.size() / 3);
+  const int num_fields = static_cast<int>(field_names.size());
+  const int num_domains = dset.number_of_children();
+  const size_t num_values = static_cast<size_t>(num_fields) * num_points;
+  // value sums of every field followed by their number of hits, so that
+  // every rank's contributions are combined in a single reduction
+  std::vector<double> sums(num_values * 2, 0.);
+  double *counts = sums.data() + num_values;
+
+  // the fields of each topology on this rank (ranks without the fields
+  // still take part in the exchange)
+  std::map<std::string, std::vector<int>> topo_fields;
+  for(int f = 0; f < num_fields; ++f)
+  {
+    const std::string path = "fields/" + field_names[f];
+    for(int d = 0; d < num_domains; ++d)
+    {
+      if(dset.child(d).has_path(path))
+      {
+        topo_fields[dset.child(d)[path + "/topology"].as_string()].push_back(f);
+        break;
+      }
+    }
+  }
+
+  struct FieldView
+  {
+    ArrayView m_values;
+    bool m_has_field = false;
+    bool m_vertex = false;
+  };
+
+  for(const auto &topo : topo_fields)
+  {
+    const std::vector<int> &fields = topo.second;
+    const int topo_num_fields = static_cast<int>(fields.size());
+    std::vector<FieldView> views(static_cast<size_t>(topo_num_fields) *
+                                 num_domains);
+    for(int f = 0; f < topo_num_fields; ++f)
+    {
+      const std::string path = "fields/" + field_names[fields[f]];
+      for(int d = 0; d < num_domains; ++d)
+      {
+        const conduit::Node &dom = dset.child(d);
+        if(!dom.has_path(path))
+        {
+          continue;
+        }
+        const conduit::Node &n_field = dom[path];
+        const conduit::Node &n_values =
+            n_field["values"].number_of_children() == 1
+                ? n_field["values"].child(0)
+                : n_field["values"];
+        FieldView &view = views[static_cast<size_t>(f) * num_domains + d];
+        view.m_values.set(n_values);
+        view.m_has_field = true;
+        view.m_vertex = n_field["association"].as_string() == "vertex";
+      }
+    }
+
+    // every point is located once for all of the fields of the topology
+    std::shared_ptr<PointLocator> locator =
+        PointLocator::get(dataset, topo.first);
+#ifdef ASCENT_USE_OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < num_points; ++i)
+    {
+      // points on the boundary of several local domains count once per
+      // domain, the same as domains that are on different ranks
+      std::vector<PointLocator::Hit> hits;
+      locator->locate(&points[static_cast<size_t>(i) * 3], hits);
+      for(const PointLocator::Hit &hit : hits)
+      {
+        for(int f = 0; f < topo_num_fields; ++f)
+        {
+          const FieldView &view =
+              views[static_cast<size_t>(f) * num_domains + hit.m_domain];
+          if(!view.m_has_field)
+          {
+            continue;
+          }
+          double value = 0.;
+          if(view.m_vertex)
+          {
+            for(int v = 0; v < hit.m_num_verts; ++v)
+            {
+              value += hit.m_weights[v] * view.m_values.value(hit.m_verts[v]);
+            }
+          }
+          else
+          {
+            value = view.m_values.value(hit.m_element);
+          }
+          const size_t index = static_cast<size_t>(fields[f]) * num_points + i;
+          sums[index] += value;
+          counts[index] += 1.;
+        }
+      }
+    }
+  }
+
+#ifdef ASCENT_MPI_ENABLED
+  MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
+  MPI_Allreduce(MPI_IN_PLACE,
+                sums.data(),
+                static_cast<int>(sums.size()),
+                MPI_DOUBLE,
+                MPI_SUM,
+                mpi_comm);
+#endif
+
+  conduit::Node res;
+  for(int f = 0; f < num_fields; ++f)
+  {
+    conduit::Node &n_values = res[field_names[f]];
+    n_values.set(conduit::DataType::float64(num_points));
+    conduit::float64_array values = n_values.value();
+    for(int i = 0; i < num_points; ++i)
+    {
+      const size_t index = static_cast<size_t>(f) * num_points + i;
+      values[i] = counts[index] > 0. ? sums[index] / counts[index] : empty_val;
+    }
+  }
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+conduit::Node
+nearest_vertices(std::shared_ptr<conduit::Node> dataset,
+                 const std::string &field_name,
+                 const std::vector<double> &points)
+{
+  const conduit::Node &dset = *dataset;
+  const int num_points = static_cast<int>(points.size() / 3);
+  const int num_domains = dset.number_of_children();
+  const std::string path = "fields/" + field_name;
+
+  int rank = 0;
+#ifdef ASCENT_MPI_ENABLED
+  MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
+  MPI_Comm_rank(mpi_comm, &rank);
+#endif
+
+  std::string topo_name;
+  for(int d = 0; d < num_domains; ++d)
+  {
+    if(dset.child(d).has_path(path))
+    {
+      topo_name = dset.child(d)[path + "/topology"].as_string();
+      break;
+    }
+  }
+
+  // closest vertex on this rank
+  std::vector<int> domains(num_points, -1);
+  std::vector<int> indices(num_points, -1);
+  struct DistRank
+  {
+    double m_dist2;
+    int m_rank;
+  };
+  std::vector<DistRank> dists(num_points);
+  std::shared_ptr<PointLocator> locator;
+  if(!topo_name.empty())
+  {
+    locator = PointLocator::get(dataset, topo_name);
+  }
+#ifdef ASCENT_USE_OPENMP
+#pragma omp parallel for
+#endif
+  for(int i = 0; i < num_points; ++i)
+  {
+    dists[i].m_dist2 = std::numeric_limits<double>::max();
+    dists[i].m_rank = rank;
+    double dist2;
+    if(locator != nullptr &&
+       locator->nearest_vertex(&points[static_cast<size_t>(i) * 3],
+                               domains[i],
+                               indices[i],
+                               dist2) &&
+       dset.child(domains[i]).has_path(path))
+    {
+      dists[i].m_dist2 = dist2;
+    }
+    else
+    {
+      domains[i] = -1;
+    }
+  }
+
+#ifdef ASCENT_MPI_ENABLED
+  MPI_Allreduce(MPI_IN_PLACE,
+                dists.data(),
+                num_points,
+                MPI_DOUBLE_INT,
+                MPI_MINLOC,
+                mpi_comm);
+#endif
+
+  // the owner of each point's vertex fills in its part, everyone else
+  // contributes zeros: value, x, y, z, domain_id, index
+  const int per_point = 6;
+  std::vector<double> owned(static_cast<size_t>(num_points) * per_point, 0.);
+  for(int i = 0; i < num_points; ++i)
+  {
+    if(dists[i].m_rank != rank || domains[i] == -1)
+    {
+      continue;
+    }
+    const conduit::Node &dom = dset.child(domains[i]);
+    const conduit::Node &n_field = dom[path];
+    const conduit::Node &n_values = n_field["values"].number_of_children() == 1
+                                        ? n_field["values"].child(0)
+                                        : n_field["values"];
+    ArrayView values;
+    values.set(n_values);
+    double *res = &owned[static_cast<size_t>(i) * per_point];
+    res[0] = values.value(indices[i]);
+    locator->domain(domains[i])->vertex(indices[i], res + 1);
+    res[4] = dom.has_path("state/domain_id")
+                 ? dom["state/domain_id"].to_float64()
+                 : double(domains[i]);
+    res[5] = indices[i];
+  }
+
+#ifdef ASCENT_MPI_ENABLED
+  MPI_Allreduce(MPI_IN_PLACE,
+                owned.data(),
+                static_cast<int>(owned.size()),
+                MPI_DOUBLE,
+                MPI_SUM,
+                mpi_comm);
+#endif
+
+  conduit::Node res;
+  res["value"].set(conduit::DataType::float64(num_points));
+  res["position"].set(conduit::DataType::float64(num_points * 3));
+  res["distance"].set(conduit::DataType::float64(num_points));
+  res["rank"].set(conduit::DataType::int32(num_points));
+  res["domain_id"].set(conduit::DataType::int32(num_points));
+  res["index"].set(conduit::DataType::int32(num_points));
+  double *res_values = res["value"].value();
+  double *res_position = res["position"].value();
+  double *res_distance = res["distance"].value();
+  int *res_rank = res["rank"].value();
+  int *res_domain_id = res["domain_id"].value();
+  int *res_index = res["index"].value();
+  for(int i = 0; i < num_points; ++i)
+  {
+    const double *p = &owned[static_cast<size_t>(i) * per_point];
+    const bool found = dists[i].m_dist2 != std::numeric_limits<double>::max();
+    res_values[i] = p[0];
+    res_position[i * 3] = p[1];
+    res_position[i * 3 + 1] = p[2];
+    res_position[i * 3 + 2] = p[3];
+    res_distance[i] = found ? std::sqrt(dists[i].m_dist2) : 0.;
+    res_rank[i] = found ? dists[i].m_rank : -1;
+    res_domain_id[i] = found ? static_cast<int>(p[4]) : -1;
+    res_index[i] = found ? static_cast<int>(p[5]) : -1;
+  }
+  return res;
+}
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
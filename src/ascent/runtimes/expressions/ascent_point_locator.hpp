@@ -0,0 +1,299 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_point_locator.hpp
+///
+//-----------------------------------------------------------------------------
+
+#ifndef ASCENT_POINT_LOCATOR
+#define ASCENT_POINT_LOCATOR
+
+#include <ascent_exports.h>
+#include <conduit.hpp>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime --
+//-----------------------------------------------------------------------------
+namespace runtime
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+namespace expressions
+{
+
+//
+// Read only view of a (possibly strided) numeric conduit array.
+//
+class ASCENT_API ArrayView
+{
+public:
+  void set(const conduit::Node &values);
+  conduit::index_t size() const;
+  double value(const conduit::index_t index) const;
+  conduit::int64 index(const conduit::index_t index) const;
+private:
+  const char *m_ptr = nullptr;
+  conduit::index_t m_stride = 0;
+  conduit::index_t m_size = 0;
+  conduit::index_t m_type = conduit::DataType::EMPTY_ID;
+};
+
+//
+// Uniform grid of axis aligned boxes. Each bin lists the boxes that
+// overlap it, so a point query only looks at the boxes of one bin.
+//
+class ASCENT_API BoxGrid
+{
+public:
+  // boxes holds (min x, min y, min z, max x, max y, max z) per box
+  void build(const std::vector<double> &boxes, const int bins_per_box = 1);
+  bool empty() const;
+  // appends the boxes that may contain the point
+  void candidates(const double *point, std::vector<int> &boxes) const;
+  // appends the boxes of the bins within 'ring' bins of the point's bin
+  // (only the outer shell of bins for ring > 0)
+  void ring_candidates(const double *point,
+                       const int ring,
+                       std::vector<int> &boxes) const;
+  // distance from the point to the closest bin not yet visited after 'ring'
+  double ring_distance(const double *point, const int ring) const;
+  int max_ring() const;
+private:
+  bool bin_index(const double *point, int *idx) const;
+  void append_bin(const int *idx, std::vector<int> &boxes) const;
+
+  double m_min[3];
+  double m_bin_size[3];
+  int m_dims[3] = {0, 0, 0};
+  std::vector<int> m_offsets;
+  std::vector<int> m_items;
+};
+
+//
+// Resolved view of a topology in one domain. Vertex and element positions
+// are answered without looking up the topology or coordinate set by name,
+// and points are located in elements with a grid over the element bounds
+// that is built on first use.
+//
+// Supports uniform, rectilinear, and structured topologies and
+// unstructured topologies of tris, quads, tets and hexs. Quads and hexs
+// of explicit topologies are split into triangles and tetrahedra, so
+// vertex weights are linear inside of those pieces.
+//
+class ASCENT_API DomainLocator
+{
+public:
+  // at most 8 vertices per element
+  static const int max_verts = 8;
+
+  DomainLocator(const conduit::Node &domain, const std::string &topo_name);
+
+  int num_vertices() const;
+  int num_elements() const;
+  // spatial dims of the coordinates
+  int dims() const;
+
+  void vertex(const int index, double *pos) const;
+  // element centroid
+  void element(const int index, double *pos) const;
+  // returns the number of vertices of the element
+  int element_vertices(const int index, int *verts) const;
+
+  // (min x, min y, min z, max x, max y, max z)
+  const double *bounds() const;
+
+  // returns the element containing the point or -1. The weights of the
+  // element's vertices (in the order of element_vertices) are written to
+  // weights.
+  int locate(const double *point, double *weights) const;
+
+  // returns the vertex closest to the point and its squared distance
+  int nearest_vertex(const double *point, double &dist2) const;
+
+private:
+  enum class Kind { Uniform, Rectilinear, Structured, Unstructured };
+
+  void logical_vertex(const int index, int *idx) const;
+  void logical_element(const int index, int *idx) const;
+  int locate_structured(const double *point, double *weights) const;
+  int locate_explicit(const double *point, double *weights) const;
+  bool in_element(const int index, const double *point, double *weights) const;
+  void build_element_grid() const;
+  void build_vertex_grid() const;
+
+  Kind m_kind;
+  // spatial dims of the coordinates
+  int m_dims = 3;
+  // vertices and topological dims of the element shape
+  int m_shape_verts = 0;
+  int m_shape_dims = 0;
+  // vertex dims of uniform, rectilinear and structured topologies
+  int m_vert_dims[3] = {1, 1, 1};
+  double m_origin[3] = {0., 0., 0.};
+  double m_spacing[3] = {1., 1., 1.};
+  double m_bounds[6];
+
+  // explicit and rectilinear coordinates
+  ArrayView m_coords[3];
+  // unstructured connectivity (empty for points topologies)
+  ArrayView m_conn;
+  int m_num_vertices = 0;
+  int m_num_elements = 0;
+
+  // built on first use, safe to query from several threads
+  mutable BoxGrid m_element_grid;
+  mutable BoxGrid m_vertex_grid;
+  mutable std::once_flag m_element_grid_once;
+  mutable std::once_flag m_vertex_grid_once;
+};
+
+//
+// Locates points in the domains of a topology on this rank. A grid over
+// the domain bounds selects the domains to search.
+//
+class ASCENT_API PointLocator
+{
+public:
+  struct Hit
+  {
+    // index of the domain in the data set
+    int m_domain = -1;
+    int m_element = -1;
+    int m_num_verts = 0;
+    int m_verts[DomainLocator::max_verts];
+    double m_weights[DomainLocator::max_verts];
+  };
+
+  PointLocator(const conduit::Node &dataset, const std::string &topo_name);
+
+  // returns the locator for the topology of the data set. Locators are
+  // cached while the data set is alive.
+  static std::shared_ptr<PointLocator> get(std::shared_ptr<conduit::Node> dataset,
+                                           const std::string &topo_name);
+
+  const std::string &topology() const;
+
+  // the domain locator for a data set child (nullptr if the domain
+  // does not have the topology)
+  const DomainLocator *domain(const int index) const;
+
+  // locates the point in the domains on this rank. Points on the
+  // boundary of several domains get a hit for each of them. Returns the
+  // number of hits.
+  int locate(const double *point, std::vector<Hit> &hits) const;
+
+  // closest vertex on this rank (false if there are no vertices)
+  bool nearest_vertex(const double *point,
+                      int &domain,
+                      int &index,
+                      double &dist2) const;
+
+private:
+  std::string m_topo_name;
+  std::vector<std::shared_ptr<DomainLocator>> m_domains;
+  // data set child of each domain locator and the reverse
+  std::vector<int> m_domain_child;
+  std::vector<int> m_child_domain;
+  BoxGrid m_domain_grid;
+};
+
+// values of scalar fields at points (x,y,z interleaved) over all ranks,
+// exchanged in one reduction. The points are located once per topology
+// for all of the fields on it. Vertex fields are interpolated and element
+// fields take the value of the containing element. Points on the boundary
+// of several domains get their average, and points outside of the mesh
+// get empty_val. res[field_name] holds the values of each field.
+ASCENT_API
+conduit::Node probe(std::shared_ptr<conduit::Node> dataset,
+                    const std::vector<std::string> &field_names,
+                    const std::vector<double> &points,
+                    const double empty_val);
+
+// the vertex of the field's topology closest to each point (x,y,z
+// interleaved) over all ranks. The field has to be a vertex field, exchanged in two reductions. res holds
+// per point arrays: value (the vertex field at the vertex), position
+// (x,y,z interleaved), distance, rank, domain_id and index. Points get
+// rank -1 when no rank has vertices.
+ASCENT_API
+conduit::Node nearest_vertices(std::shared_ptr<conduit::Node> dataset,
+                               const std::string &field_name,
+                               const std::vector<double> &points);
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
+
+
+#endif
+//-----------------------------------------------------------------------------
+// -- end header ifdef guard
+//-----------------------------------------------------------------------------
@@ -0,0 +1,315 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_quantile_sketch.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "ascent_quantile_sketch.hpp"
+
+#include <ascent_logging.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime --
+//-----------------------------------------------------------------------------
+namespace runtime
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+namespace expressions
+{
+
+namespace detail
+{
+
+// Every compaction of level h removes at least capacity - 1 values of
+// weight 2^h, and at most count weight ever passes through a level, so
+// level h adds at most count / (capacity - 1) rank error and only levels
+// with (capacity - 1) * 2^h <= count compact at all.
+double
+rank_error_bound(const conduit::int64 capacity, const conduit::int64 count)
+{
+  if(capacity < 2)
+  {
+    return std::numeric_limits<double>::infinity();
+  }
+  const double per_level = double(capacity - 1);
+  int levels = 0;
+  for(double w = per_level; w <= double(count); w *= 2.)
+  {
+    levels++;
+  }
+  return levels * double(count) / per_level;
+}
+
+} // namespace detail
+
+QuantileSketch::QuantileSketch(const conduit::int64 capacity)
+  : m_capacity(std::max(capacity, conduit::int64(2))),
+    m_count(0),
+    m_rank_error(0.)
+{
+}
+
+conduit::int64
+QuantileSketch::capacity(const double error, const conduit::int64 count)
+{
+  // a capacity above count never compacts
+  conduit::int64 hi = std::max(count + 1, conduit::int64(2));
+  if(error <= 0.)
+  {
+    return hi;
+  }
+  const double max_error = error * double(count);
+  // the bound only shrinks as the capacity grows
+  conduit::int64 lo = 2;
+  while(lo < hi)
+  {
+    const conduit::int64 mid = lo + (hi - lo) / 2;
+    if(detail::rank_error_bound(mid, count) <= max_error)
+    {
+      hi = mid;
+    }
+    else
+    {
+      lo = mid + 1;
+    }
+  }
+  return lo;
+}
+
+void
+QuantileSketch::insert(const double value)
+{
+  if(m_levels.empty())
+  {
+    m_levels.resize(1);
+    m_offsets.resize(1, 0);
+  }
+  m_levels[0].push_back(value);
+  m_count++;
+  if(conduit::int64(m_levels[0].size()) >= m_capacity)
+  {
+    compact_full_levels();
+  }
+}
+
+void
+QuantileSketch::merge(const QuantileSketch &other)
+{
+  if(other.m_levels.size() > m_levels.size())
+  {
+    m_levels.resize(other.m_levels.size());
+    m_offsets.resize(other.m_levels.size(), 0);
+  }
+  for(size_t h = 0; h < other.m_levels.size(); ++h)
+  {
+    m_levels[h].insert(m_levels[h].end(),
+                       other.m_levels[h].begin(),
+                       other.m_levels[h].end());
+  }
+  m_count += other.m_count;
+  m_rank_error += other.m_rank_error;
+  compact_full_levels();
+}
+
+void
+QuantileSketch::compact_full_levels()
+{
+  for(size_t h = 0; h < m_levels.size(); ++h)
+  {
+    if(conduit::int64(m_levels[h].size()) >= m_capacity)
+    {
+      compact(h);
+    }
+  }
+}
+
+void
+QuantileSketch::compact(const size_t level)
+{
+  if(level + 1 == m_levels.size())
+  {
+    m_levels.emplace_back();
+    m_offsets.push_back(0);
+  }
+  std::vector<double> &values = m_levels[level];
+  std::sort(values.begin(), values.end());
+
+  // an odd value out stays behind
+  double left_over = 0.;
+  const bool odd = values.size() % 2 == 1;
+  if(odd)
+  {
+    left_over = values.back();
+    values.pop_back();
+  }
+
+  std::vector<double> &next = m_levels[level + 1];
+  const int offset = m_offsets[level];
+  for(size_t i = offset; i < values.size(); i += 2)
+  {
+    next.push_back(values[i]);
+  }
+  m_offsets[level] = 1 - offset;
+  m_rank_error += std::ldexp(1., int(level));
+
+  values.clear();
+  if(odd)
+  {
+    values.push_back(left_over);
+  }
+}
+
+conduit::int64
+QuantileSketch::count() const
+{
+  return m_count;
+}
+
+double
+QuantileSketch::rank_error() const
+{
+  return m_rank_error;
+}
+
+double
+QuantileSketch::quantile(const double q) const
+{
+  if(m_count == 0)
+  {
+    ASCENT_ERROR("Quantile: no values to take a quantile of");
+  }
+
+  std::vector<std::pair<double, double>> weighted;
+  for(size_t h = 0; h < m_levels.size(); ++h)
+  {
+    const double weight = std::ldexp(1., int(h));
+    for(const double value : m_levels[h])
+    {
+      weighted.emplace_back(value, weight);
+    }
+  }
+  std::sort(weighted.begin(), weighted.end());
+
+  const double rank = std::min(std::max(q, 0.), 1.) * double(m_count);
+  double total = 0.;
+  for(const auto &item : weighted)
+  {
+    total += item.second;
+    if(total >= rank)
+    {
+      return item.first;
+    }
+  }
+  return weighted.back().first;
+}
+
+void
+QuantileSketch::pack(std::vector<double> &buffer) const
+{
+  buffer.push_back(double(m_count));
+  buffer.push_back(m_rank_error);
+  buffer.push_back(double(m_levels.size()));
+  for(size_t h = 0; h < m_levels.size(); ++h)
+  {
+    buffer.push_back(double(m_levels[h].size()));
+    buffer.insert(buffer.end(), m_levels[h].begin(), m_levels[h].end());
+  }
+}
+
+conduit::index_t
+QuantileSketch::unpack(const double *buffer)
+{
+  conduit::index_t pos = 0;
+  const conduit::int64 count = conduit::int64(buffer[pos++]);
+  const double rank_error = buffer[pos++];
+  const size_t num_levels = size_t(buffer[pos++]);
+  if(num_levels > m_levels.size())
+  {
+    m_levels.resize(num_levels);
+    m_offsets.resize(num_levels, 0);
+  }
+  for(size_t h = 0; h < num_levels; ++h)
+  {
+    const conduit::index_t size = conduit::index_t(buffer[pos++]);
+    m_levels[h].insert(m_levels[h].end(), buffer + pos, buffer + pos + size);
+    pos += size;
+  }
+  m_count += count;
+  m_rank_error += rank_error;
+  compact_full_levels();
+  return pos;
+}
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
@@ -0,0 +1,145 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_quantile_sketch.hpp
+///
+//-----------------------------------------------------------------------------
+
+#ifndef ASCENT_QUANTILE_SKETCH
+#define ASCENT_QUANTILE_SKETCH
+
+#include <ascent_exports.h>
+#include <conduit.hpp>
+
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime --
+//-----------------------------------------------------------------------------
+namespace runtime
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+namespace expressions
+{
+
+//
+// Mergeable streaming quantile sketch (a stack of KLL style compactors).
+//
+// Level h holds values of weight 2^h. When a level reaches capacity its
+// values are sorted and every other one moves up a level, alternating
+// between the even and odd ones. Each such compaction changes the rank
+// of any value by at most the weight of the level, so the sketch keeps
+// a bound on the rank error of its answers.
+//
+class ASCENT_API QuantileSketch
+{
+public:
+  // capacity is the number of values a level holds before it is compacted
+  QuantileSketch(const conduit::int64 capacity);
+
+  // smallest capacity that keeps the rank error of a sketch (or of any
+  // merge of sketches) over count values below error * count. A zero
+  // error gives a capacity that never compacts.
+  static conduit::int64 capacity(const double error,
+                                 const conduit::int64 count);
+
+  void insert(const double value);
+  void merge(const QuantileSketch &other);
+
+  conduit::int64 count() const;
+  // bound on the distance between q * count and the rank of the
+  // value returned for q
+  double rank_error() const;
+  double quantile(const double q) const;
+
+  // flat representation for sending between ranks. unpack merges the
+  // packed sketch into this one and returns the number of doubles read.
+  void pack(std::vector<double> &buffer) const;
+  conduit::index_t unpack(const double *buffer);
+
+private:
+  void compact(const size_t level);
+  void compact_full_levels();
+
+  conduit::int64 m_capacity;
+  conduit::int64 m_count;
+  double m_rank_error;
+  std::vector<std::vector<double>> m_levels;
+  // which half a level keeps on its next compaction
+  std::vector<int> m_offsets;
+};
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
+
+
+#endif
+//-----------------------------------------------------------------------------
+// -- end header ifdef guard
+//-----------------------------------------------------------------------------
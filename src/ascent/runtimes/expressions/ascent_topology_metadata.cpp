@@ -0,0 +1,772 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_topology_metadata.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "ascent_topology_metadata.hpp"
+#include "ascent_conduit_reductions.hpp"
+
+#include <ascent_config.h>
+#include <ascent_logging.hpp>
+#include <flow_workspace.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+
+#ifdef ASCENT_MPI_ENABLED
+#include <conduit_relay_mpi.hpp>
+#include <mpi.h>
+#endif
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime --
+//-----------------------------------------------------------------------------
+namespace runtime
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+namespace expressions
+{
+
+namespace detail
+{
+
+struct MetadataCacheEntry
+{
+  std::weak_ptr<conduit::Node> m_dataset;
+  std::shared_ptr<TopologyMetadata> m_metadata;
+};
+
+std::map<const conduit::Node *, MetadataCacheEntry> &
+metadata_cache()
+{
+  static std::map<const conduit::Node *, MetadataCacheEntry> cache;
+  return cache;
+}
+
+// gathers every rank's node as a child of res
+void
+gather_nodes(const conduit::Node &local, conduit::Node &res)
+{
+#ifdef ASCENT_MPI_ENABLED
+  MPI_Comm mpi_comm = MPI_Comm_f2c(flow::Workspace::default_mpi_comm());
+  conduit::relay::mpi::all_gather_using_schema(local, res, mpi_comm);
+#else
+  res.append() = local;
+#endif
+}
+
+// vertices per element of single shape unstructured topologies
+int
+shape_indices(const std::string &shape)
+{
+  if(shape == "point")
+  {
+    return 1;
+  }
+  if(shape == "line")
+  {
+    return 2;
+  }
+  if(shape == "tri")
+  {
+    return 3;
+  }
+  if(shape == "quad" || shape == "tet")
+  {
+    return 4;
+  }
+  if(shape == "hex")
+  {
+    return 8;
+  }
+  return 0;
+}
+
+conduit::index_t
+count_points(const conduit::Node &domain, const std::string &topo_name)
+{
+  const conduit::Node &n_topo = domain["topologies/" + topo_name];
+  const std::string c_name = n_topo["coordset"].as_string();
+  const conduit::Node &n_coords = domain["coordsets/" + c_name];
+  const std::string c_type = n_coords["type"].as_string();
+
+  conduit::index_t res = 0;
+  if(c_type == "uniform")
+  {
+    res = n_coords["dims/i"].to_index_t();
+    if(n_coords.has_path("dims/j"))
+    {
+      res *= n_coords["dims/j"].to_index_t();
+    }
+    if(n_coords.has_path("dims/k"))
+    {
+      res *= n_coords["dims/k"].to_index_t();
+    }
+  }
+  else if(c_type == "rectilinear")
+  {
+    res = n_coords["values"].child(0).dtype().number_of_elements();
+    for(int a = 1; a < n_coords["values"].number_of_children(); ++a)
+    {
+      res *= n_coords["values"].child(a).dtype().number_of_elements();
+    }
+  }
+  else if(c_type == "explicit")
+  {
+    res = n_coords["values"].child(0).dtype().number_of_elements();
+  }
+  return res;
+}
+
+conduit::index_t
+count_cells(const conduit::Node &domain, const std::string &topo_name)
+{
+  const conduit::Node &n_topo = domain["topologies/" + topo_name];
+  const std::string topo_type = n_topo["type"].as_string();
+
+  if(topo_type == "points")
+  {
+    return count_points(domain, topo_name);
+  }
+
+  conduit::index_t res = 0;
+  if(topo_type == "unstructured")
+  {
+    const conduit::Node &n_elements = n_topo["elements"];
+    // polygonal, polyhedral, and mixed shapes list the size or shape of
+    // every element
+    if(n_elements.has_child("sizes"))
+    {
+      res = n_elements["sizes"].dtype().number_of_elements();
+    }
+    else if(n_elements.has_child("shapes"))
+    {
+      res = n_elements["shapes"].dtype().number_of_elements();
+    }
+    else
+    {
+      const int per_cell = shape_indices(n_elements["shape"].as_string());
+      if(per_cell > 0)
+      {
+        res = n_elements["connectivity"].dtype().number_of_elements() /
+              per_cell;
+      }
+    }
+    return res;
+  }
+
+  const std::string c_name = n_topo["coordset"].as_string();
+  const conduit::Node &n_coords = domain["coordsets/" + c_name];
+
+  if(topo_type == "uniform")
+  {
+    res = n_coords["dims/i"].to_index_t() - 1;
+    if(n_coords.has_path("dims/j"))
+    {
+      res *= n_coords["dims/j"].to_index_t() - 1;
+    }
+    if(n_coords.has_path("dims/k"))
+    {
+      res *= n_coords["dims/k"].to_index_t() - 1;
+    }
+  }
+  else if(topo_type == "rectilinear")
+  {
+    res = n_coords["values"].child(0).dtype().number_of_elements() - 1;
+    for(int a = 1; a < n_coords["values"].number_of_children(); ++a)
+    {
+      res *= n_coords["values"].child(a).dtype().number_of_elements() - 1;
+    }
+  }
+  else if(topo_type == "structured")
+  {
+    res = n_topo["elements/dims/i"].to_index_t();
+    if(n_topo.has_path("elements/dims/j"))
+    {
+      res *= n_topo["elements/dims/j"].to_index_t();
+    }
+    if(n_topo.has_path("elements/dims/k"))
+    {
+      res *= n_topo["elements/dims/k"].to_index_t();
+    }
+  }
+  return res;
+}
+
+// grows bounds (min x, min y, min z, max x, max y, max z) by the
+// coordinates of the topology
+void
+include_bounds(const conduit::Node &domain,
+               const std::string &topo_name,
+               double *bounds)
+{
+  const conduit::Node &n_topo = domain["topologies/" + topo_name];
+  const std::string c_name = n_topo["coordset"].as_string();
+  const conduit::Node &n_coords = domain["coordsets/" + c_name];
+  const std::string c_type = n_coords["type"].as_string();
+  const std::string axes[3][3] = {
+      {"x", "i", "dx"}, {"y", "j", "dy"}, {"z", "k", "dz"}};
+
+  if(c_type == "uniform")
+  {
+    for(int a = 0; a < 3; ++a)
+    {
+      if(!n_coords.has_path("dims/" + axes[a][1]))
+      {
+        continue;
+      }
+      const double dim = n_coords["dims/" + axes[a][1]].to_float64();
+      double origin = 0.;
+      double spacing = 1.;
+      if(n_coords.has_path("origin/" + axes[a][0]))
+      {
+        origin = n_coords["origin/" + axes[a][0]].to_float64();
+      }
+      if(n_coords.has_path("spacing/" + axes[a][2]))
+      {
+        spacing = n_coords["spacing/" + axes[a][2]].to_float64();
+      }
+      const double end = origin + (dim - 1.) * spacing;
+      bounds[a] = std::min(bounds[a], std::min(origin, end));
+      bounds[3 + a] = std::max(bounds[3 + a], std::max(origin, end));
+    }
+  }
+  else if(c_type == "rectilinear" || c_type == "explicit")
+  {
+    for(int a = 0; a < 3; ++a)
+    {
+      const std::string axis_path = "values/" + axes[a][0];
+      if(!n_coords.has_path(axis_path) ||
+         n_coords[axis_path].dtype().number_of_elements() == 0)
+      {
+        continue;
+      }
+      bounds[a] = std::min(bounds[a],
+                           array_min(n_coords[axis_path])["value"].to_float64());
+      bounds[3 + a] = std::max(
+          bounds[3 + a], array_max(n_coords[axis_path])["value"].to_float64());
+    }
+  }
+  else
+  {
+    ASCENT_ERROR("Topology metadata: unknown coordinate set type '"
+                 << c_type << "'");
+  }
+}
+
+} // namespace detail
+
+TopologyMetadata::TopologyMetadata(const conduit::Node &dataset)
+  : m_dataset(dataset),
+    m_has_global(false)
+{
+}
+
+std::shared_ptr<TopologyMetadata>
+TopologyMetadata::get(std::shared_ptr<conduit::Node> dataset)
+{
+  static std::mutex cache_mutex;
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  auto &cache = detail::metadata_cache();
+  // drop the metadata of data sets that are gone
+  for(auto it = cache.begin(); it != cache.end();)
+  {
+    if(it->second.m_dataset.expired())
+    {
+      it = cache.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+
+  detail::MetadataCacheEntry &entry = cache[dataset.get()];
+  if(entry.m_metadata == nullptr || entry.m_dataset.lock() != dataset)
+  {
+    entry.m_dataset = dataset;
+    entry.m_metadata = std::make_shared<TopologyMetadata>(*dataset);
+  }
+  return entry.m_metadata;
+}
+
+const conduit::Node &
+TopologyMetadata::dataset() const
+{
+  return m_dataset;
+}
+
+TopologyMetadata::DomainTopology *
+TopologyMetadata::domain_topology(const int domain,
+                                  const std::string &topo_name) const
+{
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  const int num_domains = m_dataset.number_of_children();
+  if(domain < 0 || domain >= num_domains)
+  {
+    return nullptr;
+  }
+  const conduit::Node &dom = m_dataset.child(domain);
+  if(!dom.has_path("topologies/" + topo_name))
+  {
+    return nullptr;
+  }
+  std::vector<DomainTopology> &domains = m_domains[topo_name];
+  if(domains.empty())
+  {
+    domains.resize(num_domains);
+  }
+  DomainTopology &dom_topo = domains[domain];
+  if(dom_topo.m_locator == nullptr)
+  {
+    dom_topo.m_locator = std::make_shared<DomainLocator>(dom, topo_name);
+  }
+  return &dom_topo;
+}
+
+const DomainLocator *
+TopologyMetadata::locator(const int domain, const std::string &topo_name) const
+{
+  DomainTopology *dom_topo = domain_topology(domain, topo_name);
+  return dom_topo == nullptr ? nullptr : dom_topo->m_locator.get();
+}
+
+conduit::index_t
+TopologyMetadata::num_points(const int domain,
+                             const std::string &topo_name) const
+{
+  if(domain < 0 || domain >= m_dataset.number_of_children() ||
+     !m_dataset.child(domain).has_path("topologies/" + topo_name))
+  {
+    return 0;
+  }
+  return detail::count_points(m_dataset.child(domain), topo_name);
+}
+
+conduit::index_t
+TopologyMetadata::num_cells(const int domain,
+                            const std::string &topo_name) const
+{
+  if(domain < 0 || domain >= m_dataset.number_of_children() ||
+     !m_dataset.child(domain).has_path("topologies/" + topo_name))
+  {
+    return 0;
+  }
+  return detail::count_cells(m_dataset.child(domain), topo_name);
+}
+
+const std::vector<double> &
+TopologyMetadata::centroids(const int domain,
+                            const std::string &topo_name) const
+{
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  static const std::vector<double> empty;
+  DomainTopology *dom_topo = domain_topology(domain, topo_name);
+  if(dom_topo == nullptr)
+  {
+    return empty;
+  }
+  if(!dom_topo->m_has_centroids)
+  {
+    const DomainLocator &dom_locator = *dom_topo->m_locator;
+    const int num_cells = dom_locator.num_elements();
+    std::vector<double> &centroids = dom_topo->m_centroids;
+    centroids.resize(num_cells * 3);
+#ifdef ASCENT_USE_OPENMP
+#pragma omp parallel for
+#endif
+    for(int i = 0; i < num_cells; ++i)
+    {
+      dom_locator.element(i, &centroids[i * 3]);
+    }
+    dom_topo->m_has_centroids = true;
+  }
+  return dom_topo->m_centroids;
+}
+
+void
+TopologyMetadata::compute_global() const
+{
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  if(m_has_global)
+  {
+    return;
+  }
+
+  // the local part of every topology
+  conduit::Node local;
+  const int num_domains = m_dataset.number_of_children();
+  for(int d = 0; d < num_domains; ++d)
+  {
+    const conduit::Node &dom = m_dataset.child(d);
+    if(!dom.has_path("topologies"))
+    {
+      continue;
+    }
+    const std::vector<std::string> topo_names =
+        dom["topologies"].child_names();
+    for(const std::string &topo_name : topo_names)
+    {
+      conduit::Node &n_topo = local[topo_name];
+      if(!n_topo.has_path("bounds"))
+      {
+        n_topo["bounds"].set(conduit::DataType::float64(6));
+        double *bounds = n_topo["bounds"].value();
+        for(int a = 0; a < 3; ++a)
+        {
+          bounds[a] = std::numeric_limits<double>::max();
+          bounds[3 + a] = std::numeric_limits<double>::lowest();
+        }
+        n_topo["num_points"] = conduit::int64(0);
+        n_topo["num_cells"] = conduit::int64(0);
+      }
+
+      // counted from the topology and coordinate set, locators are only
+      // built for queries that need positions
+      detail::include_bounds(dom, topo_name, n_topo["bounds"].value());
+      n_topo["num_points"] = n_topo["num_points"].to_int64() +
+                             detail::count_points(dom, topo_name);
+      n_topo["num_cells"] = n_topo["num_cells"].to_int64() +
+                            detail::count_cells(dom, topo_name);
+    }
+  }
+
+  // one exchange for all of the topologies
+  conduit::Node gathered;
+  detail::gather_nodes(local, gathered);
+
+  m_global.reset();
+  const int num_ranks = gathered.number_of_children();
+  for(int r = 0; r < num_ranks; ++r)
+  {
+    const conduit::Node &rank_topos = gathered.child(r);
+    const int num_topos = rank_topos.number_of_children();
+    for(int t = 0; t < num_topos; ++t)
+    {
+      const conduit::Node &n_rank_topo = rank_topos.child(t);
+      const double *rank_bounds = n_rank_topo["bounds"].as_float64_ptr();
+      conduit::Node &n_topo = m_global[n_rank_topo.name()];
+      if(!n_topo.has_path("bounds"))
+      {
+        n_topo = n_rank_topo;
+        continue;
+      }
+      double *bounds = n_topo["bounds"].value();
+      for(int a = 0; a < 3; ++a)
+      {
+        bounds[a] = std::min(bounds[a], rank_bounds[a]);
+        bounds[3 + a] = std::max(bounds[3 + a], rank_bounds[3 + a]);
+      }
+      n_topo["num_points"] = n_topo["num_points"].to_int64() +
+                             n_rank_topo["num_points"].to_int64();
+      n_topo["num_cells"] = n_topo["num_cells"].to_int64() +
+                            n_rank_topo["num_cells"].to_int64();
+    }
+  }
+  m_has_global = true;
+}
+
+std::set<std::string>
+TopologyMetadata::topology_names() const
+{
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  compute_global();
+  const std::vector<std::string> names = m_global.child_names();
+  return std::set<std::string>(names.begin(), names.end());
+}
+
+bool
+TopologyMetadata::has_topology(const std::string &topo_name) const
+{
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  compute_global();
+  return m_global.has_child(topo_name);
+}
+
+conduit::Node
+TopologyMetadata::global_bounds(const std::string &topo_name) const
+{
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  compute_global();
+  double bounds[6];
+  for(int a = 0; a < 3; ++a)
+  {
+    bounds[a] = std::numeric_limits<double>::max();
+    bounds[3 + a] = std::numeric_limits<double>::lowest();
+  }
+  if(m_global.has_child(topo_name))
+  {
+    const double *topo_bounds = m_global[topo_name]["bounds"].as_float64_ptr();
+    std::copy(topo_bounds, topo_bounds + 6, bounds);
+  }
+
+  conduit::Node res;
+  res["min_coords"].set(bounds, 3);
+  res["max_coords"].set(bounds + 3, 3);
+  return res;
+}
+
+conduit::index_t
+TopologyMetadata::global_num_points(const std::string &topo_name) const
+{
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  compute_global();
+  if(!m_global.has_child(topo_name))
+  {
+    return 0;
+  }
+  return m_global[topo_name]["num_points"].to_int64();
+}
+
+conduit::index_t
+TopologyMetadata::global_num_cells(const std::string &topo_name) const
+{
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  compute_global();
+  if(!m_global.has_child(topo_name))
+  {
+    return 0;
+  }
+  return m_global[topo_name]["num_cells"].to_int64();
+}
+
+conduit::Node
+TopologyMetadata::topo_and_assoc(const std::vector<std::string> &var_names) const
+{
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  // exchange what this rank knows about the fields not seen before
+  conduit::Node local;
+  for(const std::string &var_name : var_names)
+  {
+    if(m_fields.has_child(var_name) || local.has_child(var_name))
+    {
+      continue;
+    }
+    conduit::Node &n_field = local[var_name];
+    n_field["found"] = 0;
+    n_field["topology"] = "";
+    n_field["association"] = "";
+    n_field["mixed_topology"] = 0;
+    n_field["mixed_association"] = 0;
+    const int num_domains = m_dataset.number_of_children();
+    for(int d = 0; d < num_domains; ++d)
+    {
+      const conduit::Node &dom = m_dataset.child(d);
+      if(!dom.has_path("fields/" + var_name))
+      {
+        continue;
+      }
+      const conduit::Node &n_dom_field = dom["fields/" + var_name];
+      const std::string topo_name = n_dom_field["topology"].as_string();
+      const std::string assoc_str = n_dom_field["association"].as_string();
+      if(n_field["found"].to_int32() == 0)
+      {
+        n_field["found"] = 1;
+        n_field["topology"] = topo_name;
+        n_field["association"] = assoc_str;
+      }
+      if(n_field["topology"].as_string() != topo_name)
+      {
+        n_field["mixed_topology"] = 1;
+      }
+      if(n_field["association"].as_string() != assoc_str)
+      {
+        n_field["mixed_association"] = 1;
+      }
+    }
+  }
+
+  // every rank asks for the same fields, so they agree on this. Fields
+  // that no rank has are not kept, so they are looked up again the next
+  // time they are asked about.
+  conduit::Node fields;
+  if(local.number_of_children() > 0)
+  {
+    conduit::Node gathered;
+    detail::gather_nodes(local, gathered);
+    const int num_ranks = gathered.number_of_children();
+    for(int r = 0; r < num_ranks; ++r)
+    {
+      const conduit::Node &rank_fields = gathered.child(r);
+      const int num_fields = rank_fields.number_of_children();
+      for(int f = 0; f < num_fields; ++f)
+      {
+        const conduit::Node &n_rank_field = rank_fields.child(f);
+        conduit::Node &n_field = fields.add_child(n_rank_field.name());
+        if(!n_field.has_child("found") || n_field["found"].to_int32() == 0)
+        {
+          n_field = n_rank_field;
+          continue;
+        }
+        if(n_rank_field["found"].to_int32() == 0)
+        {
+          continue;
+        }
+        if(n_rank_field["mixed_topology"].to_int32() == 1 ||
+           n_field["topology"].as_string() !=
+               n_rank_field["topology"].as_string())
+        {
+          n_field["mixed_topology"] = 1;
+        }
+        if(n_rank_field["mixed_association"].to_int32() == 1 ||
+           n_field["association"].as_string() !=
+               n_rank_field["association"].as_string())
+        {
+          n_field["mixed_association"] = 1;
+        }
+      }
+    }
+    const int num_fields = fields.number_of_children();
+    for(int f = 0; f < num_fields; ++f)
+    {
+      const conduit::Node &n_field = fields.child(f);
+      if(n_field["found"].to_int32() == 1)
+      {
+        m_fields.add_child(n_field.name()) = n_field;
+      }
+    }
+  }
+
+  std::string assoc_str;
+  std::string topo_name;
+  bool error = false;
+  conduit::Node error_msg;
+  for(const std::string &var_name : var_names)
+  {
+    if(!m_fields.has_child(var_name))
+    {
+      continue;
+    }
+    const conduit::Node &n_field = m_fields.child(var_name);
+    const std::string field_assoc = n_field["association"].as_string();
+    const std::string field_topo = n_field["topology"].as_string();
+    if(n_field["mixed_association"].to_int32() == 1 ||
+       (!assoc_str.empty() && assoc_str != field_assoc))
+    {
+      error_msg.append() = "All Binning fields must have the same association.";
+      error = true;
+    }
+    if(n_field["mixed_topology"].to_int32() == 1 ||
+       (!topo_name.empty() && topo_name != field_topo))
+    {
+      error_msg.append() = "All Binning fields must have the same topology.";
+      error = true;
+    }
+    if(assoc_str.empty())
+    {
+      assoc_str = field_assoc;
+      topo_name = field_topo;
+    }
+  }
+
+  if(assoc_str.empty())
+  {
+    error_msg.append() = "Could not determine the associate from the given "
+                         "reduction_var and axes. Try supplying a field.";
+    error = true;
+  }
+  else if(assoc_str != "vertex" && assoc_str != "element")
+  {
+    error_msg.append() = "Unknown association: '"
+                       + assoc_str
+                       + "'. Binning only supports vertex and element association.";
+    error = true;
+  }
+
+  if(error)
+  {
+    ASCENT_ERROR(error_msg.to_yaml());
+  }
+
+  conduit::Node res;
+  res["topo_name"] = topo_name;
+  res["assoc_str"] = assoc_str;
+  return res;
+}
+
+conduit::index_t
+TopologyMetadata::size_in_bytes() const
+{
+  std::lock_guard<std::recursive_mutex> lock(m_mutex);
+  conduit::index_t res = m_global.total_bytes_compact() +
+                         m_fields.total_bytes_compact();
+  for(const auto &topo : m_domains)
+  {
+    for(const DomainTopology &dom_topo : topo.second)
+    {
+      res += dom_topo.m_centroids.capacity() * sizeof(double);
+    }
+  }
+  return res;
+}
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
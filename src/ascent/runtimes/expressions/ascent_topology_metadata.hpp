@@ -0,0 +1,185 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_topology_metadata.hpp
+///
+//-----------------------------------------------------------------------------
+
+#ifndef ASCENT_TOPOLOGY_METADATA
+#define ASCENT_TOPOLOGY_METADATA
+
+#include <ascent_exports.h>
+#include <conduit.hpp>
+
+#include "ascent_point_locator.hpp"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime --
+//-----------------------------------------------------------------------------
+namespace runtime
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+namespace expressions
+{
+
+//
+// Geometric metadata of the topologies of a multi-domain data set.
+//
+// Per domain point and cell counts come from the topology and coordinate
+// set. Locators and cell centroids are built the first time they are
+// asked for. The global bounds and counts of every topology are gathered
+// in a single exchange the first time any of them is needed, and the
+// topology and association of a field are exchanged until some rank has
+// the field.
+//
+class ASCENT_API TopologyMetadata
+{
+public:
+  TopologyMetadata(const conduit::Node &dataset);
+
+  // metadata shared by everyone asking about the same data set. A newly
+  // published data set gets new metadata.
+  static std::shared_ptr<TopologyMetadata>
+  get(std::shared_ptr<conduit::Node> dataset);
+
+  const conduit::Node &dataset() const;
+
+  //
+  // local queries, domain is the child index in the data set
+  //
+
+  // nullptr if the domain does not have the topology
+  const DomainLocator *locator(const int domain,
+                               const std::string &topo_name) const;
+  conduit::index_t num_points(const int domain,
+                              const std::string &topo_name) const;
+  conduit::index_t num_cells(const int domain,
+                             const std::string &topo_name) const;
+  // (x, y, z) of every cell
+  const std::vector<double> &centroids(const int domain,
+                                       const std::string &topo_name) const;
+
+  //
+  // global queries, the first one issued is collective
+  //
+
+  std::set<std::string> topology_names() const;
+  bool has_topology(const std::string &topo_name) const;
+  // min_coords and max_coords of the topology over all ranks. Axes the
+  // topology does not have keep the limits of double.
+  conduit::Node global_bounds(const std::string &topo_name) const;
+  conduit::index_t global_num_points(const std::string &topo_name) const;
+  conduit::index_t global_num_cells(const std::string &topo_name) const;
+
+  // topo_name and assoc_str shared by the fields (collective for fields
+  // not found before). Raises an error when they differ.
+  conduit::Node topo_and_assoc(const std::vector<std::string> &var_names) const;
+
+  // local memory held by the metadata
+  conduit::index_t size_in_bytes() const;
+
+private:
+  struct DomainTopology
+  {
+    std::shared_ptr<DomainLocator> m_locator;
+    std::vector<double> m_centroids;
+    bool m_has_centroids = false;
+  };
+
+  DomainTopology *domain_topology(const int domain,
+                                  const std::string &topo_name) const;
+  void compute_global() const;
+
+  const conduit::Node &m_dataset;
+  mutable std::map<std::string, std::vector<DomainTopology>> m_domains;
+  mutable bool m_has_global;
+  // topology name -> bounds, num_points, num_cells
+  mutable conduit::Node m_global;
+  // field name -> topology, association (only fields that were found)
+  mutable conduit::Node m_fields;
+  // the lazily computed members are filled in under this, metadata is
+  // shared between expressions that may be evaluated concurrently
+  mutable std::recursive_mutex m_mutex;
+};
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::expressions--
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
+
+
+#endif
+//-----------------------------------------------------------------------------
+// -- end header ifdef guard
+//-----------------------------------------------------------------------------
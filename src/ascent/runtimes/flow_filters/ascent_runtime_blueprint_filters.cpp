@@ -69,6 +69,7 @@
 #include <ascent_runtime_param_check.hpp>
 #include "expressions/ascent_expression_filters.hpp"
 #include "expressions/ascent_blueprint_architect.hpp"
+#include "expressions/ascent_topology_metadata.hpp"
 #include <flow_graph.hpp>
 #include <flow_workspace.hpp>
 
@@ -397,28 +398,32 @@ DataBinning::execute()
 
     conduit::Node n_binning;
     conduit::Node n_output_axes;
+    // bin index of every value, reused to paint the bins on the mesh
+    conduit::Node n_homes;
 
     expressions::binning_interface(var,
                                    reduction_op,
                                    n_empty_bin_val,
                                    n_component,
                                    n_axes,
-                                   *n_input.get(),
+                                   *d_input->topology_metadata(),
                                    n_binning,
-                                   n_output_axes);
+                                   n_output_axes,
+                                   output_type == "mesh" ? &n_homes : nullptr);
 
 
 
   // setup the input to the painting functions
   conduit::Node mesh_in;
   mesh_in["type"] = "binning";
-  mesh_in["attrs/value/value"] = n_binning["value"];
+  // n_binning and n_output_axes outlive mesh_in, so don't copy the bins
+  mesh_in["attrs/value/value"].set_external(n_binning["value"]);
   mesh_in["attrs/value/type"] = "array";
   mesh_in["attrs/reduction_var/value"] = var;
   mesh_in["attrs/reduction_var/type"] = "string";
   mesh_in["attrs/reduction_op/value"] = reduction_op;
   mesh_in["attrs/reduction_op/type"] = "string";
-  mesh_in["attrs/bin_axes/value"] = n_output_axes;
+  mesh_in["attrs/bin_axes/value"].set_external(n_output_axes);
   mesh_in["attrs/association/value"] = n_binning["association"];
   mesh_in["attrs/association/type"] = "string";
 
@@ -466,7 +471,7 @@ DataBinning::execute()
     // we don't copy anything extra
     DataObject  *d_output = new DataObject();
     d_output->reset(n_input);
-    expressions::paint_binning(mesh_in, *n_input.get(), output_field);
+    expressions::paint_binning(mesh_in, *n_input.get(), output_field, &n_homes);
     set_output<DataObject>(d_output);
   }
   else
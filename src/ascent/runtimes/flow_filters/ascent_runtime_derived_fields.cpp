@@ -0,0 +1,233 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_runtime_derived_fields.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "ascent_runtime_derived_fields.hpp"
+
+#include <ascent_logging.hpp>
+#include <vtkm/cont/Field.h>
+
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime --
+//-----------------------------------------------------------------------------
+namespace runtime
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::filters --
+//-----------------------------------------------------------------------------
+namespace filters
+{
+
+//-----------------------------------------------------------------------------
+DerivedFieldTable::DerivedFieldTable()
+  : m_computed(0),
+    m_reused(0)
+{
+}
+
+//-----------------------------------------------------------------------------
+VTKHCollection *
+DerivedFieldTable::add(std::shared_ptr<VTKHCollection> collection,
+                       const std::string &topology,
+                       const std::string &operation,
+                       const std::map<std::string,std::string> &outputs,
+                       const DerivedFieldCompute &compute)
+{
+  vtkh::DataSet &input = collection->dataset_by_topology(topology);
+  const vtkm::Id num_domains = input.GetNumberOfDomains();
+
+  const std::string op_key = topology + "/" + operation;
+  const auto key = std::make_pair(static_cast<const VTKHCollection*>(collection.get()),
+                                  op_key);
+
+  Entry &entry = m_entries[key];
+  if(entry.m_collection.lock() != collection ||
+     static_cast<vtkm::Id>(entry.m_domains.size()) != num_domains)
+  {
+    entry.m_collection = collection;
+    entry.m_quantities.clear();
+    entry.m_domains.clear();
+    entry.m_domains.resize(num_domains);
+  }
+
+  std::set<std::string> &requested = m_requested[op_key];
+  std::set<std::string> missing;
+  for(const auto &output : outputs)
+  {
+    requested.insert(output.first);
+    if(entry.m_quantities.count(output.first) == 0)
+    {
+      missing.insert(output.first);
+    }
+  }
+
+  if(missing.empty())
+  {
+    m_reused++;
+  }
+  else
+  {
+    // compute everything asked for of this operation in the last
+    // execute in the same pass, since it is likely to be asked for again
+    for(const std::string &quantity : m_expected[op_key])
+    {
+      if(entry.m_quantities.count(quantity) == 0)
+      {
+        missing.insert(quantity);
+      }
+    }
+
+    vtkh::DataSet *derived = compute(input, missing);
+    if(derived->GetNumberOfDomains() != num_domains)
+    {
+      delete derived;
+      ASCENT_ERROR("Derived fields '"<<operation<<"': expected "
+                   <<num_domains<<" domains");
+    }
+
+    for(vtkm::Id d = 0; d < num_domains; ++d)
+    {
+      vtkm::cont::DataSet dom;
+      vtkm::Id domain_id;
+      derived->GetDomain(d, dom, domain_id);
+      for(const std::string &quantity : missing)
+      {
+        if(!dom.HasField(quantity))
+        {
+          delete derived;
+          ASCENT_ERROR("Derived fields '"<<operation<<"': quantity '"
+                       <<quantity<<"' was not computed");
+        }
+        entry.m_domains[d].emplace(quantity, dom.GetField(quantity));
+      }
+    }
+    delete derived;
+
+    entry.m_quantities.insert(missing.begin(), missing.end());
+    m_computed++;
+  }
+
+  // the input data set with the requested quantities under their
+  // output names
+  vtkh::DataSet result;
+  result.SetCycle(input.GetCycle());
+  for(vtkm::Id d = 0; d < num_domains; ++d)
+  {
+    vtkm::cont::DataSet dom;
+    vtkm::Id domain_id;
+    input.GetDomain(d, dom, domain_id);
+    for(const auto &output : outputs)
+    {
+      const vtkm::cont::Field &field = entry.m_domains[d].at(output.first);
+      dom.AddField(vtkm::cont::Field(output.second,
+                                     field.GetAssociation(),
+                                     field.GetData()));
+    }
+    result.AddDomain(dom, domain_id);
+  }
+
+  VTKHCollection *new_coll = collection->copy_without_topology(topology);
+  new_coll->add(result, topology);
+  return new_coll;
+}
+
+//-----------------------------------------------------------------------------
+void
+DerivedFieldTable::reset()
+{
+  m_entries.clear();
+  m_expected.swap(m_requested);
+  m_requested.clear();
+  m_computed = 0;
+  m_reused = 0;
+}
+
+//-----------------------------------------------------------------------------
+void
+DerivedFieldTable::release()
+{
+  m_entries.clear();
+}
+
+//-----------------------------------------------------------------------------
+void
+DerivedFieldTable::info(conduit::Node &info) const
+{
+  info["computed"] = m_computed;
+  info["reused"] = m_reused;
+}
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::filters --
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime --
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
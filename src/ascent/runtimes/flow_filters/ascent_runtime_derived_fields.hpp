@@ -0,0 +1,168 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_runtime_derived_fields.hpp
+///
+//-----------------------------------------------------------------------------
+
+#ifndef ASCENT_RUNTIME_DERIVED_FIELDS_HPP
+#define ASCENT_RUNTIME_DERIVED_FIELDS_HPP
+
+#include <ascent_exports.h>
+#include <ascent_vtkh_collection.hpp>
+#include <conduit.hpp>
+#include <vtkm/cont/Field.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime --
+//-----------------------------------------------------------------------------
+namespace runtime
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::filters --
+//-----------------------------------------------------------------------------
+namespace filters
+{
+
+// computes the named quantities on the input data set and returns a
+// new data set holding them as fields with the same names
+using DerivedFieldCompute =
+  std::function<vtkh::DataSet*(vtkh::DataSet &input,
+                               const std::set<std::string> &quantities)>;
+
+//
+// Fields derived from a topology of a collection (vector magnitudes,
+// composite vectors and quantities of the gradient) are cached for the
+// rest of the execute. Pipelines that derive the same field from the same
+// input share one computation, whatever they name the result.
+//
+// An operation may produce several named quantities in one pass. The
+// quantities requested for an operation are remembered from one execute
+// to the next, and a miss computes all of them at once.
+//
+// Each runtime owns a table and registers it in its workspace as
+// "derived_fields", where filters fetch it from.
+//
+class ASCENT_API DerivedFieldTable
+{
+public:
+  DerivedFieldTable();
+
+  // returns a shallow copy of the collection where 'topology' carries the
+  // requested quantities of 'operation' (quantity -> output field name).
+  // 'operation' must identify the inputs and parameters of the computation.
+  VTKHCollection *add(std::shared_ptr<VTKHCollection> collection,
+                      const std::string &topology,
+                      const std::string &operation,
+                      const std::map<std::string,std::string> &outputs,
+                      const DerivedFieldCompute &compute);
+
+  // clears the cached fields and the counts (called at the start of
+  // each execute)
+  void reset();
+
+  // frees the cached fields once the execute is done with them
+  void release();
+
+  // number of derived field computations and cache hits in this execute
+  void info(conduit::Node &info) const;
+
+private:
+  struct Entry
+  {
+    // the collection the fields were derived from. A dead pointer
+    // means the address may have been reused by another collection.
+    std::weak_ptr<VTKHCollection> m_collection;
+    std::set<std::string> m_quantities;
+    // quantity -> field, for each local domain
+    std::vector<std::map<std::string, vtkm::cont::Field>> m_domains;
+  };
+
+  std::map<std::pair<const VTKHCollection*, std::string>, Entry> m_entries;
+  // quantities asked for of each operation in this and the last execute
+  std::map<std::string, std::set<std::string>> m_requested;
+  std::map<std::string, std::set<std::string>> m_expected;
+  conduit::index_t m_computed;
+  conduit::index_t m_reused;
+};
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::filters --
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime --
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
+
+#endif
+//-----------------------------------------------------------------------------
+// -- end header ifdef guard
+//-----------------------------------------------------------------------------
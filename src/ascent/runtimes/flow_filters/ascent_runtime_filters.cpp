@@ -143,6 +143,7 @@ register_builtin()
     AscentRuntime::register_filter_type<VTKHThreshold>("transforms","threshold");
     AscentRuntime::register_filter_type<VTKHSlice>("transforms","slice");
     AscentRuntime::register_filter_type<VTKH3Slice>("transforms","3slice");
+    AscentRuntime::register_filter_type<VTKHCut>("transforms","cut");
     AscentRuntime::register_filter_type<VTKHCompositeVector>("transforms","composite_vector");
     AscentRuntime::register_filter_type<VTKHVectorComponent>("transforms","vector_component");
     AscentRuntime::register_filter_type<VTKHNoOp>("transforms","noop");
@@ -57,6 +57,8 @@
 #include <ascent_logging.hpp>
 
 #include <algorithm>
+#include <map>
+#include <memory>
 
 using namespace conduit;
 
@@ -85,7 +87,7 @@ bool is_valid_expression(const std::string expr, std::string &err_msg)
   bool res = true;
   try
   {
-    scan_string(expr.c_str());
+    delete parse_expression(expr.c_str());
   }
   catch(const char *msg)
   {
@@ -300,6 +302,78 @@ float conduit_cast<float>(const conduit::Node &node)
   return node.to_float32();
 }
 
+namespace detail
+{
+
+thread_local ExpressionParamMemo *t_param_memo = nullptr;
+
+} // namespace detail
+
+ExpressionParamMemo::ExpressionParamMemo()
+  : m_evaluated(0),
+    m_reused(0)
+{
+}
+
+void ExpressionParamMemo::reset()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_values.clear();
+  m_evaluated = 0;
+  m_reused = 0;
+}
+
+void ExpressionParamMemo::info(conduit::Node &info) const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  info["evaluated"] = m_evaluated;
+  info["reused"] = m_reused;
+}
+
+bool ExpressionParamMemo::find(const std::shared_ptr<conduit::Node> &dataset,
+                               const std::string &expr,
+                               double &value)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto it = m_values.find(std::make_pair(static_cast<const conduit::Node*>(dataset.get()),
+                                         expr));
+  if(it == m_values.end() || it->second.m_dataset.lock() != dataset)
+  {
+    return false;
+  }
+  value = it->second.m_value;
+  m_reused++;
+  return true;
+}
+
+void ExpressionParamMemo::add(const std::shared_ptr<conduit::Node> &dataset,
+                              const std::string &expr,
+                              const double value)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Entry &entry = m_values[std::make_pair(static_cast<const conduit::Node*>(dataset.get()),
+                                         expr)];
+  entry.m_dataset = dataset;
+  entry.m_value = value;
+  m_evaluated++;
+}
+
+ExpressionParamMemo *ExpressionParamMemo::current()
+{
+  return detail::t_param_memo;
+}
+
+ExpressionParamScope::ExpressionParamScope(ExpressionParamMemo *memo)
+  : m_previous(detail::t_param_memo)
+{
+  detail::t_param_memo = memo;
+}
+
+ExpressionParamScope::~ExpressionParamScope()
+{
+  detail::t_param_memo = m_previous;
+}
+
 template<typename T>
 T get_value(const conduit::Node &node, DataObject *dataset)
 {
@@ -323,9 +397,18 @@ T get_value(const conduit::Node &node, DataObject *dataset)
 
     }
     // TODO: we want to zero copy this
-    conduit::Node * bp_dset = dataset->as_low_order_bp().get();
-    expressions::ExpressionEval eval(bp_dset);
+    std::shared_ptr<conduit::Node> bp_ptr = dataset->as_low_order_bp();
+    conduit::Node * bp_dset = bp_ptr.get();
     std::string expr = node.as_string();
+
+    ExpressionParamMemo *memo = ExpressionParamMemo::current();
+    double memo_value = 0.;
+    if(memo != nullptr && memo->find(bp_ptr, expr, memo_value))
+    {
+      return static_cast<T>(memo_value);
+    }
+
+    expressions::ExpressionEval eval(bp_dset);
     conduit::Node res = eval.evaluate(expr);
 
     if(!res.has_path("value"))
@@ -342,6 +425,11 @@ T get_value(const conduit::Node &node, DataObject *dataset)
                    <<" Expected scalar. '"<<res.to_yaml()<<"'");
     }
     value = res["value"].to_float64();
+
+    if(memo != nullptr)
+    {
+      memo->add(bp_ptr, expr, res["value"].to_float64());
+    }
   }
   else
   {
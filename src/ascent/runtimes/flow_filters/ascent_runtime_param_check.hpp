@@ -55,6 +55,8 @@
 #include <conduit.hpp>
 
 #include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -113,6 +115,66 @@ double ASCENT_API get_float64(const conduit::Node &node, DataObject *dataset);
 float ASCENT_API get_float32(const conduit::Node &node, DataObject *dataset);
 int ASCENT_API get_int32(const conduit::Node &node, DataObject *dataset);
 
+//
+// Expression values are memoized per data set, so the same expression
+// used by several filters on the same input is only evaluated once.
+// Each runtime owns a memo, resets it at the start of each execute and
+// makes it current (see ExpressionParamScope) while its filters run.
+// Without a current memo, expressions are evaluated every time.
+//
+class ASCENT_API ExpressionParamMemo
+{
+public:
+  ExpressionParamMemo();
+
+  // clears the values and the counts
+  void reset();
+  // number of expressions evaluated and reused since the last reset
+  void info(conduit::Node &info) const;
+
+  // returns true and sets value if the expression was already
+  // evaluated on this data set
+  bool find(const std::shared_ptr<conduit::Node> &dataset,
+            const std::string &expr,
+            double &value);
+  void add(const std::shared_ptr<conduit::Node> &dataset,
+           const std::string &expr,
+           const double value);
+
+  // the memo used on this thread (null if none)
+  static ExpressionParamMemo *current();
+
+private:
+  ExpressionParamMemo(const ExpressionParamMemo &);
+  ExpressionParamMemo &operator=(const ExpressionParamMemo &);
+
+  struct Entry
+  {
+    // the data set the expression was evaluated on. A dead pointer
+    // means the address may have been reused by another data set.
+    std::weak_ptr<conduit::Node> m_dataset;
+    double m_value;
+  };
+
+  mutable std::mutex m_mutex;
+  std::map<std::pair<const conduit::Node*, std::string>, Entry> m_values;
+  conduit::index_t m_evaluated;
+  conduit::index_t m_reused;
+};
+
+//
+// makes a memo current on this thread until the scope ends, then
+// restores the previous one (e.g. the memo of a trigger's parent runtime)
+//
+class ASCENT_API ExpressionParamScope
+{
+public:
+  ExpressionParamScope(ExpressionParamMemo *memo);
+  ~ExpressionParamScope();
+private:
+  ExpressionParamMemo *m_previous;
+};
+
 //-----------------------------------------------------------------------------
 };
 //-----------------------------------------------------------------------------
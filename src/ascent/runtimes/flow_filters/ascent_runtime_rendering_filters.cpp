@@ -211,10 +211,11 @@ class RendererContainer
 protected:
   std::string m_key;
   flow::Registry *m_registry;
-  // make sure the data set we need does not get deleted
-  // out from under us, which will happen
-  std::shared_ptr<VTKHCollection> m_collection;
-  std::string m_topo_name;
+  // the data set the renderer points to. This is a shallow copy of
+  // the collection's data set, with the plot's own fields (e.g. a
+  // float64 copy of an integer field, or a constant mesh field) that
+  // the shared collection should not see
+  vtkh::DataSet m_dataset;
   bool m_valid;
   // we have to keep the data object that spit out
   // the vtkh collection we are rendering since
@@ -229,20 +230,15 @@ public:
   RendererContainer(std::string key,
                     flow::Registry *r,
                     vtkh::Renderer *renderer,
-                    std::shared_ptr<VTKHCollection> collection,
-                    std::string topo_name,
+                    const vtkh::DataSet &dataset,
                     DataObject &data_object)
     : m_key(key),
       m_registry(r),
-      m_collection(collection),
-      m_topo_name(topo_name),
+      m_dataset(dataset),
       m_valid(true),
       m_data(data_object)
   {
-    // we have to keep around the dataset so we bring the
-    // whole collection with us
-    vtkh::DataSet &data = m_collection->dataset_by_topology(m_topo_name);
-    renderer->SetInput(&data);
+    renderer->SetInput(&m_dataset);
     m_registry->add<vtkh::Renderer>(m_key,renderer,1);
   }
 
@@ -1362,7 +1358,13 @@ CreatePlot::execute()
       }
     }
 
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+    // the color mapping only supports floating point fields
+    std::vector<std::string> field_names;
+    if(field_name != "")
+    {
+      field_names.push_back(field_name);
+    }
+    vtkh::DataSet data = collection->floating_point_dataset(topo_name, field_names);
 
     std::string type = params()["type"].as_string();
 
@@ -1495,8 +1497,7 @@ CreatePlot::execute()
       = new detail::RendererContainer(key,
                                       &graph().workspace().registry(),
                                       renderer,
-                                      collection,
-                                      topo_name,
+                                      data,
                                       *data_object);
 
     set_output<detail::RendererContainer>(container);
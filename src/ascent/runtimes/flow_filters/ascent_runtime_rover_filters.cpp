@@ -230,8 +230,8 @@ RoverXRay::execute()
     }
 
     std::string topo_name = collection->field_topology(field_name);
-
-    vtkh::DataSet &dataset = collection->dataset_by_topology(topo_name);
+    // rover only supports floating point fields
+    vtkh::DataSet dataset = collection->floating_point_dataset(topo_name, {field_name});
 
     vtkmCamera camera;
     camera.ResetToBounds(dataset.GetGlobalBounds());
@@ -455,8 +455,8 @@ RoverVolume::execute()
     }
 
     std::string topo_name = collection->field_topology(field_name);
-
-    vtkh::DataSet &dataset = collection->dataset_by_topology(topo_name);
+    // rover only supports floating point fields
+    vtkh::DataSet dataset = collection->floating_point_dataset(topo_name, {field_name});
 
     vtkmCamera camera;
     camera.ResetToBounds(dataset.GetGlobalBounds());
@@ -0,0 +1,182 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_runtime_scratch_arena.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "ascent_runtime_scratch_arena.hpp"
+
+#include <mutex>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime --
+//-----------------------------------------------------------------------------
+namespace runtime
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::filters --
+//-----------------------------------------------------------------------------
+namespace filters
+{
+
+namespace
+{
+
+// 1 GiB by default
+size_t global_limit_bytes = size_t(1) << 30;
+size_t global_total_bytes = 0;
+std::mutex global_mutex;
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+ScratchArena::ScratchArena()
+  : m_counted_bytes(0)
+{
+// empty
+}
+
+//-----------------------------------------------------------------------------
+ScratchArena::~ScratchArena()
+{
+  release();
+}
+
+//-----------------------------------------------------------------------------
+size_t
+ScratchArena::bytes() const
+{
+  size_t res = 0;
+  for(const auto &buffer : m_buffers)
+  {
+    res += buffer.second->bytes();
+  }
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+void
+ScratchArena::trim()
+{
+  const size_t current = bytes();
+  bool over_limit = false;
+  {
+    std::lock_guard<std::mutex> lock(global_mutex);
+    global_total_bytes -= m_counted_bytes;
+    global_total_bytes += current;
+    m_counted_bytes = current;
+    over_limit = global_total_bytes > global_limit_bytes;
+  }
+
+  if(over_limit)
+  {
+    release();
+  }
+}
+
+//-----------------------------------------------------------------------------
+void
+ScratchArena::release()
+{
+  m_buffers.clear();
+  std::lock_guard<std::mutex> lock(global_mutex);
+  global_total_bytes -= m_counted_bytes;
+  m_counted_bytes = 0;
+}
+
+//-----------------------------------------------------------------------------
+void
+ScratchArena::set_global_limit(const size_t bytes)
+{
+  std::lock_guard<std::mutex> lock(global_mutex);
+  global_limit_bytes = bytes;
+}
+
+//-----------------------------------------------------------------------------
+size_t
+ScratchArena::global_limit()
+{
+  std::lock_guard<std::mutex> lock(global_mutex);
+  return global_limit_bytes;
+}
+
+//-----------------------------------------------------------------------------
+size_t
+ScratchArena::global_bytes()
+{
+  std::lock_guard<std::mutex> lock(global_mutex);
+  return global_total_bytes;
+}
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::filters --
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime --
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
@@ -0,0 +1,172 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_runtime_scratch_arena.hpp
+///
+//-----------------------------------------------------------------------------
+
+#ifndef ASCENT_RUNTIME_SCRATCH_ARENA_HPP
+#define ASCENT_RUNTIME_SCRATCH_ARENA_HPP
+
+#include <ascent_exports.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime --
+//-----------------------------------------------------------------------------
+namespace runtime
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::filters --
+//-----------------------------------------------------------------------------
+namespace filters
+{
+
+//
+// Named scratch buffers owned by a filter instance. Filters live as long
+// as the actions do not change, so buffers requested with the same name
+// in the next execute keep their memory (and their touched pages) when
+// the size does not grow.
+//
+// trim() should be called at the end of each execute. Buffers of all
+// arenas are counted against a global limit, and an arena that pushes
+// the total over the limit frees its buffers.
+//
+class ASCENT_API ScratchArena
+{
+public:
+  ScratchArena();
+  ~ScratchArena();
+
+  // the buffer named 'name'. The caller resizes it, which does not
+  // reallocate while the size stays below the capacity.
+  template<typename T>
+  std::vector<T> &vector(const std::string &name)
+  {
+    std::unique_ptr<BufferBase> &buffer = m_buffers[name];
+    Buffer<T> *typed = dynamic_cast<Buffer<T>*>(buffer.get());
+    if(typed == nullptr)
+    {
+      typed = new Buffer<T>();
+      buffer.reset(typed);
+    }
+    return typed->m_data;
+  }
+
+  // updates the global count and releases the buffers if the
+  // global limit is exceeded
+  void trim();
+  // frees all of the buffers
+  void release();
+
+  size_t bytes() const;
+
+  // limit of the scratch memory held by all arenas (in bytes)
+  static void   set_global_limit(const size_t bytes);
+  static size_t global_limit();
+  static size_t global_bytes();
+
+private:
+  ScratchArena(const ScratchArena &);
+  ScratchArena &operator=(const ScratchArena &);
+
+  struct BufferBase
+  {
+    virtual ~BufferBase() {}
+    virtual size_t bytes() const = 0;
+  };
+
+  template<typename T>
+  struct Buffer : public BufferBase
+  {
+    virtual size_t bytes() const
+    {
+      return m_data.capacity() * sizeof(T);
+    }
+    std::vector<T> m_data;
+  };
+
+  std::map<std::string, std::unique_ptr<BufferBase>> m_buffers;
+  // bytes last counted against the global total
+  size_t m_counted_bytes;
+};
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::filters --
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime --
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
+
+#endif
+//-----------------------------------------------------------------------------
+// -- end header ifdef guard
+//-----------------------------------------------------------------------------
@@ -59,12 +59,21 @@
 #include <conduit.hpp>
 #include <conduit_blueprint.hpp>
 
+// mpi related includes
+#ifdef ASCENT_MPI_ENABLED
+#include <mpi.h>
+// -- conduit relay mpi
+#include <conduit_relay_mpi.hpp>
+#endif
+
 //-----------------------------------------------------------------------------
 // ascent includes
 //-----------------------------------------------------------------------------
 #include <ascent_expression_eval.hpp>
 #include <ascent_data_object.hpp>
 #include <ascent_logging.hpp>
+#include <ascent_main_runtime.hpp>
+#include <ascent_metadata.hpp>
 #include <ascent_runtime_param_check.hpp>
 
 #include <flow_graph.hpp>
@@ -93,10 +102,83 @@ namespace runtime
 namespace filters
 {
 
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::filters::detail --
+//-----------------------------------------------------------------------------
+namespace detail
+{
+
+//-----------------------------------------------------------------------------
+// rank 0 reads the actions file and broadcasts the result
+void
+load_actions_file(const std::string &file_name,
+                  conduit::Node &actions)
+{
+  int rank = 0;
+#ifdef ASCENT_MPI_ENABLED
+  MPI_Comm mpi_comm = MPI_Comm_f2c(Workspace::default_mpi_comm());
+  MPI_Comm_rank(mpi_comm, &rank);
+#endif
+
+  int valid = 0;
+  std::string emsg = "";
+  if(rank == 0)
+  {
+    if(!conduit::utils::is_file(file_name))
+    {
+      emsg = "file does not exist";
+    }
+    else
+    {
+      std::string curr,next;
+      std::string protocol = "json";
+      // if file ends with yaml, use yaml as proto
+      conduit::utils::rsplit_string(file_name,
+                                    ".",
+                                    curr,
+                                    next);
+      if(curr == "yaml")
+      {
+        protocol = "yaml";
+      }
+
+      try
+      {
+        actions.load(file_name, protocol);
+        valid = 1;
+      }
+      catch(conduit::Error &e)
+      {
+        emsg = e.message();
+      }
+    }
+  }
+
+#ifdef ASCENT_MPI_ENABLED
+  MPI_Bcast(&valid, 1, MPI_INT, 0, mpi_comm);
+#endif
+
+  if(valid == 0)
+  {
+    ASCENT_ERROR("Failed to load trigger actions file: "<<file_name
+                 <<"\n"<<emsg);
+  }
+
+#ifdef ASCENT_MPI_ENABLED
+  relay::mpi::broadcast_using_schema(actions, 0, mpi_comm);
+#endif
+}
+
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::filters::detail --
+//-----------------------------------------------------------------------------
 
 //-----------------------------------------------------------------------------
 BasicTrigger::BasicTrigger()
-:Filter()
+:Filter(),
+ m_runtime(nullptr),
+ m_actions_loaded(false)
 {
 // empty
 }
@@ -104,7 +186,10 @@ BasicTrigger::BasicTrigger()
 //-----------------------------------------------------------------------------
 BasicTrigger::~BasicTrigger()
 {
-// empty
+  if(m_runtime != nullptr)
+  {
+    delete m_runtime;
+  }
 }
 
 //-----------------------------------------------------------------------------
@@ -184,26 +269,10 @@ BasicTrigger::execute()
     }
 
     DataObject *data_object = input<DataObject>(0);
-    std::shared_ptr<Node> n_input = data_object->as_low_order_bp();
 
     std::string expression = params()["condition"].as_string();
 
-    bool use_actions_file = params().has_path("actions_file");
-
-    std::string actions_file = "";
-    conduit::Node actions;
-
-    if(use_actions_file)
-    {
-      actions_file = params()["actions_file"].as_string();
-    }
-    else
-    {
-      actions = params()["actions"];
-    }
-
-
-    runtime::expressions::ExpressionEval eval(n_input.get());
+    runtime::expressions::ExpressionEval eval(*data_object);
     conduit::Node res = eval.evaluate(expression);
 
     if(res["type"].as_string() != "bool")
@@ -212,20 +281,70 @@ BasicTrigger::execute()
     }
 
     bool fire = res["value"].to_uint8() != 0;
-    if(fire)
+    if(!fire)
     {
-      Ascent ascent;
+      return;
+    }
 
-      Node ascent_opts;
-      ascent_opts["runtime/type"] = "ascent";
+    // the actions only change when the graph is rebuilt, and
+    // the graph rebuild creates a new filter
+    if(!m_actions_loaded)
+    {
+      if(params().has_path("actions_file"))
+      {
+        detail::load_actions_file(params()["actions_file"].as_string(),
+                                  m_actions);
+      }
+      else
+      {
+        m_actions = params()["actions"];
+      }
+      m_actions_loaded = true;
+    }
+
+    if(m_runtime == nullptr)
+    {
+      // the child runtime uses the parent's options (native field types,
+      // memory budget, ...) except for the ones that own process wide
+      // outputs, which stay with the parent
+      Node runtime_opts;
+      if(graph().workspace().registry().has_entry("runtime_options"))
+      {
+        runtime_opts =
+          *graph().workspace().registry().fetch<Node>("runtime_options");
+      }
+      const std::string parent_only[3] = {"web", "timings", "trace"};
+      for(const std::string &opt : parent_only)
+      {
+        if(runtime_opts.has_child(opt))
+        {
+          runtime_opts.remove(opt);
+        }
+      }
 #ifdef ASCENT_MPI_ENABLED
-      ascent_opts["mpi_comm"] = Workspace::default_mpi_comm();
+      runtime_opts["mpi_comm"] = Workspace::default_mpi_comm();
 #endif
-      ascent_opts["actions_file"] = actions_file;
-      ascent.open(ascent_opts);
-      ascent.publish(*n_input);
-      ascent.execute(actions);
-      ascent.close();
+      if(Metadata::n_metadata.has_path("default_dir"))
+      {
+        runtime_opts["default_dir"] = Metadata::n_metadata["default_dir"];
+      }
+      m_runtime = new AscentRuntime();
+      m_runtime->Initialize(runtime_opts);
+    }
+
+    // execute directly on our input so the trigger reuses the
+    // published mesh and any conversions (vtkh, dray) it already holds
+    try
+    {
+      m_runtime->ExecuteDataObject(data_object, m_actions);
+    }
+    catch(conduit::Error &e)
+    {
+      // a failed trigger should not take down the parent graph
+      std::stringstream msg;
+      msg << "[Error] Trigger '"<< name() << "' "
+          << e.message() << std::endl;
+      m_runtime->DisplayError(msg.str());
     }
 }
 
@@ -63,6 +63,9 @@
 namespace ascent
 {
 
+// forward declare
+class AscentRuntime;
+
 //-----------------------------------------------------------------------------
 // -- begin ascent::runtime --
 //-----------------------------------------------------------------------------
@@ -92,6 +95,13 @@ public:
     virtual bool   verify_params(const conduit::Node &params,
                                  conduit::Node &info);
     virtual void   execute();
+private:
+    // the triggered actions run in a child runtime that lives as
+    // long as this filter, so repeated firings only pay for the
+    // triggered filters themselves
+    AscentRuntime *m_runtime;
+    conduit::Node  m_actions;
+    bool           m_actions_loaded;
 };
 
 
@@ -0,0 +1,421 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_runtime_vtkh_cutter.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "ascent_runtime_vtkh_cutter.hpp"
+#include <ascent_config.h>
+#include <ascent_logging.hpp>
+#include <ascent_runtime_vtkh_utils.hpp>
+
+#include <vtkh/filters/ClipField.hpp>
+#include <vtkh/filters/MarchingCubes.hpp>
+#include <vtkh/utils/vtkm_array_utils.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime --
+//-----------------------------------------------------------------------------
+namespace runtime
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::filters --
+//-----------------------------------------------------------------------------
+namespace filters
+{
+
+namespace detail
+{
+
+namespace
+{
+
+const std::string channel_prefix = "ascent_cut_channel_";
+
+using Vec3d = vtkm::Vec<vtkm::Float64,3>;
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+ImplicitCutter::ImplicitCutter(ScratchArena *scratch)
+  : m_evaluated(false),
+    m_scratch(scratch)
+{
+// empty
+}
+
+//-----------------------------------------------------------------------------
+int
+ImplicitCutter::add_plane(const Vec3d &point, const Vec3d &normal)
+{
+  Function func;
+  func.m_type = Function::PLANE;
+  func.m_point = point;
+  func.m_vector = normal;
+  func.m_radius = 0.;
+  m_functions.push_back(func);
+  m_evaluated = false;
+  return number_of_functions() - 1;
+}
+
+//-----------------------------------------------------------------------------
+int
+ImplicitCutter::add_sphere(const Vec3d &center, const vtkm::Float64 radius)
+{
+  Function func;
+  func.m_type = Function::SPHERE;
+  func.m_point = center;
+  func.m_vector = Vec3d(0.);
+  func.m_radius = radius;
+  m_functions.push_back(func);
+  m_evaluated = false;
+  return number_of_functions() - 1;
+}
+
+//-----------------------------------------------------------------------------
+int
+ImplicitCutter::add_box(const vtkm::Bounds &bounds)
+{
+  Function func;
+  func.m_type = Function::BOX;
+  func.m_point = Vec3d(bounds.X.Min, bounds.Y.Min, bounds.Z.Min);
+  func.m_vector = Vec3d(bounds.X.Max, bounds.Y.Max, bounds.Z.Max);
+  func.m_radius = 0.;
+  m_functions.push_back(func);
+  m_evaluated = false;
+  return number_of_functions() - 1;
+}
+
+//-----------------------------------------------------------------------------
+int
+ImplicitCutter::number_of_functions() const
+{
+  return static_cast<int>(m_functions.size());
+}
+
+//-----------------------------------------------------------------------------
+std::string
+ImplicitCutter::channel_name(const int function) const
+{
+  return channel_prefix + std::to_string(function);
+}
+
+//-----------------------------------------------------------------------------
+void
+ImplicitCutter::evaluate(vtkh::DataSet &input)
+{
+  m_input = input;
+
+  const int num_funcs = number_of_functions();
+  const Function *funcs = m_functions.data();
+
+  const vtkm::Id num_domains = input.GetNumberOfDomains();
+  m_channels.clear();
+  m_channels.resize(num_domains);
+  for(vtkm::Id d = 0; d < num_domains; ++d)
+  {
+    const vtkm::cont::DataSet &dom = input.GetDomain(d);
+
+    auto coords = dom.GetCoordinateSystem().GetData();
+    auto portal = coords.ReadPortal();
+    const vtkm::Id num_points = portal.GetNumberOfValues();
+
+    std::vector<vtkm::cont::ArrayHandle<vtkm::Float32>> channels(num_funcs);
+    std::vector<vtkm::Float32*> channel_ptrs(num_funcs);
+    for(int f = 0; f < num_funcs; ++f)
+    {
+      if(m_scratch != nullptr)
+      {
+        std::vector<vtkm::Float32> &values =
+          m_scratch->vector<vtkm::Float32>(channel_name(f) + "_" + std::to_string(d));
+        values.resize(num_points);
+        channel_ptrs[f] = values.data();
+        channels[f] = vtkm::cont::make_ArrayHandle(values.data(),
+                                                   num_points,
+                                                   vtkm::CopyFlag::Off);
+      }
+      else
+      {
+        channels[f].Allocate(num_points);
+        channel_ptrs[f] = vtkh::GetVTKMPointer(channels[f]);
+      }
+    }
+    vtkm::Float32 **outs = channel_ptrs.data();
+
+    // one read of each point for all of the functions
+#ifdef ASCENT_USE_OPENMP
+    #pragma omp parallel for
+#endif
+    for(vtkm::Id i = 0; i < num_points; ++i)
+    {
+      const Vec3d p(portal.Get(i));
+      for(int f = 0; f < num_funcs; ++f)
+      {
+        const Function &func = funcs[f];
+        vtkm::Float64 value = 0.;
+        if(func.m_type == Function::PLANE)
+        {
+          value = vtkm::Dot(p - func.m_point, func.m_vector);
+        }
+        else if(func.m_type == Function::SPHERE)
+        {
+          value = vtkm::MagnitudeSquared(p - func.m_point) -
+                  func.m_radius * func.m_radius;
+        }
+        else
+        {
+          // signed distance to the box
+          vtkm::Float64 inside = std::numeric_limits<vtkm::Float64>::lowest();
+          vtkm::Float64 outside = 0.;
+          for(int a = 0; a < 3; ++a)
+          {
+            const vtkm::Float64 below = func.m_point[a] - p[a];
+            const vtkm::Float64 above = p[a] - func.m_vector[a];
+            const vtkm::Float64 dist = std::max(below, above);
+            inside = std::max(inside, dist);
+            if(dist > 0.)
+            {
+              outside += dist * dist;
+            }
+          }
+          value = outside > 0. ? std::sqrt(outside) : inside;
+        }
+        outs[f][i] = static_cast<vtkm::Float32>(value);
+      }
+    }
+
+    for(int f = 0; f < num_funcs; ++f)
+    {
+      m_channels[d].push_back(vtkm::cont::make_FieldPoint(channel_name(f), channels[f]));
+    }
+  }
+
+  m_evaluated = true;
+}
+
+//-----------------------------------------------------------------------------
+vtkh::DataSet
+ImplicitCutter::with_channel(const int function)
+{
+  vtkh::DataSet res;
+  res.SetCycle(m_input.GetCycle());
+  const vtkm::Id num_domains = m_input.GetNumberOfDomains();
+  for(vtkm::Id d = 0; d < num_domains; ++d)
+  {
+    // shallow copy, the input keeps its fields
+    vtkm::cont::DataSet dom;
+    vtkm::Id domain_id;
+    m_input.GetDomain(d, dom, domain_id);
+    dom.AddField(m_channels[d][function]);
+    res.AddDomain(dom, domain_id);
+  }
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+vtkh::DataSet *
+ImplicitCutter::strip_channels(vtkh::DataSet *input) const
+{
+  vtkh::DataSet *res = new vtkh::DataSet();
+  const vtkm::Id num_domains = input->GetNumberOfDomains();
+  for(vtkm::Id d = 0; d < num_domains; ++d)
+  {
+    vtkm::cont::DataSet dom;
+    vtkm::Id domain_id;
+    input->GetDomain(d, dom, domain_id);
+
+    vtkm::cont::DataSet stripped;
+    stripped.SetCellSet(dom.GetCellSet());
+    for(vtkm::IdComponent c = 0; c < dom.GetNumberOfCoordinateSystems(); ++c)
+    {
+      stripped.AddCoordinateSystem(dom.GetCoordinateSystem(c));
+    }
+    for(vtkm::IdComponent f = 0; f < dom.GetNumberOfFields(); ++f)
+    {
+      const vtkm::cont::Field &field = dom.GetField(f);
+      if(field.GetName().compare(0, channel_prefix.size(), channel_prefix) != 0)
+      {
+        stripped.AddField(field);
+      }
+    }
+    res->AddDomain(stripped, domain_id);
+  }
+  res->SetCycle(input->GetCycle());
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+vtkh::DataSet *
+ImplicitCutter::slice_one(const int function)
+{
+  vtkh::DataSet channel = with_channel(function);
+  vtkh::MarchingCubes marcher;
+  marcher.SetInput(&channel);
+  marcher.SetField(channel_name(function));
+  double iso_value = 0.;
+  marcher.SetIsoValues(&iso_value, 1);
+  marcher.Update();
+
+  vtkh::DataSet *surface = marcher.GetOutput();
+  vtkh::DataSet *res = strip_channels(surface);
+  delete surface;
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+vtkh::DataSet *
+ImplicitCutter::slice(const std::vector<int> &functions)
+{
+  if(!m_evaluated)
+  {
+    ASCENT_ERROR("ImplicitCutter: slice called before evaluate");
+  }
+
+  std::vector<vtkh::DataSet*> surfaces;
+  for(const int function : functions)
+  {
+    surfaces.push_back(slice_one(function));
+  }
+
+  // slices replace a filter that had no id field, don't add one
+  vtkh::DataSet *res = append_data_sets(surfaces, "");
+  for(auto surface : surfaces)
+  {
+    delete surface;
+  }
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+vtkh::DataSet *
+ImplicitCutter::clip(const int function, const bool invert)
+{
+  if(!m_evaluated)
+  {
+    ASCENT_ERROR("ImplicitCutter: clip called before evaluate");
+  }
+
+  vtkh::DataSet channel = with_channel(function);
+  vtkh::ClipField clipper;
+  clipper.SetInput(&channel);
+  clipper.SetField(channel_name(function));
+  clipper.SetClipValue(0.);
+  clipper.SetInvertClip(invert);
+  clipper.Update();
+
+  vtkh::DataSet *clipped = clipper.GetOutput();
+  vtkh::DataSet *res = strip_channels(clipped);
+  delete clipped;
+  return res;
+}
+
+//-----------------------------------------------------------------------------
+vtkh::DataSet *
+ImplicitCutter::cut(const std::vector<int> &slices,
+                    const std::vector<int> &clips,
+                    const std::vector<bool> &invert)
+{
+  if(!m_evaluated)
+  {
+    ASCENT_ERROR("ImplicitCutter: cut called before evaluate");
+  }
+  if(clips.size() != invert.size())
+  {
+    ASCENT_ERROR("ImplicitCutter: need one invert flag per clip");
+  }
+
+  std::vector<vtkh::DataSet*> parts;
+  for(const int function : slices)
+  {
+    parts.push_back(slice_one(function));
+  }
+  for(size_t i = 0; i < clips.size(); ++i)
+  {
+    parts.push_back(clip(clips[i], invert[i]));
+  }
+
+  vtkh::DataSet *res = append_data_sets(parts, "cut_id");
+  for(auto part : parts)
+  {
+    delete part;
+  }
+  return res;
+}
+
+} // namespace detail
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::filters --
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime --
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
@@ -0,0 +1,181 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+
+//-----------------------------------------------------------------------------
+///
+/// file: ascent_runtime_vtkh_cutter.hpp
+///
+//-----------------------------------------------------------------------------
+
+#ifndef ASCENT_RUNTIME_VTKH_CUTTER_HPP
+#define ASCENT_RUNTIME_VTKH_CUTTER_HPP
+
+#include <ascent_exports.h>
+#include <ascent_runtime_scratch_arena.hpp>
+#include <vtkh/DataSet.hpp>
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// -- begin ascent:: --
+//-----------------------------------------------------------------------------
+namespace ascent
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime --
+//-----------------------------------------------------------------------------
+namespace runtime
+{
+
+//-----------------------------------------------------------------------------
+// -- begin ascent::runtime::filters --
+//-----------------------------------------------------------------------------
+namespace filters
+{
+
+namespace detail
+{
+
+//
+// Cuts a data set with several implicit functions (planes, spheres and
+// boxes). The values of all of the functions are computed in a single
+// pass over the points and kept as one point field (channel) per
+// function. Slices (the zero iso surface of a function) and clips are
+// then cut from those channels, so the coordinates are read once no
+// matter how many cuts are requested. The extraction is not shared:
+// each cut runs its own contour or clip pass on a copy that only
+// carries its channel, and the pieces are appended afterwards.
+//
+// Function values follow vtk-m's implicit functions: negative inside
+// spheres and boxes, and negative behind planes.
+//
+class ImplicitCutter
+{
+public:
+  // channels are kept in 'scratch' when one is given, so repeated cuts
+  // of the same mesh reuse their memory
+  ImplicitCutter(ScratchArena *scratch = nullptr);
+
+  // each returns the index of the new function
+  int add_plane(const vtkm::Vec<vtkm::Float64,3> &point,
+                const vtkm::Vec<vtkm::Float64,3> &normal);
+  int add_sphere(const vtkm::Vec<vtkm::Float64,3> &center,
+                 const vtkm::Float64 radius);
+  int add_box(const vtkm::Bounds &bounds);
+
+  int number_of_functions() const;
+
+  // evaluates all of the functions over the points of the input
+  void evaluate(vtkh::DataSet &input);
+
+  // the zero iso surfaces of the functions, appended per domain.
+  // The caller owns the result.
+  vtkh::DataSet *slice(const std::vector<int> &functions);
+
+  // the part of the input where the function is positive (negative
+  // if inverted). The caller owns the result.
+  vtkh::DataSet *clip(const int function, const bool invert);
+
+  // the slices followed by the clips, appended per domain. The cells
+  // get their position in that order in the 'cut_id' cell field.
+  // The caller owns the result.
+  vtkh::DataSet *cut(const std::vector<int> &slices,
+                     const std::vector<int> &clips,
+                     const std::vector<bool> &invert);
+
+private:
+  struct Function
+  {
+    enum Type { PLANE, SPHERE, BOX };
+    Type                       m_type;
+    vtkm::Vec<vtkm::Float64,3> m_point;  // plane point, sphere center, box min
+    vtkm::Vec<vtkm::Float64,3> m_vector; // plane normal, box max
+    vtkm::Float64              m_radius;
+  };
+
+  std::string channel_name(const int function) const;
+  // the input with the channel of one function added
+  vtkh::DataSet with_channel(const int function);
+  // the zero iso surface of one function without the channel fields
+  vtkh::DataSet *slice_one(const int function);
+  // returns a copy of the data set without the channel fields
+  vtkh::DataSet *strip_channels(vtkh::DataSet *input) const;
+
+  std::vector<Function> m_functions;
+  // shallow copy of the evaluated input
+  vtkh::DataSet         m_input;
+  // the channel fields of each domain, indexed by [domain][function]
+  std::vector<std::vector<vtkm::cont::Field>> m_channels;
+  bool                  m_evaluated;
+  ScratchArena         *m_scratch;
+};
+
+} // namespace detail
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime::filters --
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent::runtime --
+//-----------------------------------------------------------------------------
+
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end ascent:: --
+//-----------------------------------------------------------------------------
+
+#endif
+//-----------------------------------------------------------------------------
+// -- end header ifdef guard
+//-----------------------------------------------------------------------------
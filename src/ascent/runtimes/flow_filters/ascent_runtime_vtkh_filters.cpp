@@ -111,6 +111,8 @@
 #include <ascent_vtkh_data_adapter.hpp>
 #include <ascent_runtime_conduit_to_vtkm_parsing.hpp>
 #include <ascent_runtime_vtkh_utils.hpp>
+#include <ascent_runtime_vtkh_cutter.hpp>
+#include <ascent_runtime_derived_fields.hpp>
 #include <ascent_expression_eval.hpp>
 #endif
 
@@ -139,6 +141,207 @@ namespace runtime
 namespace filters
 {
 
+namespace detail
+{
+
+// checks the params of a single cut: a sphere, box or plane that
+// is either sliced or clipped
+bool check_cut_params(const conduit::Node &params,
+                      conduit::Node &info)
+{
+    bool res = true;
+    int num_functions = 0;
+    if(params.has_child("sphere"))
+    {
+      num_functions++;
+      res = check_numeric("sphere/center/x",params, info, true, true) && res;
+      res = check_numeric("sphere/center/y",params, info, true, true) && res;
+      res = check_numeric("sphere/center/z",params, info, true, true) && res;
+      res = check_numeric("sphere/radius",params, info, true, true) && res;
+    }
+    if(params.has_child("box"))
+    {
+      num_functions++;
+      res = check_numeric("box/min/x",params, info, true, true) && res;
+      res = check_numeric("box/min/y",params, info, true, true) && res;
+      res = check_numeric("box/min/z",params, info, true, true) && res;
+      res = check_numeric("box/max/x",params, info, true, true) && res;
+      res = check_numeric("box/max/y",params, info, true, true) && res;
+      res = check_numeric("box/max/z",params, info, true, true) && res;
+    }
+    if(params.has_child("plane"))
+    {
+      num_functions++;
+      res = check_numeric("plane/point/x",params, info, true, true) && res;
+      res = check_numeric("plane/point/y",params, info, true, true) && res;
+      res = check_numeric("plane/point/z",params, info, true, true) && res;
+      res = check_numeric("plane/normal/x",params, info, true, true) && res;
+      res = check_numeric("plane/normal/y",params, info, true, true) && res;
+      res = check_numeric("plane/normal/z",params, info, true, true) && res;
+    }
+
+    if(num_functions != 1)
+    {
+      info["errors"].append() = "Each cut must specify exactly one of"
+                                " 'sphere', 'box', or 'plane'";
+      res = false;
+    }
+
+    res = check_string("operation",params, info, false) && res;
+    if(params.has_path("operation"))
+    {
+      const std::string operation = params["operation"].as_string();
+      if(operation != "slice" && operation != "clip")
+      {
+        info["errors"].append() = "Cut 'operation' must be 'slice' or 'clip'";
+        res = false;
+      }
+    }
+    res = check_string("invert",params, info, false) && res;
+
+    std::vector<std::string> valid_paths;
+    valid_paths.push_back("operation");
+    valid_paths.push_back("invert");
+    valid_paths.push_back("sphere/center/x");
+    valid_paths.push_back("sphere/center/y");
+    valid_paths.push_back("sphere/center/z");
+    valid_paths.push_back("sphere/radius");
+    valid_paths.push_back("box/min/x");
+    valid_paths.push_back("box/min/y");
+    valid_paths.push_back("box/min/z");
+    valid_paths.push_back("box/max/x");
+    valid_paths.push_back("box/max/y");
+    valid_paths.push_back("box/max/z");
+    valid_paths.push_back("plane/point/x");
+    valid_paths.push_back("plane/point/y");
+    valid_paths.push_back("plane/point/z");
+    valid_paths.push_back("plane/normal/x");
+    valid_paths.push_back("plane/normal/y");
+    valid_paths.push_back("plane/normal/z");
+    std::string surprises = surprise_check(valid_paths, params);
+
+    if(surprises != "")
+    {
+      res = false;
+      info["errors"].append() = surprises;
+    }
+
+    return res;
+}
+
+// adds the implicit function of a single cut and returns its index
+int add_cut_function(ImplicitCutter &cutter,
+                     const conduit::Node &params,
+                     DataObject *data_object)
+{
+    using Vec3d = vtkm::Vec<vtkm::Float64,3>;
+    if(params.has_path("sphere"))
+    {
+      const Node &sphere = params["sphere"];
+      Vec3d center(get_float64(sphere["center/x"], data_object),
+                   get_float64(sphere["center/y"], data_object),
+                   get_float64(sphere["center/z"], data_object));
+      return cutter.add_sphere(center, get_float64(sphere["radius"], data_object));
+    }
+    else if(params.has_path("box"))
+    {
+      const Node &box = params["box"];
+      vtkm::Bounds bounds;
+      bounds.X.Min = get_float64(box["min/x"], data_object);
+      bounds.Y.Min = get_float64(box["min/y"], data_object);
+      bounds.Z.Min = get_float64(box["min/z"], data_object);
+      bounds.X.Max = get_float64(box["max/x"], data_object);
+      bounds.Y.Max = get_float64(box["max/y"], data_object);
+      bounds.Z.Max = get_float64(box["max/z"], data_object);
+      return cutter.add_box(bounds);
+    }
+
+    const Node &plane = params["plane"];
+    Vec3d point(get_float64(plane["point/x"], data_object),
+                get_float64(plane["point/y"], data_object),
+                get_float64(plane["point/z"], data_object));
+    Vec3d normal(get_float64(plane["normal/x"], data_object),
+                 get_float64(plane["normal/y"], data_object),
+                 get_float64(plane["normal/z"], data_object));
+    return cutter.add_plane(point, normal);
+}
+
+// gradient, divergence, vorticity and qcriterion of a field all come
+// from the gradient, so they share a derived field cache entry and one
+// pass computes every quantity that pipelines ask for
+VTKHCollection *add_gradient_quantity(DerivedFieldTable &derived_fields,
+                                      std::shared_ptr<VTKHCollection> collection,
+                                      const std::string &field_name,
+                                      const std::string &quantity,
+                                      const conduit::Node &params)
+{
+    const std::string topo_name = collection->field_topology(field_name);
+
+    bool use_point_gradient = true;
+    if(params.has_path("use_cell_gradient"))
+    {
+      if(params["use_cell_gradient"].as_string() == "true")
+      {
+        use_point_gradient = false;
+      }
+    }
+
+    const vtkh::GradientParameters defaults;
+    std::string output_name;
+    if(params.has_path("output_name"))
+    {
+      output_name = params["output_name"].as_string();
+    }
+    else if(quantity == "divergence")
+    {
+      output_name = defaults.divergence_name;
+    }
+    else if(quantity == "vorticity")
+    {
+      output_name = defaults.vorticity_name;
+    }
+    else if(quantity == "qcriterion")
+    {
+      output_name = defaults.qcriterion_name;
+    }
+    else
+    {
+      output_name = defaults.output_name;
+    }
+
+    std::map<std::string,std::string> outputs;
+    outputs[quantity] = output_name;
+
+    const std::string operation = "gradient(" + field_name +
+      (use_point_gradient ? ",point)" : ",cell)");
+
+    auto compute = [&](vtkh::DataSet &input,
+                       const std::set<std::string> &quantities)
+    {
+      // the gradient worklet only supports floating point fields
+      vtkh::DataSet fp_input =
+        collection->floating_point_dataset(topo_name, {field_name});
+      vtkh::Gradient grad;
+      grad.SetInput(&fp_input);
+      grad.SetField(field_name);
+      vtkh::GradientParameters grad_params;
+      grad_params.use_point_gradient = use_point_gradient;
+      grad_params.output_name = "gradient";
+      grad_params.compute_divergence = quantities.count("divergence") != 0;
+      grad_params.divergence_name = "divergence";
+      grad_params.compute_vorticity = quantities.count("vorticity") != 0;
+      grad_params.vorticity_name = "vorticity";
+      grad_params.compute_qcriterion = quantities.count("qcriterion") != 0;
+      grad_params.qcriterion_name = "qcriterion";
+      grad.SetParameters(grad_params);
+      grad.Update();
+      return grad.GetOutput();
+    };
+
+    return derived_fields.add(collection, topo_name, operation, outputs, compute);
+}
+
+} // namespace detail
 
 VTKHMarchingCubes::VTKHMarchingCubes()
 :Filter()
@@ -169,7 +372,7 @@ VTKHMarchingCubes::verify_params(const conduit::Node &params,
     info.reset();
 
     bool res = check_string("field",params, info, true);
-    bool has_values = check_numeric("iso_values",params, info, false);
+    bool has_values = check_numeric("iso_values",params, info, false, true);
     bool has_levels = check_numeric("levels",params, info, false);
 
     if(!has_values && !has_levels)
@@ -227,7 +430,8 @@ VTKHMarchingCubes::execute()
 
     std::string topo_name = collection->field_topology(field_name);
 
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+    // vtk-m's contour filter only supports floating point fields
+    vtkh::DataSet data = collection->floating_point_dataset(topo_name, {field_name});
     vtkh::MarchingCubes marcher;
 
     marcher.SetInput(&data);
@@ -237,12 +441,21 @@ VTKHMarchingCubes::execute()
     {
       const Node &n_iso_vals = params()["iso_values"];
 
-      // convert to contig doubles
-      Node n_iso_vals_dbls;
-      n_iso_vals.to_float64_array(n_iso_vals_dbls);
+      if(n_iso_vals.dtype().is_string())
+      {
+        // expressions are evaluated each time the filter executes
+        double iso_value = get_float64(n_iso_vals, data_object);
+        marcher.SetIsoValues(&iso_value, 1);
+      }
+      else
+      {
+        // convert to contig doubles
+        Node n_iso_vals_dbls;
+        n_iso_vals.to_float64_array(n_iso_vals_dbls);
 
-      marcher.SetIsoValues(n_iso_vals_dbls.as_double_ptr(),
-                           n_iso_vals_dbls.dtype().number_of_elements());
+        marcher.SetIsoValues(n_iso_vals_dbls.as_double_ptr(),
+                             n_iso_vals_dbls.dtype().number_of_elements());
+      }
     }
     else
     {
@@ -348,29 +561,38 @@ VTKHVectorMagnitude::execute()
 
     std::string topo_name = collection->field_topology(field_name);
 
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
-
-    vtkh::VectorMagnitude mag;
-
-    mag.SetInput(&data);
-    mag.SetField(field_name);
+    std::string output_name = field_name + "_magnitude";
     if(params().has_path("output_name"))
     {
-      std::string output_name = params()["output_name"].as_string();
-      mag.SetResultName(output_name);
+      output_name = params()["output_name"].as_string();
     }
 
-    mag.Update();
+    std::map<std::string,std::string> outputs;
+    outputs["magnitude"] = output_name;
 
-    vtkh::DataSet *mag_output = mag.GetOutput();
+    auto compute = [&](vtkh::DataSet &input,
+                       const std::set<std::string> &)
+    {
+      vtkh::VectorMagnitude mag;
+      mag.SetInput(&input);
+      mag.SetField(field_name);
+      mag.SetResultName("magnitude");
+      mag.Update();
+      return mag.GetOutput();
+    };
 
     // we need to pass through the rest of the topologies, untouched,
     // and add the result of this operation
-    VTKHCollection *new_coll = collection->copy_without_topology(topo_name);
-    new_coll->add(*mag_output, topo_name);
+    DerivedFieldTable *derived_fields =
+      graph().workspace().registry().fetch<DerivedFieldTable>("derived_fields");
+    VTKHCollection *new_coll =
+      derived_fields->add(collection,
+                          topo_name,
+                          "vector_magnitude(" + field_name + ")",
+                          outputs,
+                          compute);
     // re wrap in data object
     DataObject *res =  new DataObject(new_coll);
-    delete mag_output;
     set_output<DataObject>(res);
 }
 
@@ -458,10 +680,6 @@ VTKH3Slice::execute()
 
     vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
 
-    vtkh::Slice slicer;
-
-    slicer.SetInput(&data);
-
     using Vec3f = vtkm::Vec<vtkm::Float32,3>;
     vtkm::Bounds bounds = data.GetGlobalBounds();
     Vec3f center = bounds.Center();
@@ -509,12 +727,17 @@ VTKH3Slice::execute()
     Vec3f z_normal(0.f, 0.f, 1.f);
 
 
-    slicer.AddPlane(x_point, x_normal);
-    slicer.AddPlane(y_point, y_normal);
-    slicer.AddPlane(z_point, z_normal);
-    slicer.Update();
+    // the distances to all three planes are computed in one pass
+    using Vec3d = vtkm::Vec<vtkm::Float64,3>;
+    detail::ImplicitCutter cutter(&m_scratch);
+    std::vector<int> planes;
+    planes.push_back(cutter.add_plane(Vec3d(x_point), Vec3d(x_normal)));
+    planes.push_back(cutter.add_plane(Vec3d(y_point), Vec3d(y_normal)));
+    planes.push_back(cutter.add_plane(Vec3d(z_point), Vec3d(z_normal)));
+    cutter.evaluate(data);
 
-    vtkh::DataSet *slice_output = slicer.GetOutput();
+    vtkh::DataSet *slice_output = cutter.slice(planes);
+    m_scratch.trim();
 
     // we need to pass through the rest of the topologies, untouched,
     // and add the result of this operation
@@ -526,6 +749,138 @@ VTKH3Slice::execute()
     set_output<DataObject>(res);
 }
 
+//-----------------------------------------------------------------------------
+VTKHCut::VTKHCut()
+:Filter()
+{
+// empty
+}
+
+//-----------------------------------------------------------------------------
+VTKHCut::~VTKHCut()
+{
+// empty
+}
+
+//-----------------------------------------------------------------------------
+void
+VTKHCut::declare_interface(Node &i)
+{
+    i["type_name"]   = "vtkh_cut";
+    i["port_names"].append() = "in";
+    i["output_port"] = "true";
+}
+
+//-----------------------------------------------------------------------------
+bool
+VTKHCut::verify_params(const conduit::Node &params,
+                       conduit::Node &info)
+{
+    info.reset();
+    bool res = check_string("topology",params, info, false);
+
+    if(!params.has_child("cuts") ||
+       params["cuts"].number_of_children() == 0)
+    {
+      info["errors"].append() = "Missing required parameter. Cut must specify"
+                                " a non-empty list of 'cuts'";
+      res = false;
+    }
+    else
+    {
+      const Node &n_cuts = params["cuts"];
+      const int num_cuts = n_cuts.number_of_children();
+      for(int i = 0; i < num_cuts; ++i)
+      {
+        res = detail::check_cut_params(n_cuts.child(i), info) && res;
+      }
+    }
+
+    std::vector<std::string> valid_paths;
+    std::vector<std::string> ignore_paths;
+    valid_paths.push_back("topology");
+    valid_paths.push_back("cuts");
+    ignore_paths.push_back("cuts");
+    std::string surprises = surprise_check(valid_paths, ignore_paths, params);
+    if(surprises != "")
+    {
+      res = false;
+      info["errors"].append() = surprises;
+    }
+
+    return res;
+}
+
+//-----------------------------------------------------------------------------
+void
+VTKHCut::execute()
+{
+
+    if(!input(0).check_type<DataObject>())
+    {
+        ASCENT_ERROR("VTKHCut input must be a data object");
+    }
+
+    DataObject *data_object = input<DataObject>(0);
+    if(!data_object->is_valid())
+    {
+      set_output<DataObject>(data_object);
+      return;
+    }
+    std::shared_ptr<VTKHCollection> collection = data_object->as_vtkh_collection();
+
+    bool throw_error = false;
+    std::string topo_name = detail::resolve_topology(params(),
+                                                     this->name(),
+                                                     collection,
+                                                     throw_error);
+    if(topo_name == "")
+    {
+      // this creates a data object with an invalid soource
+      set_output<DataObject>(new DataObject());
+      return;
+    }
+
+    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+
+    // slices come first in the output, followed by the clips
+    detail::ImplicitCutter cutter(&m_scratch);
+    std::vector<int> slices;
+    std::vector<int> clips;
+    std::vector<bool> invert;
+    const Node &n_cuts = params()["cuts"];
+    const int num_cuts = n_cuts.number_of_children();
+    for(int i = 0; i < num_cuts; ++i)
+    {
+      const Node &n_cut = n_cuts.child(i);
+      const int function = detail::add_cut_function(cutter, n_cut, data_object);
+      if(n_cut.has_path("operation") && n_cut["operation"].as_string() == "clip")
+      {
+        clips.push_back(function);
+        invert.push_back(n_cut.has_path("invert") &&
+                         n_cut["invert"].as_string() == "true");
+      }
+      else
+      {
+        slices.push_back(function);
+      }
+    }
+
+    // all of the functions are evaluated in one pass over the points
+    cutter.evaluate(data);
+    vtkh::DataSet *cut_output = cutter.cut(slices, clips, invert);
+    m_scratch.trim();
+
+    // we need to pass through the rest of the topologies, untouched,
+    // and add the result of this operation
+    VTKHCollection *new_coll = collection->copy_without_topology(topo_name);
+    new_coll->add(*cut_output, topo_name);
+    // re wrap in data object
+    DataObject *res =  new DataObject(new_coll);
+    delete cut_output;
+    set_output<DataObject>(res);
+}
+
 //-----------------------------------------------------------------------------
 VTKHTriangulate::VTKHTriangulate()
 :Filter()
@@ -981,10 +1336,6 @@ VTKHGhostStripper::execute()
     if(do_strip)
     {
       vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
-      vtkh::GhostStripper stripper;
-
-      stripper.SetInput(&data);
-      stripper.SetField(field_name);
 
       const Node &n_min_val = params()["min_value"];
       const Node &n_max_val = params()["max_value"];
@@ -992,12 +1343,40 @@ VTKHGhostStripper::execute()
       int min_val = n_min_val.to_int32();
       int max_val = n_max_val.to_int32();
 
-      stripper.SetMaxValue(max_val);
-      stripper.SetMinValue(min_val);
-
-      stripper.Update();
-
-      vtkh::DataSet *stripper_output = stripper.GetOutput();
+      // Domains without ghosts are passed through as is, and structured
+      // domains whose ghosts are a boundary layer are shrunk to a smaller
+      // structured domain. Only the remaining domains go through the
+      // threshold based stripper, which outputs explicit cell sets.
+      vtkh::DataSet remaining;
+      vtkh::DataSet *stripper_output =
+        detail::select_cells(data,
+                             [&](const vtkm::cont::DataSet &dom,
+                                 std::vector<vtkm::UInt8> &keep)
+                             {
+                               return detail::cell_range_mask(dom,
+                                                              field_name,
+                                                              min_val,
+                                                              max_val,
+                                                              keep);
+                             },
+                             remaining,
+                             &m_scratch);
+
+      // the stripper is collective, so every rank has to decide the same
+      if(!remaining.GlobalIsEmpty())
+      {
+        vtkh::GhostStripper stripper;
+        stripper.SetInput(&remaining);
+        stripper.SetField(field_name);
+        stripper.SetMaxValue(max_val);
+        stripper.SetMinValue(min_val);
+        stripper.Update();
+
+        vtkh::DataSet *stripped_output = stripper.GetOutput();
+        detail::add_domains(*stripped_output, *stripper_output);
+        delete stripped_output;
+      }
+      m_scratch.trim();
 
       // we need to pass through the rest of the topologies, untouched,
       // and add the result of this operation
@@ -1096,23 +1475,46 @@ VTKHThreshold::execute()
 
     vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
 
-    vtkh::Threshold thresher;
-
-    thresher.SetInput(&data);
-    thresher.SetField(field_name);
-
     const Node &n_min_val = params()["min_value"];
     const Node &n_max_val = params()["max_value"];
 
     // convert to contig doubles
     double min_val = get_float64(n_min_val, data_object);
     double max_val = get_float64(n_max_val, data_object);
-    thresher.SetUpperThreshold(max_val);
-    thresher.SetLowerThreshold(min_val);
-
-    thresher.Update();
 
-    vtkh::DataSet *thresh_output = thresher.GetOutput();
+    // thresholds of cell fields that keep whole domains or a box of a
+    // structured domain stay structured, everything else goes through
+    // the general threshold filter
+    vtkh::DataSet remaining;
+    vtkh::DataSet *thresh_output =
+      detail::select_cells(data,
+                           [&](const vtkm::cont::DataSet &dom,
+                               std::vector<vtkm::UInt8> &keep)
+                           {
+                             return detail::cell_range_mask(dom,
+                                                            field_name,
+                                                            min_val,
+                                                            max_val,
+                                                            keep);
+                           },
+                           remaining,
+                           &m_scratch);
+
+    // the threshold is collective, so every rank has to decide the same
+    if(!remaining.GlobalIsEmpty())
+    {
+      vtkh::Threshold thresher;
+      thresher.SetInput(&remaining);
+      thresher.SetField(field_name);
+      thresher.SetUpperThreshold(max_val);
+      thresher.SetLowerThreshold(min_val);
+      thresher.Update();
+
+      vtkh::DataSet *general_output = thresher.GetOutput();
+      detail::add_domains(*general_output, *thresh_output);
+      delete general_output;
+    }
+    m_scratch.trim();
 
     // we need to pass through the rest of the topologies, untouched,
     // and add the result of this operation
@@ -1469,27 +1871,50 @@ VTKHClipWithField::execute()
 
     vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
 
-    vtkh::ClipField clipper;
-
-    clipper.SetInput(&data);
-
+    bool invert = false;
     if(params().has_child("invert"))
     {
-      std::string invert = params()["invert"].as_string();
-      if(invert == "true")
-      {
-        clipper.SetInvertClip(true);
-      }
+      invert = params()["invert"].as_string() == "true";
     }
 
     vtkm::Float64 clip_value = get_float64(params()["clip_value"], data_object);
 
-    clipper.SetField(field_name);
-    clipper.SetClipValue(clip_value);
-
-    clipper.Update();
-
-    vtkh::DataSet *clip_output = clipper.GetOutput();
+    // clips of structured domains that do not cut through any cell
+    // and keep a box of cells stay structured, everything else goes
+    // through the general clip filter
+    vtkh::DataSet remaining;
+    vtkh::DataSet *clip_output =
+      detail::select_cells(data,
+                           [&](const vtkm::cont::DataSet &dom,
+                               std::vector<vtkm::UInt8> &keep)
+                           {
+                             return detail::clip_cell_mask(dom,
+                                                           field_name,
+                                                           clip_value,
+                                                           invert,
+                                                           keep);
+                           },
+                           remaining,
+                           &m_scratch);
+
+    // the clip is collective, so every rank has to decide the same
+    if(!remaining.GlobalIsEmpty())
+    {
+      // the general clip only supports floating point fields
+      vtkh::DataSet fp_remaining =
+        VTKHCollection::floating_point_copy(remaining, {field_name});
+      vtkh::ClipField clipper;
+      clipper.SetInput(&fp_remaining);
+      clipper.SetInvertClip(invert);
+      clipper.SetField(field_name);
+      clipper.SetClipValue(clip_value);
+      clipper.Update();
+
+      vtkh::DataSet *general_output = clipper.GetOutput();
+      detail::add_domains(*general_output, *clip_output);
+      delete general_output;
+    }
+    m_scratch.trim();
 
     // we need to pass through the rest of the topologies, untouched,
     // and add the result of this operation
@@ -1579,8 +2004,8 @@ VTKHIsoVolume::execute()
     }
 
     std::string topo_name = collection->field_topology(field_name);
-
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+    // vtk-m's clip only supports floating point fields
+    vtkh::DataSet data = collection->floating_point_dataset(topo_name, {field_name});
 
     vtkh::IsoVolume clipper;
 
@@ -1807,8 +2232,8 @@ VTKHLog::execute()
     }
 
     std::string topo_name = collection->field_topology(field_name);
-
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+    // the log of an integer field is not an integer
+    vtkh::DataSet data = collection->floating_point_dataset(topo_name, {field_name});
 
     vtkh::Log logger;
     logger.SetInput(&data);
@@ -1915,8 +2340,8 @@ VTKHRecenter::execute()
     }
 
     std::string topo_name = collection->field_topology(field_name);
-
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
+    // averages of an integer field would be truncated
+    vtkh::DataSet data = collection->floating_point_dataset(topo_name, {field_name});
 
 
     std::string association = params()["association"].as_string();
@@ -2183,40 +2608,13 @@ VTKHQCriterion::execute()
       return;
     }
 
-    std::string topo_name = collection->field_topology(field_name);
-
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
-
-    vtkh::Gradient grad;
-    grad.SetInput(&data);
-    grad.SetField(field_name);
-    vtkh::GradientParameters grad_params;
-    grad_params.compute_qcriterion = true;
-
-    if(params().has_path("use_cell_gradient"))
-    {
-      if(params()["use_cell_gradient"].as_string() == "true")
-      {
-        grad_params.use_point_gradient = false;
-      }
-    }
-    if(params().has_path("output_name"))
-    {
-      grad_params.qcriterion_name = params()["output_name"].as_string();
-    }
-
-    grad.SetParameters(grad_params);
-    grad.Update();
-
-    vtkh::DataSet *grad_output = grad.GetOutput();
-
-    // we need to pass through the rest of the topologies, untouched,
-    // and add the result of this operation
-    VTKHCollection *new_coll = collection->copy_without_topology(topo_name);
-    new_coll->add(*grad_output, topo_name);
+    DerivedFieldTable *derived_fields =
+      graph().workspace().registry().fetch<DerivedFieldTable>("derived_fields");
+    VTKHCollection *new_coll =
+      detail::add_gradient_quantity(*derived_fields, collection, field_name,
+                                    "qcriterion", params());
     // re wrap in data object
     DataObject *res =  new DataObject(new_coll);
-    delete grad_output;
     set_output<DataObject>(res);
 }
 //-----------------------------------------------------------------------------
@@ -2296,41 +2694,13 @@ VTKHDivergence::execute()
       return;
     }
 
-    std::string topo_name = collection->field_topology(field_name);
-
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
-
-    vtkh::Gradient grad;
-    grad.SetInput(&data);
-    grad.SetField(field_name);
-    vtkh::GradientParameters grad_params;
-    grad_params.compute_divergence = true;
-
-    if(params().has_path("use_cell_gradient"))
-    {
-      if(params()["use_cell_gradient"].as_string() == "true")
-      {
-        grad_params.use_point_gradient = false;
-      }
-    }
-
-    if(params().has_path("output_name"))
-    {
-      grad_params.divergence_name = params()["output_name"].as_string();
-    }
-
-    grad.SetParameters(grad_params);
-    grad.Update();
-
-    vtkh::DataSet *grad_output = grad.GetOutput();
-
-    // we need to pass through the rest of the topologies, untouched,
-    // and add the result of this operation
-    VTKHCollection *new_coll = collection->copy_without_topology(topo_name);
-    new_coll->add(*grad_output, topo_name);
+    DerivedFieldTable *derived_fields =
+      graph().workspace().registry().fetch<DerivedFieldTable>("derived_fields");
+    VTKHCollection *new_coll =
+      detail::add_gradient_quantity(*derived_fields, collection, field_name,
+                                    "divergence", params());
     // re wrap in data object
     DataObject *res =  new DataObject(new_coll);
-    delete grad_output;
     set_output<DataObject>(res);
 }
 //-----------------------------------------------------------------------------
@@ -2410,41 +2780,13 @@ VTKHVorticity::execute()
       return;
     }
 
-    std::string topo_name = collection->field_topology(field_name);
-
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
-
-    vtkh::Gradient grad;
-    grad.SetInput(&data);
-    grad.SetField(field_name);
-    vtkh::GradientParameters grad_params;
-    grad_params.compute_vorticity = true;
-
-    if(params().has_path("use_cell_gradient"))
-    {
-      if(params()["use_cell_gradient"].as_string() == "true")
-      {
-        grad_params.use_point_gradient = false;
-      }
-    }
-
-    if(params().has_path("output_name"))
-    {
-      grad_params.vorticity_name = params()["output_name"].as_string();
-    }
-
-    grad.SetParameters(grad_params);
-    grad.Update();
-
-    vtkh::DataSet *grad_output = grad.GetOutput();
-
-    // we need to pass through the rest of the topologies, untouched,
-    // and add the result of this operation
-    VTKHCollection *new_coll = collection->copy_without_topology(topo_name);
-    new_coll->add(*grad_output, topo_name);
+    DerivedFieldTable *derived_fields =
+      graph().workspace().registry().fetch<DerivedFieldTable>("derived_fields");
+    VTKHCollection *new_coll =
+      detail::add_gradient_quantity(*derived_fields, collection, field_name,
+                                    "vorticity", params());
     // re wrap in data object
     DataObject *res =  new DataObject(new_coll);
-    delete grad_output;
     set_output<DataObject>(res);
 }
 //-----------------------------------------------------------------------------
@@ -2525,40 +2867,13 @@ VTKHGradient::execute()
       return;
     }
 
-    std::string topo_name = collection->field_topology(field_name);
-
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
-
-    vtkh::Gradient grad;
-    grad.SetInput(&data);
-    grad.SetField(field_name);
-    vtkh::GradientParameters grad_params;
-
-    if(params().has_path("use_cell_gradient"))
-    {
-      if(params()["use_cell_gradient"].as_string() == "true")
-      {
-        grad_params.use_point_gradient = false;
-      }
-    }
-
-    if(params().has_path("output_name"))
-    {
-      grad_params.output_name = params()["output_name"].as_string();
-    }
-
-    grad.SetParameters(grad_params);
-    grad.Update();
-
-    vtkh::DataSet *grad_output = grad.GetOutput();
-
-    // we need to pass through the rest of the topologies, untouched,
-    // and add the result of this operation
-    VTKHCollection *new_coll = collection->copy_without_topology(topo_name);
-    new_coll->add(*grad_output, topo_name);
+    DerivedFieldTable *derived_fields =
+      graph().workspace().registry().fetch<DerivedFieldTable>("derived_fields");
+    VTKHCollection *new_coll =
+      detail::add_gradient_quantity(*derived_fields, collection, field_name,
+                                    "gradient", params());
     // re wrap in data object
     DataObject *res =  new DataObject(new_coll);
-    delete grad_output;
     set_output<DataObject>(res);
 }
 
@@ -3188,33 +3503,50 @@ VTKHCompositeVector::execute()
     }
 
     std::string topo_name = collection->field_topology(field_name1);
-
-    vtkh::DataSet &data = collection->dataset_by_topology(topo_name);
-
-
-    vtkh::CompositeVector comp;
-
-    comp.SetInput(&data);
-    if(field_name3 == "")
+    std::string operation = "composite_vector(" + field_name1 + "," + field_name2;
+    if(field_name3 != "")
     {
-      comp.SetFields(field_name1, field_name2);
+      operation += "," + field_name3;
     }
-    else
+    operation += ")";
+
+    std::map<std::string,std::string> outputs;
+    outputs["vector"] = params()["output_name"].as_string();
+
+    auto compute = [&](vtkh::DataSet &input,
+                       const std::set<std::string> &)
     {
-      comp.SetFields(field_name1, field_name2, field_name3);
-    }
-    std::string res_name = params()["output_name"].as_string();
-    comp.SetResultField(res_name);
-    comp.Update();
+      // vector fields are floating point
+      std::vector<std::string> field_names = {field_name1, field_name2};
+      if(field_name3 != "")
+      {
+        field_names.push_back(field_name3);
+      }
+      vtkh::DataSet fp_input =
+        collection->floating_point_dataset(topo_name, field_names);
+      vtkh::CompositeVector comp;
+      comp.SetInput(&fp_input);
+      if(field_name3 == "")
+      {
+        comp.SetFields(field_name1, field_name2);
+      }
+      else
+      {
+        comp.SetFields(field_name1, field_name2, field_name3);
+      }
+      comp.SetResultField("vector");
+      comp.Update();
+      return comp.GetOutput();
+    };
 
-    vtkh::DataSet *comp_output = comp.GetOutput();
     // we need to pass through the rest of the topologies, untouched,
     // and add the result of this operation
-    VTKHCollection *new_coll = collection->copy_without_topology(topo_name);
-    new_coll->add(*comp_output, topo_name);
+    DerivedFieldTable *derived_fields =
+      graph().workspace().registry().fetch<DerivedFieldTable>("derived_fields");
+    VTKHCollection *new_coll =
+      derived_fields->add(collection, topo_name, operation, outputs, compute);
     // re wrap in data object
     DataObject *res =  new DataObject(new_coll);
-    delete comp_output;
     set_output<DataObject>(res);
 }
 
@@ -55,6 +55,7 @@
 #include <ascent.hpp>
 
 #include <flow_filter.hpp>
+#include <ascent_runtime_scratch_arena.hpp>
 
 
 //-----------------------------------------------------------------------------
@@ -131,6 +132,23 @@ public:
     virtual bool   verify_params(const conduit::Node &params,
                                  conduit::Node &info);
     virtual void   execute();
+private:
+    ScratchArena m_scratch;
+};
+
+//-----------------------------------------------------------------------------
+class ASCENT_API VTKHCut : public ::flow::Filter
+{
+public:
+    VTKHCut();
+    virtual ~VTKHCut();
+
+    virtual void   declare_interface(conduit::Node &i);
+    virtual bool   verify_params(const conduit::Node &params,
+                                 conduit::Node &info);
+    virtual void   execute();
+private:
+    ScratchArena m_scratch;
 };
 
 //-----------------------------------------------------------------------------
@@ -144,6 +162,8 @@ public:
     virtual bool   verify_params(const conduit::Node &params,
                                  conduit::Node &info);
     virtual void   execute();
+private:
+    ScratchArena m_scratch;
 };
 
 //-----------------------------------------------------------------------------
@@ -157,6 +177,8 @@ public:
     virtual bool   verify_params(const conduit::Node &params,
                                  conduit::Node &info);
     virtual void   execute();
+private:
+    ScratchArena m_scratch;
 };
 
 //-----------------------------------------------------------------------------
@@ -183,6 +205,8 @@ public:
     virtual bool   verify_params(const conduit::Node &params,
                                  conduit::Node &info);
     virtual void   execute();
+private:
+    ScratchArena m_scratch;
 };
 
 //-----------------------------------------------------------------------------
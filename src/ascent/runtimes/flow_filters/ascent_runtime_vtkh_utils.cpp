@@ -50,7 +50,22 @@
 //-----------------------------------------------------------------------------
 
 #include "ascent_runtime_vtkh_utils.hpp"
+#include <ascent_config.h>
 #include <ascent_runtime_utils.hpp>
+#include <ascent_logging.hpp>
+
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleCartesianProduct.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
+#include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/cont/CellSetSingleType.h>
+#include <vtkm/cont/CellSetStructured.h>
+#include <vtkh/utils/vtkm_dataset_info.hpp>
+
+#include <algorithm>
+#include <map>
 
 //-----------------------------------------------------------------------------
 // -- begin ascent:: --
@@ -192,6 +207,758 @@ std::string resolve_topology(const conduit::Node &params,
   return topo_name;
 }
 
+struct AppendFieldFunctor
+{
+  template<typename T, typename S>
+  void operator()(const vtkm::cont::ArrayHandle<T,S> &,
+                  const std::vector<vtkm::cont::Field> &fields,
+                  const vtkm::Id total,
+                  vtkm::cont::VariantArrayHandle &output,
+                  bool &valid) const
+  {
+    using HandleType = vtkm::cont::ArrayHandle<T>;
+    HandleType appended;
+    appended.Allocate(total);
+    vtkm::Id offset = 0;
+    for(const auto &field : fields)
+    {
+      if(!field.GetData().IsType<HandleType>())
+      {
+        valid = false;
+        return;
+      }
+      HandleType values = field.GetData().Cast<HandleType>();
+      const vtkm::Id size = values.GetNumberOfValues();
+      vtkm::cont::Algorithm::CopySubRange(values, 0, size, appended, offset);
+      offset += size;
+    }
+    output = vtkm::cont::VariantArrayHandle(appended);
+    valid = true;
+  }
+};
+
+namespace
+{
+
+template<typename CellSetType>
+vtkm::Id connectivity_size(const CellSetType &cells)
+{
+  return cells.GetConnectivityArray(vtkm::TopologyElementTagCell(),
+                                    vtkm::TopologyElementTagPoint()).GetNumberOfValues();
+}
+
+// copies the cells of one part into its place in the appended explicit
+// arrays, offsetting the connectivity by the points of the earlier parts
+template<typename CellSetType>
+void append_cells(const CellSetType &cells,
+                  const vtkm::Id point_offset,
+                  const vtkm::Id cell_offset,
+                  const vtkm::Id conn_offset,
+                  vtkm::UInt8 *shapes,
+                  vtkm::Id *offsets,
+                  vtkm::Id *conn)
+{
+  const vtkm::TopologyElementTagCell cell_tag;
+  const vtkm::TopologyElementTagPoint point_tag;
+  auto shapes_portal = cells.GetShapesArray(cell_tag, point_tag).ReadPortal();
+  auto offsets_portal = cells.GetOffsetsArray(cell_tag, point_tag).ReadPortal();
+  auto conn_portal = cells.GetConnectivityArray(cell_tag, point_tag).ReadPortal();
+
+  const vtkm::Id num_cells = cells.GetNumberOfCells();
+#ifdef ASCENT_USE_OPENMP
+  #pragma omp parallel for
+#endif
+  for(vtkm::Id c = 0; c < num_cells; ++c)
+  {
+    shapes[cell_offset + c] = shapes_portal.Get(c);
+    offsets[cell_offset + c + 1] = conn_offset + offsets_portal.Get(c + 1);
+  }
+  const vtkm::Id conn_size = conn_portal.GetNumberOfValues();
+#ifdef ASCENT_USE_OPENMP
+  #pragma omp parallel for
+#endif
+  for(vtkm::Id c = 0; c < conn_size; ++c)
+  {
+    conn[conn_offset + c] = conn_portal.Get(c) + point_offset;
+  }
+}
+
+// appends the coordinates of the parts as vectors of T. Parts already
+// stored that way are copied directly, so no precision is lost.
+template<typename T>
+vtkm::cont::CoordinateSystem
+append_coordinates(const std::vector<const vtkm::cont::DataSet*> &parts,
+                   const vtkm::Id total_points)
+{
+  using HandleType = vtkm::cont::ArrayHandle<vtkm::Vec<T,3>>;
+  HandleType coords;
+  coords.Allocate(total_points);
+  vtkm::Id point_offset = 0;
+  for(const auto *part : parts)
+  {
+    const vtkm::cont::CoordinateSystem &part_cs = part->GetCoordinateSystem();
+    HandleType part_coords;
+    if(part_cs.GetData().template IsType<HandleType>())
+    {
+      part_coords = part_cs.GetData().template Cast<HandleType>();
+    }
+    else
+    {
+      vtkm::cont::ArrayCopy(part_cs.GetData(), part_coords);
+    }
+    const vtkm::Id num_points = part_coords.GetNumberOfValues();
+    vtkm::cont::Algorithm::CopySubRange(part_coords, 0, num_points, coords, point_offset);
+    point_offset += num_points;
+  }
+  return vtkm::cont::CoordinateSystem(parts[0]->GetCoordinateSystem().GetName(),
+                                      coords);
+}
+
+} // namespace
+
+vtkm::cont::DataSet
+append_data_sets(const std::vector<vtkm::cont::DataSet> &parts)
+{
+  using SingleType = vtkm::cont::CellSetSingleType<>;
+  using ExplicitType = vtkm::cont::CellSetExplicit<>;
+
+  std::vector<const vtkm::cont::DataSet*> non_empty;
+  for(const auto &part : parts)
+  {
+    if(part.GetNumberOfCells() > 0)
+    {
+      non_empty.push_back(&part);
+    }
+  }
+
+  if(non_empty.size() == 0)
+  {
+    return parts.size() == 0 ? vtkm::cont::DataSet() : parts[0];
+  }
+  if(non_empty.size() == 1)
+  {
+    return *non_empty[0];
+  }
+
+  // a single shape (e.g. only triangles) stays a single type cell set,
+  // anything else (e.g. slices mixed with clipped cells) becomes explicit
+  bool single_type = true;
+  vtkm::UInt8 shape_id = 0;
+  vtkm::IdComponent points_per_cell = 0;
+  for(size_t i = 0; i < non_empty.size(); ++i)
+  {
+    const vtkm::cont::DynamicCellSet &dyn_cells = non_empty[i]->GetCellSet();
+    if(dyn_cells.IsType<SingleType>())
+    {
+      SingleType cells = dyn_cells.Cast<SingleType>();
+      if(i == 0)
+      {
+        shape_id = cells.GetCellShape(0);
+        points_per_cell = cells.GetNumberOfPointsInCell(0);
+      }
+      else if(shape_id != cells.GetCellShape(0))
+      {
+        single_type = false;
+      }
+    }
+    else if(dyn_cells.IsType<ExplicitType>())
+    {
+      single_type = false;
+    }
+    else
+    {
+      ASCENT_ERROR("Append data sets: only single type and explicit cell sets"
+                   " are supported");
+    }
+  }
+
+  // where each part starts, so the parts can be copied independently
+  const size_t num_parts = non_empty.size();
+  std::vector<vtkm::Id> point_offsets(num_parts + 1, 0);
+  std::vector<vtkm::Id> cell_offsets(num_parts + 1, 0);
+  std::vector<vtkm::Id> conn_offsets(num_parts + 1, 0);
+  // float32 coordinates stay float32, anything else is kept as float64
+  bool float32_coords = true;
+  for(size_t i = 0; i < num_parts; ++i)
+  {
+    const vtkm::cont::DataSet &part = *non_empty[i];
+    const vtkm::cont::DynamicCellSet &dyn_cells = part.GetCellSet();
+    const vtkm::Id conn_size = dyn_cells.IsType<SingleType>()
+      ? connectivity_size(dyn_cells.Cast<SingleType>())
+      : connectivity_size(dyn_cells.Cast<ExplicitType>());
+    point_offsets[i + 1] = point_offsets[i] + part.GetNumberOfPoints();
+    cell_offsets[i + 1] = cell_offsets[i] + part.GetNumberOfCells();
+    conn_offsets[i + 1] = conn_offsets[i] + conn_size;
+    float32_coords &= part.GetCoordinateSystem().GetData().
+      IsType<vtkm::cont::ArrayHandle<vtkm::Vec3f_32>>();
+  }
+  const vtkm::Id total_points = point_offsets[num_parts];
+  const vtkm::Id total_cells = cell_offsets[num_parts];
+
+  std::vector<vtkm::UInt8> shapes(total_cells);
+  std::vector<vtkm::Id> offsets(total_cells + 1, 0);
+  std::vector<vtkm::Id> conn(conn_offsets[num_parts]);
+  for(size_t i = 0; i < num_parts; ++i)
+  {
+    const vtkm::cont::DynamicCellSet &dyn_cells = non_empty[i]->GetCellSet();
+    if(dyn_cells.IsType<SingleType>())
+    {
+      append_cells(dyn_cells.Cast<SingleType>(),
+                   point_offsets[i], cell_offsets[i], conn_offsets[i],
+                   shapes.data(), offsets.data(), conn.data());
+    }
+    else
+    {
+      append_cells(dyn_cells.Cast<ExplicitType>(),
+                   point_offsets[i], cell_offsets[i], conn_offsets[i],
+                   shapes.data(), offsets.data(), conn.data());
+    }
+  }
+
+  vtkm::cont::DataSet res;
+  if(float32_coords)
+  {
+    res.AddCoordinateSystem(append_coordinates<vtkm::Float32>(non_empty, total_points));
+  }
+  else
+  {
+    res.AddCoordinateSystem(append_coordinates<vtkm::Float64>(non_empty, total_points));
+  }
+
+  auto conn_handle = vtkm::cont::make_ArrayHandle(conn, vtkm::CopyFlag::On);
+  if(single_type)
+  {
+    SingleType cellset;
+    cellset.Fill(total_points, shape_id, points_per_cell, conn_handle);
+    res.SetCellSet(cellset);
+  }
+  else
+  {
+    ExplicitType cellset;
+    cellset.Fill(total_points,
+                 vtkm::cont::make_ArrayHandle(shapes, vtkm::CopyFlag::On),
+                 conn_handle,
+                 vtkm::cont::make_ArrayHandle(offsets, vtkm::CopyFlag::On));
+    res.SetCellSet(cellset);
+  }
+
+  // only keep the point and cell fields that all parts share
+  const vtkm::cont::DataSet &first = *non_empty[0];
+  for(vtkm::IdComponent f = 0; f < first.GetNumberOfFields(); ++f)
+  {
+    const vtkm::cont::Field &field = first.GetField(f);
+    const vtkm::cont::Field::Association assoc = field.GetAssociation();
+    if(assoc != vtkm::cont::Field::Association::POINTS &&
+       assoc != vtkm::cont::Field::Association::CELL_SET)
+    {
+      continue;
+    }
+
+    std::vector<vtkm::cont::Field> fields;
+    for(const auto *part : non_empty)
+    {
+      if(part->HasField(field.GetName(), assoc))
+      {
+        fields.push_back(part->GetField(field.GetName(), assoc));
+      }
+    }
+    if(fields.size() != non_empty.size())
+    {
+      continue;
+    }
+
+    const vtkm::Id total =
+      assoc == vtkm::cont::Field::Association::POINTS ? total_points : total_cells;
+    vtkm::cont::VariantArrayHandle appended;
+    bool valid = false;
+    field.GetData().CastAndCall(AppendFieldFunctor(), fields, total, appended, valid);
+    if(valid)
+    {
+      res.AddField(vtkm::cont::Field(field.GetName(), assoc, appended));
+    }
+  }
+
+  return res;
+}
+
+vtkh::DataSet *append_data_sets(const std::vector<vtkh::DataSet*> &parts,
+                                const std::string &id_field)
+{
+  std::map<vtkm::Id, std::vector<vtkm::cont::DataSet>> domains;
+  const int num_parts = static_cast<int>(parts.size());
+  for(int i = 0; i < num_parts; ++i)
+  {
+    const vtkm::Id num_domains = parts[i]->GetNumberOfDomains();
+    for(vtkm::Id d = 0; d < num_domains; ++d)
+    {
+      vtkm::cont::DataSet dom;
+      vtkm::Id domain_id;
+      parts[i]->GetDomain(d, dom, domain_id);
+
+      if(!id_field.empty())
+      {
+        vtkm::cont::ArrayHandle<vtkm::Float32> ids;
+        vtkm::cont::Algorithm::Fill(ids,
+                                    static_cast<vtkm::Float32>(i),
+                                    dom.GetNumberOfCells());
+        dom.AddField(vtkm::cont::make_FieldCell(id_field, ids));
+      }
+      domains[domain_id].push_back(dom);
+    }
+  }
+
+  vtkh::DataSet *res = new vtkh::DataSet();
+  for(auto &domain : domains)
+  {
+    res->AddDomain(append_data_sets(domain.second), domain.first);
+  }
+  if(num_parts > 0)
+  {
+    res->SetCycle(parts[0]->GetCycle());
+  }
+  return res;
+}
+
+namespace
+{
+
+// the cell dimensions of a 2d or 3d structured domain. 2d cell sets are
+// treated as a single layer of cells.
+bool structured_dims(const vtkm::cont::DataSet &dom,
+                     int &topo_dims,
+                     vtkm::Id3 &cell_dims,
+                     vtkm::Id3 &point_start)
+{
+  if(!vtkh::VTKMDataSetInfo::IsStructured(dom, topo_dims) ||
+     (topo_dims != 2 && topo_dims != 3))
+  {
+    return false;
+  }
+
+  const vtkm::cont::DynamicCellSet &dyn_cells = dom.GetCellSet();
+  if(topo_dims == 3)
+  {
+    auto cells = dyn_cells.Cast<vtkm::cont::CellSetStructured<3>>();
+    cell_dims = cells.GetCellDimensions();
+    point_start = cells.GetGlobalPointIndexStart();
+  }
+  else
+  {
+    auto cells = dyn_cells.Cast<vtkm::cont::CellSetStructured<2>>();
+    vtkm::Id2 dims = cells.GetCellDimensions();
+    vtkm::Id2 start = cells.GetGlobalPointIndexStart();
+    cell_dims = vtkm::Id3(dims[0], dims[1], 1);
+    point_start = vtkm::Id3(start[0], start[1], 0);
+  }
+  return true;
+}
+
+} // namespace
+
+// scalar types the masks are computed on: floating point, and the
+// integer types the data adapter passes through natively (e.g. ghost
+// and material ids), so the filters don't need a float64 copy
+using MaskFieldTypes = vtkm::List<vtkm::Float32,
+                                  vtkm::Float64,
+                                  vtkm::UInt8,
+                                  vtkm::Int32,
+                                  vtkm::Int64>;
+
+struct RangeMaskFunctor
+{
+  template<typename T, typename S>
+  void operator()(const vtkm::cont::ArrayHandle<T,S> &values,
+                  const double min_value,
+                  const double max_value,
+                  std::vector<vtkm::UInt8> &keep,
+                  vtkm::Id &num_kept) const
+  {
+    auto portal = values.ReadPortal();
+    const vtkm::Id size = portal.GetNumberOfValues();
+    keep.resize(size);
+    vtkm::Id count = 0;
+#ifdef ASCENT_USE_OPENMP
+    #pragma omp parallel for reduction(+:count)
+#endif
+    for(vtkm::Id i = 0; i < size; ++i)
+    {
+      const double value = static_cast<double>(portal.Get(i));
+      keep[i] = value >= min_value && value <= max_value;
+      count += keep[i];
+    }
+    num_kept = count;
+  }
+};
+
+struct ClipMaskFunctor
+{
+  template<typename T, typename S>
+  void operator()(const vtkm::cont::ArrayHandle<T,S> &values,
+                  const vtkm::Id3 &cell_dims,
+                  const int topo_dims,
+                  const double clip_value,
+                  const bool invert,
+                  std::vector<vtkm::UInt8> &keep,
+                  vtkm::Id &num_kept) const
+  {
+    auto portal = values.ReadPortal();
+    const vtkm::Id nx = cell_dims[0] + 1;
+    const vtkm::Id ny = cell_dims[1] + 1;
+    const vtkm::Id layers = topo_dims == 3 ? 2 : 1;
+    const vtkm::Id num_cells = cell_dims[0] * cell_dims[1] * cell_dims[2];
+    keep.resize(num_cells);
+
+    vtkm::Id count = 0;
+    vtkm::Id cut = 0;
+#ifdef ASCENT_USE_OPENMP
+    #pragma omp parallel for reduction(+:count,cut)
+#endif
+    for(vtkm::Id cell = 0; cell < num_cells; ++cell)
+    {
+      const vtkm::Id i = cell % cell_dims[0];
+      const vtkm::Id j = (cell / cell_dims[0]) % cell_dims[1];
+      const vtkm::Id k = cell / (cell_dims[0] * cell_dims[1]);
+      int above = 0;
+      int below = 0;
+      for(vtkm::Id dk = 0; dk < layers; ++dk)
+      {
+        for(vtkm::Id dj = 0; dj < 2; ++dj)
+        {
+          for(vtkm::Id di = 0; di < 2; ++di)
+          {
+            const vtkm::Id point = (i + di) + nx * ((j + dj) + ny * (k + dk));
+            const double value = static_cast<double>(portal.Get(point));
+            above += value > clip_value;
+            below += value < clip_value;
+          }
+        }
+      }
+      const int num_points = static_cast<int>(layers * 4);
+      // points on the clip value count as cut to match the clip exactly
+      const bool whole = invert ? below == num_points : above == num_points;
+      const bool gone = invert ? above == num_points : below == num_points;
+      keep[cell] = whole;
+      count += whole;
+      cut += !whole && !gone;
+    }
+    num_kept = cut == 0 ? count : -1;
+  }
+};
+
+struct SubsetFieldFunctor
+{
+  template<typename T, typename S>
+  void operator()(const vtkm::cont::ArrayHandle<T,S> &values,
+                  const vtkm::cont::ArrayHandle<vtkm::Id> &ids,
+                  vtkm::cont::VariantArrayHandle &output) const
+  {
+    vtkm::cont::ArrayHandle<T> subset;
+    vtkm::cont::ArrayCopy(vtkm::cont::make_ArrayHandlePermutation(ids, values), subset);
+    output = vtkm::cont::VariantArrayHandle(subset);
+  }
+};
+
+vtkm::Id cell_range_mask(const vtkm::cont::DataSet &dom,
+                         const std::string &field_name,
+                         const double min_value,
+                         const double max_value,
+                         std::vector<vtkm::UInt8> &keep)
+{
+  if(!dom.HasCellField(field_name))
+  {
+    return -1;
+  }
+  vtkm::Id num_kept = 0;
+  dom.GetCellField(field_name).GetData().ResetTypes(MaskFieldTypes{}).
+    CastAndCall(RangeMaskFunctor(), min_value, max_value, keep, num_kept);
+  return num_kept;
+}
+
+vtkm::Id clip_cell_mask(const vtkm::cont::DataSet &dom,
+                        const std::string &field_name,
+                        const double clip_value,
+                        const bool invert,
+                        std::vector<vtkm::UInt8> &keep)
+{
+  int topo_dims;
+  vtkm::Id3 cell_dims(1, 1, 1);
+  vtkm::Id3 point_start(0, 0, 0);
+  if(!dom.HasPointField(field_name) ||
+     !structured_dims(dom, topo_dims, cell_dims, point_start))
+  {
+    return -1;
+  }
+  vtkm::Id num_kept = 0;
+  dom.GetPointField(field_name).GetData().ResetTypes(MaskFieldTypes{}).
+    CastAndCall(ClipMaskFunctor(),
+                cell_dims,
+                topo_dims,
+                clip_value,
+                invert,
+                keep,
+                num_kept);
+  return num_kept;
+}
+
+bool extract_structured_box(const vtkm::cont::DataSet &dom,
+                            const std::vector<vtkm::UInt8> &keep,
+                            vtkm::cont::DataSet &output,
+                            ScratchArena *scratch)
+{
+  int topo_dims;
+  vtkm::Id3 cell_dims(1, 1, 1);
+  vtkm::Id3 point_start(0, 0, 0);
+  if(!structured_dims(dom, topo_dims, cell_dims, point_start))
+  {
+    return false;
+  }
+
+  if(static_cast<vtkm::Id>(keep.size()) != cell_dims[0] * cell_dims[1] * cell_dims[2])
+  {
+    return false;
+  }
+
+  // the box around the kept cells
+  vtkm::Id3 lo(cell_dims);
+  vtkm::Id3 hi(-1, -1, -1);
+  vtkm::Id num_kept = 0;
+  vtkm::Id cell = 0;
+  for(vtkm::Id k = 0; k < cell_dims[2]; ++k)
+  {
+    for(vtkm::Id j = 0; j < cell_dims[1]; ++j)
+    {
+      for(vtkm::Id i = 0; i < cell_dims[0]; ++i, ++cell)
+      {
+        if(keep[cell])
+        {
+          const vtkm::Id3 ijk(i, j, k);
+          for(int a = 0; a < 3; ++a)
+          {
+            lo[a] = std::min(lo[a], ijk[a]);
+            hi[a] = std::max(hi[a], ijk[a]);
+          }
+          num_kept++;
+        }
+      }
+    }
+  }
+
+  if(num_kept == 0)
+  {
+    return false;
+  }
+
+  const vtkm::Id3 box_cells(hi[0] - lo[0] + 1, hi[1] - lo[1] + 1, hi[2] - lo[2] + 1);
+  if(num_kept != box_cells[0] * box_cells[1] * box_cells[2])
+  {
+    // there are ghosts inside of the box
+    return false;
+  }
+
+  const vtkm::Id3 point_dims(cell_dims[0] + 1,
+                             cell_dims[1] + 1,
+                             topo_dims == 3 ? cell_dims[2] + 1 : 1);
+  const vtkm::Id3 box_points(box_cells[0] + 1,
+                             box_cells[1] + 1,
+                             topo_dims == 3 ? box_cells[2] + 1 : 1);
+
+  // the index lists only live until the fields are copied
+  std::vector<vtkm::Id> local_cell_ids;
+  std::vector<vtkm::Id> local_point_ids;
+  std::vector<vtkm::Id> &cell_id_values =
+    scratch != nullptr ? scratch->vector<vtkm::Id>("box_cell_ids") : local_cell_ids;
+  std::vector<vtkm::Id> &point_id_values =
+    scratch != nullptr ? scratch->vector<vtkm::Id>("box_point_ids") : local_point_ids;
+
+  cell_id_values.resize(box_cells[0] * box_cells[1] * box_cells[2]);
+  {
+    vtkm::Id *portal = cell_id_values.data();
+    vtkm::Id index = 0;
+    for(vtkm::Id k = 0; k < box_cells[2]; ++k)
+    {
+      for(vtkm::Id j = 0; j < box_cells[1]; ++j)
+      {
+        for(vtkm::Id i = 0; i < box_cells[0]; ++i)
+        {
+          portal[index++] = (lo[0] + i) + cell_dims[0] *
+                            ((lo[1] + j) + cell_dims[1] * (lo[2] + k));
+        }
+      }
+    }
+  }
+
+  point_id_values.resize(box_points[0] * box_points[1] * box_points[2]);
+  {
+    vtkm::Id *portal = point_id_values.data();
+    vtkm::Id index = 0;
+    for(vtkm::Id k = 0; k < box_points[2]; ++k)
+    {
+      for(vtkm::Id j = 0; j < box_points[1]; ++j)
+      {
+        for(vtkm::Id i = 0; i < box_points[0]; ++i)
+        {
+          portal[index++] = (lo[0] + i) + point_dims[0] *
+                            ((lo[1] + j) + point_dims[1] * (lo[2] + k));
+        }
+      }
+    }
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Id> cell_ids =
+    vtkm::cont::make_ArrayHandle(cell_id_values.data(),
+                                 static_cast<vtkm::Id>(cell_id_values.size()),
+                                 vtkm::CopyFlag::Off);
+  vtkm::cont::ArrayHandle<vtkm::Id> point_ids =
+    vtkm::cont::make_ArrayHandle(point_id_values.data(),
+                                 static_cast<vtkm::Id>(point_id_values.size()),
+                                 vtkm::CopyFlag::Off);
+
+  vtkm::cont::DataSet res;
+  const vtkm::cont::CoordinateSystem coords = dom.GetCoordinateSystem();
+  if(vtkh::VTKMDataSetInfo::IsUniform(dom))
+  {
+    auto points =
+      coords.GetData().AsArrayHandle<vtkm::cont::ArrayHandleUniformPointCoordinates>();
+    auto portal = points.ReadPortal();
+    auto origin = portal.GetOrigin();
+    auto spacing = portal.GetSpacing();
+    for(int a = 0; a < 3; ++a)
+    {
+      origin[a] += spacing[a] * static_cast<vtkm::FloatDefault>(lo[a]);
+    }
+    vtkm::cont::ArrayHandleUniformPointCoordinates box_coords(box_points,
+                                                              origin,
+                                                              spacing);
+    res.AddCoordinateSystem(vtkm::cont::CoordinateSystem(coords.GetName(), box_coords));
+  }
+  else if(vtkh::VTKMDataSetInfo::IsRectilinear(dom))
+  {
+    using AxisType = vtkm::cont::ArrayHandle<vtkm::FloatDefault>;
+    using Cartesian = vtkm::cont::ArrayHandleCartesianProduct<AxisType,
+                                                              AxisType,
+                                                              AxisType>;
+    auto points = coords.GetData().AsArrayHandle<Cartesian>();
+    auto portal = points.ReadPortal();
+    AxisType axes[3];
+    for(int a = 0; a < 3; ++a)
+    {
+      axes[a].Allocate(box_points[a]);
+      auto out = axes[a].WritePortal();
+      for(vtkm::Id i = 0; i < box_points[a]; ++i)
+      {
+        const vtkm::Id index = lo[a] + i;
+        out.Set(i, a == 0 ? portal.GetFirstPortal().Get(index) :
+                   a == 1 ? portal.GetSecondPortal().Get(index) :
+                            portal.GetThirdPortal().Get(index));
+      }
+    }
+    res.AddCoordinateSystem(
+      vtkm::cont::CoordinateSystem(coords.GetName(),
+        vtkm::cont::make_ArrayHandleCartesianProduct(axes[0], axes[1], axes[2])));
+  }
+  else
+  {
+    vtkm::cont::ArrayHandle<vtkm::Vec3f> all_coords;
+    vtkm::cont::ArrayCopy(coords.GetData(), all_coords);
+    vtkm::cont::ArrayHandle<vtkm::Vec3f> box_coords;
+    vtkm::cont::ArrayCopy(vtkm::cont::make_ArrayHandlePermutation(point_ids, all_coords),
+                          box_coords);
+    res.AddCoordinateSystem(vtkm::cont::CoordinateSystem(coords.GetName(), box_coords));
+  }
+
+  if(topo_dims == 3)
+  {
+    vtkm::cont::CellSetStructured<3> cells;
+    cells.SetPointDimensions(box_points);
+    cells.SetGlobalPointIndexStart(point_start + lo);
+    res.SetCellSet(cells);
+  }
+  else
+  {
+    vtkm::cont::CellSetStructured<2> cells;
+    cells.SetPointDimensions(vtkm::Id2(box_points[0], box_points[1]));
+    cells.SetGlobalPointIndexStart(vtkm::Id2(point_start[0] + lo[0],
+                                             point_start[1] + lo[1]));
+    res.SetCellSet(cells);
+  }
+
+  for(vtkm::IdComponent f = 0; f < dom.GetNumberOfFields(); ++f)
+  {
+    const vtkm::cont::Field &field = dom.GetField(f);
+    const vtkm::cont::Field::Association assoc = field.GetAssociation();
+    if(assoc == vtkm::cont::Field::Association::POINTS ||
+       assoc == vtkm::cont::Field::Association::CELL_SET)
+    {
+      const vtkm::cont::ArrayHandle<vtkm::Id> &ids =
+        assoc == vtkm::cont::Field::Association::POINTS ? point_ids : cell_ids;
+      vtkm::cont::VariantArrayHandle subset;
+      field.GetData().CastAndCall(SubsetFieldFunctor(), ids, subset);
+      res.AddField(vtkm::cont::Field(field.GetName(), assoc, subset));
+    }
+    else
+    {
+      res.AddField(field);
+    }
+  }
+
+  output = res;
+  return true;
+}
+
+vtkh::DataSet *select_cells(vtkh::DataSet &input,
+                            const CellMask &mask,
+                            vtkh::DataSet &remaining,
+                            ScratchArena *scratch)
+{
+  vtkh::DataSet *res = new vtkh::DataSet();
+  res->SetCycle(input.GetCycle());
+  remaining.SetCycle(input.GetCycle());
+
+  const vtkm::Id num_domains = input.GetNumberOfDomains();
+  for(vtkm::Id d = 0; d < num_domains; ++d)
+  {
+    vtkm::cont::DataSet dom;
+    vtkm::Id domain_id;
+    input.GetDomain(d, dom, domain_id);
+
+    std::vector<vtkm::UInt8> local_keep;
+    std::vector<vtkm::UInt8> &keep =
+      scratch != nullptr ? scratch->vector<vtkm::UInt8>("cell_mask") : local_keep;
+    const vtkm::Id num_kept = mask(dom, keep);
+    vtkm::cont::DataSet box;
+    if(num_kept == dom.GetNumberOfCells())
+    {
+      res->AddDomain(dom, domain_id);
+    }
+    else if(num_kept == 0)
+    {
+      // nothing left of this domain
+      continue;
+    }
+    else if(num_kept > 0 && extract_structured_box(dom, keep, box, scratch))
+    {
+      res->AddDomain(box, domain_id);
+    }
+    else
+    {
+      remaining.AddDomain(dom, domain_id);
+    }
+  }
+  return res;
+}
+
+void add_domains(vtkh::DataSet &from, vtkh::DataSet &to)
+{
+  const vtkm::Id num_domains = from.GetNumberOfDomains();
+  for(vtkm::Id d = 0; d < num_domains; ++d)
+  {
+    vtkm::cont::DataSet dom;
+    vtkm::Id domain_id;
+    from.GetDomain(d, dom, domain_id);
+    to.AddDomain(dom, domain_id);
+  }
+}
+
 } // namespace detail
 //-----------------------------------------------------------------------------
 };
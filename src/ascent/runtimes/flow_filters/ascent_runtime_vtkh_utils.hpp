@@ -54,6 +54,8 @@
 
 #include <ascent_data_object.hpp>
 #include <ascent_vtkh_collection.hpp>
+#include <ascent_runtime_scratch_arena.hpp>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -96,6 +98,72 @@ std::string resolve_topology(const conduit::Node &params,
                              std::shared_ptr<VTKHCollection> collection,
                              bool error = true);
 
+// append parts of the same domain (e.g. contours of several fields, or
+// slices and clips) into one data set. Parts with no cells are skipped.
+// Parts must have single type or explicit cell sets. The result keeps a
+// single type cell set when every part has the same shape and is
+// explicit otherwise. Coordinates stay float32 if every part has float32
+// coordinates, and are float64 otherwise. Only the fields that every
+// part has are kept.
+vtkm::cont::DataSet append_data_sets(const std::vector<vtkm::cont::DataSet> &parts);
+
+// append the parts of each domain of several vtk-h data sets into one
+// data set. The cells from parts[i] get the value i in the cell field
+// 'id_field', unless it is empty.
+vtkh::DataSet *append_data_sets(const std::vector<vtkh::DataSet*> &parts,
+                                const std::string &id_field);
+
+// flags the cells of the domain whose cell field value is inside
+// [min_value, max_value]. Returns the number of flagged cells, or -1 if
+// the domain does not have the field as a cell field.
+vtkm::Id cell_range_mask(const vtkm::cont::DataSet &dom,
+                         const std::string &field_name,
+                         const double min_value,
+                         const double max_value,
+                         std::vector<vtkm::UInt8> &keep);
+
+// flags the cells of a structured domain that a clip by a point field
+// keeps whole (all points above the clip value, or below if inverted).
+// Returns the number of flagged cells, or -1 if the domain is not
+// structured, does not have the field as a point field, or the clip
+// cuts through any cell.
+vtkm::Id clip_cell_mask(const vtkm::cont::DataSet &dom,
+                        const std::string &field_name,
+                        const double clip_value,
+                        const bool invert,
+                        std::vector<vtkm::UInt8> &keep);
+
+// shrinks a structured domain (uniform, rectilinear or curvilinear) to
+// the cells flagged in keep. This only works when the flagged cells form
+// a single box (e.g., ghosts in a boundary layer), and the result stays
+// structured. Uniform and rectilinear coordinates stay implicit. Returns
+// false and leaves output untouched otherwise. Index lists are kept in
+// 'scratch' when one is given.
+bool extract_structured_box(const vtkm::cont::DataSet &dom,
+                            const std::vector<vtkm::UInt8> &keep,
+                            vtkm::cont::DataSet &output,
+                            ScratchArena *scratch = nullptr);
+
+// flags the cells of a domain to keep and returns the number of flagged
+// cells, or -1 if the domain needs the general filter
+using CellMask = std::function<vtkm::Id(const vtkm::cont::DataSet &dom,
+                                        std::vector<vtkm::UInt8> &keep)>;
+
+// selects the cells of each domain without building explicit cell sets
+// where possible: domains with every cell flagged are passed through,
+// domains with no flagged cells are dropped, and structured domains whose
+// flagged cells form a box are shrunk with extract_structured_box. All
+// other domains are added to 'remaining' so the caller can run the
+// general VTK-h filter on them. Masks are kept in 'scratch' when one is
+// given. The caller owns the result.
+vtkh::DataSet *select_cells(vtkh::DataSet &input,
+                            const CellMask &mask,
+                            vtkh::DataSet &remaining,
+                            ScratchArena *scratch = nullptr);
+
+// adds all of the domains of 'from' to 'to'
+void add_domains(vtkh::DataSet &from, vtkh::DataSet &to);
+
 } // namespace detail
 //-----------------------------------------------------------------------------
 };
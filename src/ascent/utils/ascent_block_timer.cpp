@@ -49,6 +49,7 @@
 //-----------------------------------------------------------------------------
 
 #include "ascent_block_timer.hpp"
+#include <flow_trace.hpp>
 #include <climits>
 #include <math.h>
 #include <stdio.h>
@@ -139,6 +140,8 @@ BlockTimer::Start(const std::string &name)
 #else
     s_rank = 0;
 #endif
+    // also shows up in the unified trace when tracing is enabled
+    flow::Trace::begin(name);
 
     ++s_global_depth;
 
@@ -161,6 +164,7 @@ BlockTimer::Start(const std::string &name)
 void
 BlockTimer::Stop(const std::string &name)
 {
+    flow::Trace::end();
 #ifdef ASCENT_MPI_ENABLED
     //MPI_Barrier(MPI_COMM_WORLD);
 #endif
@@ -66,6 +66,15 @@ using namespace std;
 namespace flow
 {
 
+//-----------------------------------------------------------------------------
+template <>
+conduit::index_t
+data_size_in_bytes<conduit::Node>(const conduit::Node *data)
+{
+    // only counts memory owned by the node, not externally described data
+    return data->total_bytes_allocated();
+}
+
 //-----------------------------------------------------------------------------
 Data::Data(void *data)
 :m_data_ptr(data)
@@ -99,6 +108,20 @@ Data::data_ptr() const
 {
     return m_data_ptr;
 }
+//-----------------------------------------------------------------------------
+conduit::index_t
+Data::size_in_bytes() const
+{
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+void
+Data::release_cached()
+{
+    // empty
+}
+
 //-----------------------------------------------------------------------------
 void
 Data::info(Node &out) const
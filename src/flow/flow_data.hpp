@@ -84,6 +84,32 @@ namespace flow
 template <class T>
 class DataWrapper;
 
+//-----------------------------------------------------------------------------
+/// Memory accounting hooks used by DataWrapper<T>.
+///
+/// data_size_in_bytes() returns an estimate of the memory held by an object,
+/// data_release_cached() drops anything the object can recreate on demand
+/// (for example converted representations of a data set). Types without a
+/// specialization report zero bytes and hold no cache.
+///
+/// Specializations must be declared along side the type they support, so
+/// they are visible everywhere the type is wrapped.
+//-----------------------------------------------------------------------------
+template <class T>
+conduit::index_t data_size_in_bytes(const T *)
+{
+    return 0;
+}
+
+template <class T>
+void data_release_cached(T *)
+{
+    // empty
+}
+
+template <>
+FLOW_API conduit::index_t data_size_in_bytes<conduit::Node>(const conduit::Node *data);
+
 //-----------------------------------------------------------------------------
 class FLOW_API Data
 {
@@ -98,6 +124,11 @@ public:
     // actually delete the data
     virtual void            release() = 0;
 
+    // estimate of the memory held by the data
+    virtual conduit::index_t size_in_bytes() const;
+    // drop any state the data can recreate on demand
+    virtual void             release_cached();
+
     void          *data_ptr();
     const  void   *data_ptr() const;
 
@@ -166,6 +197,23 @@ class FLOW_API DataWrapper: public Data
             set_data_ptr(NULL);
         }
     }
+
+    virtual conduit::index_t size_in_bytes() const
+    {
+        if(data_ptr() == NULL)
+        {
+            return 0;
+        }
+        return data_size_in_bytes(static_cast<const T*>(data_ptr()));
+    }
+
+    virtual void release_cached()
+    {
+        if(data_ptr() != NULL)
+        {
+            data_release_cached(static_cast<T*>(data_ptr()));
+        }
+    }
 };
 
 
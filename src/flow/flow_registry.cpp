@@ -112,9 +112,13 @@ public:
 
             void          *data_ptr();
 
+            index_t        bytes() const;
+            void           set_bytes(index_t bytes);
+
         private:
             Ref            m_ref;
             Data *m_data;
+            index_t        m_bytes;
     };
 
     class Entry
@@ -157,11 +161,21 @@ public:
 
     void   reset();
 
+    void    update_size(Value *value);
+    index_t release_cached();
+
+    index_t live_bytes() const;
+    index_t peak_bytes() const;
+    void    reset_peak_bytes();
+
 private:
 
     std::map<void*,Value*>         m_values;
     std::map<std::string,Entry*>   m_entries;
 
+    index_t                        m_live_bytes;
+    index_t                        m_peak_bytes;
+
 };
 
 
@@ -251,7 +265,8 @@ Registry::Map::Ref::inc(int amt)
 Registry::Map::Value::Value(Data &data,
                             int refs_needed)
 :m_ref(refs_needed),
- m_data(NULL)
+ m_data(NULL),
+ m_bytes(0)
 {
     m_data = data.wrap(data.data_ptr());
 }
@@ -288,6 +303,20 @@ Registry::Map::Value::ref()
     return &m_ref;
 }
 
+//-----------------------------------------------------------------------------
+index_t
+Registry::Map::Value::bytes() const
+{
+    return m_bytes;
+}
+
+//-----------------------------------------------------------------------------
+void
+Registry::Map::Value::set_bytes(index_t bytes)
+{
+    m_bytes = bytes;
+}
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 //
@@ -349,6 +378,8 @@ Registry::Map::Entry::data()
 //-----------------------------------------------------------------------------
 
 Registry::Map::Map()
+: m_live_bytes(0),
+  m_peak_bytes(0)
 {
 
 }
@@ -393,9 +424,61 @@ Registry::Map::add(const std::string &key,
 
         Entry *ent = new Entry(val,refs_needed);
         m_entries[key] = ent;
+
+        update_size(val);
     }
 }
 
+//-----------------------------------------------------------------------------
+void
+Registry::Map::update_size(Value *value)
+{
+    index_t bytes = value->data()->size_in_bytes();
+    m_live_bytes += bytes - value->bytes();
+    value->set_bytes(bytes);
+
+    if(m_live_bytes > m_peak_bytes)
+    {
+        m_peak_bytes = m_live_bytes;
+    }
+}
+
+//-----------------------------------------------------------------------------
+index_t
+Registry::Map::release_cached()
+{
+    index_t before = m_live_bytes;
+    std::map<void*,Value*>::iterator vitr;
+    for(vitr = m_values.begin(); vitr != m_values.end(); vitr++)
+    {
+        Value *v = vitr->second;
+        v->data()->release_cached();
+        update_size(v);
+    }
+    return before - m_live_bytes;
+}
+
+//-----------------------------------------------------------------------------
+index_t
+Registry::Map::live_bytes() const
+{
+    return m_live_bytes;
+}
+
+//-----------------------------------------------------------------------------
+index_t
+Registry::Map::peak_bytes() const
+{
+    return m_peak_bytes;
+}
+
+//-----------------------------------------------------------------------------
+void
+Registry::Map::reset_peak_bytes()
+{
+    m_peak_bytes = m_live_bytes;
+}
+
 //-----------------------------------------------------------------------------
 Registry::Map::Entry *
 Registry::Map::fetch_entry(const std::string &key)
@@ -460,6 +543,7 @@ Registry::Map::dec(const std::string &key)
 
         rel_info[oss.str()]["pending"] = value->ref()->pending();
 
+        m_live_bytes -= value->bytes();
         value->data()->release();
 
         // clean up bookkeeping obj
@@ -498,6 +582,7 @@ Registry::Map::info(Node &out) const
     {
         Entry *ent = eitr->second;
         ents[eitr->first]["pending"] = ent->ref()->pending();
+        ents[eitr->first]["bytes"] = ent->value()->bytes();
         ent->data()->info(ents[eitr->first]["data"]);
     }
 
@@ -511,9 +596,13 @@ Registry::Map::info(Node &out) const
         oss << vitr->first;
         Value *v= vitr->second;
         ptrs[oss.str()]["pending"] = v->ref()->pending();
+        ptrs[oss.str()]["bytes"] = v->bytes();
         oss.str("");
     }
 
+    out["live_bytes"] = m_live_bytes;
+    out["peak_bytes"] = m_peak_bytes;
+
 }
 
 //-----------------------------------------------------------------------------
@@ -552,6 +641,9 @@ Registry::Map::reset()
     }
 
     m_values.clear();
+
+    m_live_bytes = 0;
+    m_peak_bytes = 0;
 }
 
 
@@ -607,6 +699,55 @@ Registry::reset()
     m_map->reset();
 }
 
+//-----------------------------------------------------------------------------
+void
+Registry::update_size(const std::string &key)
+{
+    if(m_map->has_entry(key))
+    {
+        m_map->update_size(m_map->fetch_entry(key)->value());
+    }
+}
+
+//-----------------------------------------------------------------------------
+index_t
+Registry::size_in_bytes(const std::string &key)
+{
+    if(!m_map->has_entry(key))
+    {
+        return 0;
+    }
+    return m_map->fetch_entry(key)->value()->bytes();
+}
+
+//-----------------------------------------------------------------------------
+index_t
+Registry::release_cached()
+{
+    return m_map->release_cached();
+}
+
+//-----------------------------------------------------------------------------
+index_t
+Registry::live_bytes() const
+{
+    return m_map->live_bytes();
+}
+
+//-----------------------------------------------------------------------------
+index_t
+Registry::peak_bytes() const
+{
+    return m_map->peak_bytes();
+}
+
+//-----------------------------------------------------------------------------
+void
+Registry::reset_peak_bytes()
+{
+    m_map->reset_peak_bytes();
+}
+
 
 //-----------------------------------------------------------------------------
 void
@@ -170,6 +170,24 @@ public:
     /// tracked data refs.
     void           reset();
 
+    /// re-measures the memory held by an entry's data
+    /// (data can grow after it is added, e.g. lazily converted data sets)
+    void             update_size(const std::string &key);
+
+    /// last measured size of an entry's data
+    conduit::index_t size_in_bytes(const std::string &key);
+
+    /// asks all entries to drop state they can recreate on demand,
+    /// returns the number of bytes freed
+    conduit::index_t release_cached();
+
+    /// estimate of the memory held by all registry entries
+    conduit::index_t live_bytes() const;
+
+    /// high-water mark of live_bytes() since the last reset_peak_bytes()
+    conduit::index_t peak_bytes() const;
+    void             reset_peak_bytes();
+
     /// create human understandable tree that describes the state
     /// of the registry
     void           info(conduit::Node &out) const;
@@ -0,0 +1,527 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: flow_trace.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "flow_trace.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+
+#include <conduit.hpp>
+
+using namespace std::chrono;
+
+//-----------------------------------------------------------------------------
+// -- begin flow:: --
+//-----------------------------------------------------------------------------
+namespace flow
+{
+
+//-----------------------------------------------------------------------------
+// -- begin flow::detail --
+//-----------------------------------------------------------------------------
+namespace detail
+{
+
+//-----------------------------------------------------------------------------
+struct TraceEvent
+{
+    int       name_id;
+    int       depth;
+    long long start;     // ns since the trace epoch
+    long long duration;  // ns
+};
+
+//-----------------------------------------------------------------------------
+struct TraceOpen
+{
+    int       name_id;
+    long long start;
+};
+
+//-----------------------------------------------------------------------------
+struct TraceBuffer
+{
+    int                     tid;
+    std::vector<TraceEvent> events;  // ring, sized once on creation
+    size_t                  head;    // next slot to write
+    size_t                  count;
+    std::vector<TraceOpen>  open;    // stack of begins without an end
+};
+
+//-----------------------------------------------------------------------------
+struct TraceState
+{
+    TraceState()
+    : enabled(false),
+      capacity(1 << 16),
+      rank(0),
+      epoch(steady_clock::now()),
+      epoch_set(false)
+    {}
+
+    std::atomic<bool>                         enabled;
+    int                                       capacity;
+    int                                       rank;
+    steady_clock::time_point                  epoch;
+    bool                                      epoch_set;
+
+    std::mutex                                mutex;
+    std::unordered_map<std::string,int>       name_ids;
+    std::vector<std::string>                  names;
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+};
+
+//-----------------------------------------------------------------------------
+TraceState &
+trace_state()
+{
+    // never destroyed, buffers may be touched by threads during exit
+    static TraceState *state = new TraceState();
+    return *state;
+}
+
+thread_local TraceBuffer *t_trace_buffer = nullptr;
+
+// ids of the names this thread has traced, so call sites that only have a
+// name don't take the intern lock every time
+thread_local std::unordered_map<std::string,int> *t_trace_name_ids = nullptr;
+
+//-----------------------------------------------------------------------------
+int
+thread_name_id(const std::string &name)
+{
+    if(t_trace_name_ids == nullptr)
+    {
+        // leaked like the buffers, threads may trace during exit
+        t_trace_name_ids = new std::unordered_map<std::string,int>();
+    }
+    auto itr = t_trace_name_ids->find(name);
+    if(itr != t_trace_name_ids->end())
+    {
+        return itr->second;
+    }
+    const int id = Trace::intern(name);
+    (*t_trace_name_ids)[name] = id;
+    return id;
+}
+
+//-----------------------------------------------------------------------------
+TraceBuffer &
+thread_trace_buffer()
+{
+    if(t_trace_buffer == nullptr)
+    {
+        TraceState &state = trace_state();
+        std::shared_ptr<TraceBuffer> buffer = std::make_shared<TraceBuffer>();
+        buffer->events.resize(state.capacity > 0 ? state.capacity : 1);
+        buffer->head  = 0;
+        buffer->count = 0;
+        buffer->open.reserve(64);
+
+        std::lock_guard<std::mutex> lock(state.mutex);
+        buffer->tid = (int) state.buffers.size();
+        state.buffers.push_back(buffer);
+        t_trace_buffer = buffer.get();
+    }
+    return *t_trace_buffer;
+}
+
+//-----------------------------------------------------------------------------
+long long
+trace_now()
+{
+    return duration_cast<nanoseconds>(steady_clock::now() -
+                                      trace_state().epoch).count();
+}
+
+//-----------------------------------------------------------------------------
+void
+json_escape(const std::string &str, std::ostream &os)
+{
+    for(size_t i = 0; i < str.size(); ++i)
+    {
+        const char c = str[i];
+        if(c == '"' || c == '\\')
+        {
+            os << '\\' << c;
+        }
+        else if(c == '\n')
+        {
+            os << "\\n";
+        }
+        else if((unsigned char)c < 0x20)
+        {
+            os << ' ';
+        }
+        else
+        {
+            os << c;
+        }
+    }
+}
+
+};
+//-----------------------------------------------------------------------------
+// -- end flow::detail --
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+void
+Trace::enable()
+{
+    detail::TraceState &state = detail::trace_state();
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if(!state.epoch_set)
+        {
+            state.epoch = steady_clock::now();
+            state.epoch_set = true;
+        }
+    }
+    state.enabled = true;
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::disable()
+{
+    detail::trace_state().enabled = false;
+}
+
+//-----------------------------------------------------------------------------
+bool
+Trace::enabled()
+{
+    return detail::trace_state().enabled.load(std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::set_buffer_capacity(int capacity)
+{
+    if(capacity < 1)
+    {
+        CONDUIT_ERROR("Trace buffer capacity must be positive, given "
+                      << capacity);
+    }
+    detail::TraceState &state = detail::trace_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.capacity = capacity;
+}
+
+//-----------------------------------------------------------------------------
+int
+Trace::buffer_capacity()
+{
+    return detail::trace_state().capacity;
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::set_rank(int rank)
+{
+    detail::trace_state().rank = rank;
+}
+
+//-----------------------------------------------------------------------------
+int
+Trace::rank()
+{
+    return detail::trace_state().rank;
+}
+
+//-----------------------------------------------------------------------------
+int
+Trace::intern(const std::string &name)
+{
+    detail::TraceState &state = detail::trace_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    auto itr = state.name_ids.find(name);
+    if(itr != state.name_ids.end())
+    {
+        return itr->second;
+    }
+    const int id = (int) state.names.size();
+    state.names.push_back(name);
+    state.name_ids[name] = id;
+    return id;
+}
+
+//-----------------------------------------------------------------------------
+std::string
+Trace::name(int name_id)
+{
+    detail::TraceState &state = detail::trace_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if(name_id < 0 || name_id >= (int) state.names.size())
+    {
+        return "";
+    }
+    return state.names[name_id];
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::begin(int name_id)
+{
+    if(!enabled())
+    {
+        // keep a placeholder so the matching end() pops it rather than
+        // an enclosing event, even if tracing is enabled in between.
+        // threads that never traced have nothing open to protect.
+        detail::TraceBuffer *buffer = detail::t_trace_buffer;
+        if(buffer != nullptr)
+        {
+            detail::TraceOpen skipped;
+            skipped.name_id = -1;
+            skipped.start   = 0;
+            buffer->open.push_back(skipped);
+        }
+        return;
+    }
+    detail::TraceBuffer &buffer = detail::thread_trace_buffer();
+    detail::TraceOpen open;
+    open.name_id = name_id;
+    open.start   = detail::trace_now();
+    buffer.open.push_back(open);
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::begin(const std::string &name)
+{
+    begin(enabled() ? detail::thread_name_id(name) : -1);
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::end()
+{
+    detail::TraceBuffer *buffer = detail::t_trace_buffer;
+    if(buffer == nullptr || buffer->open.empty())
+    {
+        return;
+    }
+
+    const long long stop = detail::trace_now();
+    const detail::TraceOpen open = buffer->open.back();
+    buffer->open.pop_back();
+
+    // events that began before a disable are still closed,
+    // but only recorded while tracing is enabled
+    if(open.name_id < 0 || !enabled())
+    {
+        return;
+    }
+
+    detail::TraceEvent &event = buffer->events[buffer->head];
+    event.name_id  = open.name_id;
+    event.depth    = (int) buffer->open.size();
+    event.start    = open.start;
+    event.duration = stop - open.start;
+
+    buffer->head = (buffer->head + 1) % buffer->events.size();
+    if(buffer->count < buffer->events.size())
+    {
+        buffer->count++;
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::clear()
+{
+    detail::TraceState &state = detail::trace_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    for(size_t i = 0; i < state.buffers.size(); ++i)
+    {
+        state.buffers[i]->events.resize(state.capacity);
+        state.buffers[i]->head  = 0;
+        state.buffers[i]->count = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+int
+Trace::number_of_events()
+{
+    detail::TraceState &state = detail::trace_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    size_t res = 0;
+    for(size_t i = 0; i < state.buffers.size(); ++i)
+    {
+        res += state.buffers[i]->count;
+    }
+    return (int) res;
+}
+
+//-----------------------------------------------------------------------------
+std::string
+Trace::events_json()
+{
+    detail::TraceState &state = detail::trace_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    std::ostringstream oss;
+    const int pid = state.rank;
+    bool first = true;
+
+    // name the process so ranks are labeled in the viewer
+    oss << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+        << ",\"tid\":0,\"args\":{\"name\":\"rank " << pid << "\"}}";
+    first = false;
+
+    for(size_t b = 0; b < state.buffers.size(); ++b)
+    {
+        const detail::TraceBuffer &buffer = *state.buffers[b];
+        const size_t cap = buffer.events.size();
+        // oldest event is at head when the ring has wrapped
+        const size_t start = buffer.count < cap ? 0 : buffer.head;
+        for(size_t i = 0; i < buffer.count; ++i)
+        {
+            const detail::TraceEvent &event = buffer.events[(start + i) % cap];
+            if(!first)
+            {
+                oss << ",\n";
+            }
+            first = false;
+            oss << "{\"name\":\"";
+            detail::json_escape(state.names[event.name_id], oss);
+            // chrome trace timestamps are in microseconds
+            oss << "\",\"ph\":\"X\""
+                << ",\"ts\":"  << event.start / 1000
+                << "." << (event.start % 1000) / 100
+                << ",\"dur\":" << event.duration / 1000
+                << "." << (event.duration % 1000) / 100
+                << ",\"pid\":" << pid
+                << ",\"tid\":" << buffer.tid
+                << ",\"args\":{\"depth\":" << event.depth << "}}";
+        }
+    }
+    return oss.str();
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::write_chrome_trace(const std::string &file_name,
+                          const std::vector<std::string> &events)
+{
+    std::ofstream ofs(file_name.c_str());
+    if(!ofs.is_open())
+    {
+        CONDUIT_ERROR("Failed to open trace file '" << file_name << "'");
+    }
+    ofs << "{\"displayTimeUnit\":\"ms\",\n\"traceEvents\":[\n";
+    bool first = true;
+    for(size_t i = 0; i < events.size(); ++i)
+    {
+        if(events[i].empty())
+        {
+            continue;
+        }
+        if(!first)
+        {
+            ofs << ",\n";
+        }
+        first = false;
+        ofs << events[i];
+    }
+    ofs << "\n]}\n";
+}
+
+//-----------------------------------------------------------------------------
+void
+Trace::write_chrome_trace(const std::string &file_name)
+{
+    std::vector<std::string> events;
+    events.push_back(events_json());
+    write_chrome_trace(file_name, events);
+}
+
+//-----------------------------------------------------------------------------
+TraceScope::TraceScope(int name_id)
+: m_active(Trace::enabled())
+{
+    if(m_active)
+    {
+        Trace::begin(name_id);
+    }
+}
+
+//-----------------------------------------------------------------------------
+TraceScope::TraceScope(const std::string &name)
+: m_active(Trace::enabled())
+{
+    if(m_active)
+    {
+        Trace::begin(detail::thread_name_id(name));
+    }
+}
+
+//-----------------------------------------------------------------------------
+TraceScope::~TraceScope()
+{
+    if(m_active)
+    {
+        Trace::end();
+    }
+}
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end flow:: --
+//-----------------------------------------------------------------------------
+
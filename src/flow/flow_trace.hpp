@@ -0,0 +1,165 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: flow_trace.hpp
+///
+//-----------------------------------------------------------------------------
+
+#ifndef FLOW_TRACE_HPP
+#define FLOW_TRACE_HPP
+
+#include <flow_exports.h>
+
+#include <string>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// -- begin flow:: --
+//-----------------------------------------------------------------------------
+namespace flow
+{
+
+//-----------------------------------------------------------------------------
+///
+/// Low overhead hierarchical tracing.
+///
+/// Each thread records completed begin/end pairs into its own preallocated
+/// ring buffer (no locks on the record path). Names are interned once into
+/// integer ids, so hot call sites should use FLOW_TRACE_SCOPE, which caches
+/// the id in a function local static.
+///
+/// Recorded events can be exported as Chrome trace event json
+/// (chrome://tracing, https://ui.perfetto.dev), using the rank as the
+/// process id and a per process thread index as the thread id.
+///
+/// Exporting and clearing are not synchronized with recording, call
+/// events_json() and clear() while no other thread is tracing.
+///
+//-----------------------------------------------------------------------------
+class FLOW_API Trace
+{
+public:
+    /// recording is disabled by default
+    static void        enable();
+    static void        disable();
+    static bool        enabled();
+
+    /// number of events each thread keeps before overwriting the oldest,
+    /// applies to threads that have not recorded yet and to every
+    /// thread on the next clear()
+    static void        set_buffer_capacity(int capacity);
+    static int         buffer_capacity();
+
+    /// process id used for exported events (typically the mpi rank)
+    static void        set_rank(int rank);
+    static int         rank();
+
+    /// returns the id for the given name, registering it if needed
+    static int         intern(const std::string &name);
+    static std::string name(int name_id);
+
+    /// manual begin / end pairs, ends always close the most recent
+    /// begin on the calling thread. Pairs stay matched when tracing is
+    /// enabled or disabled between them. Names are interned once per
+    /// thread.
+    static void        begin(int name_id);
+    static void        begin(const std::string &name);
+    static void        end();
+
+    /// drops all recorded events and applies the buffer capacity,
+    /// interned names are kept
+    static void        clear();
+
+    /// number of events currently held by all thread buffers
+    static int         number_of_events();
+
+    /// comma separated chrome trace event objects for this process
+    static std::string events_json();
+
+    /// writes a chrome trace json document containing the passed
+    /// event lists (results of events_json(), possibly from many ranks)
+    static void        write_chrome_trace(const std::string &file_name,
+                                          const std::vector<std::string> &events);
+    /// writes a chrome trace json document for this process
+    static void        write_chrome_trace(const std::string &file_name);
+};
+
+//-----------------------------------------------------------------------------
+/// Records an event covering the lifetime of the object.
+//-----------------------------------------------------------------------------
+class FLOW_API TraceScope
+{
+public:
+    explicit TraceScope(int name_id);
+    explicit TraceScope(const std::string &name);
+            ~TraceScope();
+private:
+    bool m_active;
+};
+
+//-----------------------------------------------------------------------------
+};
+//-----------------------------------------------------------------------------
+// -- end flow:: --
+//-----------------------------------------------------------------------------
+
+#define FLOW_TRACE_CONCAT_IMPL(a, b) a##b
+#define FLOW_TRACE_CONCAT(a, b) FLOW_TRACE_CONCAT_IMPL(a, b)
+
+//-----------------------------------------------------------------------------
+/// Traces the enclosing scope, the name is interned once per call site.
+//-----------------------------------------------------------------------------
+#define FLOW_TRACE_SCOPE(name)                                              \
+    static const int FLOW_TRACE_CONCAT(flow_trace_id_, __LINE__) =          \
+        flow::Trace::intern(name);                                          \
+    flow::TraceScope FLOW_TRACE_CONCAT(flow_trace_scope_, __LINE__)         \
+        (FLOW_TRACE_CONCAT(flow_trace_id_, __LINE__))
+
+#endif
+//-----------------------------------------------------------------------------
+// -- end header ifdef guard
+//-----------------------------------------------------------------------------
+
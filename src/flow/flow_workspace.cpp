@@ -51,12 +51,16 @@
 
 #include "flow_workspace.hpp"
 #include "flow_timer.hpp"
+#include "flow_trace.hpp"
 
 // standard lib includes
 #include <iostream>
 #include <string.h>
 #include <limits.h>
 #include <cstdlib>
+#include <algorithm>
+#include <atomic>
+#include <vector>
 
 using namespace conduit;
 using namespace std;
@@ -72,7 +76,8 @@ namespace flow
 // pick a safe non-inited value w/o the mpi headers, but
 // we will try this strategy.
 int Workspace::m_default_mpi_comm = -1;
-static int g_timing_exec_count = 0;
+// workspaces of concurrent evaluations bump this from several threads
+static std::atomic<int> g_timing_exec_count(0);
 
 //-----------------------------------------------------------------------------
 class Workspace::ExecutionPlan
@@ -82,10 +87,22 @@ class Workspace::ExecutionPlan
         static void generate(Graph &g,
                              conduit::Node &traversals);
 
+        // orders all filters in a single traversal to keep the estimated
+        // live memory low, returns false (leaving the default plan in
+        // traversals) if an estimate is missing for any filter output
+        static bool generate_memory_aware(Graph &g,
+                                          const std::map<std::string,index_t> &estimates,
+                                          conduit::Node &traversals);
+
     private:
         ExecutionPlan();
         ~ExecutionPlan();
 
+        // true if all inputs are done (or are the given filter)
+        static bool ready(const std::vector<int> &inputs,
+                          const std::vector<bool> &done,
+                          int also_done);
+
         static void bf_topo_sort_visit(Graph &graph,
                                        const std::string &filter_name,
                                        conduit::Node &tags,
@@ -186,6 +203,159 @@ Workspace::ExecutionPlan::generate(Graph &graph,
 }
 
 
+//-----------------------------------------------------------------------------
+bool
+Workspace::ExecutionPlan::ready(const std::vector<int> &inputs,
+                                const std::vector<bool> &done,
+                                int also_done)
+{
+    for(size_t i = 0; i < inputs.size(); ++i)
+    {
+        if(!done[inputs[i]] && inputs[i] != also_done)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+bool
+Workspace::ExecutionPlan::generate_memory_aware(Graph &graph,
+                                                const std::map<std::string,index_t> &estimates,
+                                                conduit::Node &traversals)
+{
+    // the default plan validates the graph and gives us the
+    // filters to run, their refs, and an order for breaking ties
+    generate(graph, traversals);
+
+    std::vector<std::string>   names;
+    std::map<std::string,int>  urefs;
+
+    NodeConstIterator travs_itr = traversals.children();
+    while(travs_itr.has_next())
+    {
+        NodeConstIterator trav_itr(&travs_itr.next());
+        while(trav_itr.has_next())
+        {
+            const Node &t = trav_itr.next();
+            names.push_back(trav_itr.name());
+            urefs[trav_itr.name()] = t.to_int32();
+        }
+    }
+
+    const int num_filters = (int) names.size();
+    std::vector<index_t> output_bytes(num_filters, 0);
+    std::map<std::string,int> name_idx;
+
+    for(int i = 0; i < num_filters; ++i)
+    {
+        name_idx[names[i]] = i;
+        if(graph.m_filters[names[i]]->output_port())
+        {
+            std::map<std::string,index_t>::const_iterator itr;
+            itr = estimates.find(names[i]);
+            if(itr == estimates.end())
+            {
+                // no estimate, keep the default plan
+                return false;
+            }
+            output_bytes[i] = itr->second;
+        }
+    }
+
+    // inputs (one per port, so an output can feed several ports)
+    // and how many port reads of each output are still pending
+    std::vector<std::vector<int>> inputs(num_filters);
+    std::vector<std::vector<int>> consumers(num_filters);
+    std::vector<int> pending_reads(num_filters, 0);
+
+    for(int i = 0; i < num_filters; ++i)
+    {
+        NodeConstIterator f_inputs(&graph.edges_in(names[i]));
+        while(f_inputs.has_next())
+        {
+            int in_idx = name_idx[f_inputs.next().as_string()];
+            inputs[i].push_back(in_idx);
+            consumers[in_idx].push_back(i);
+            pending_reads[in_idx]++;
+        }
+    }
+
+    // greedy list scheduling: among the filters whose inputs are ready,
+    // run the one that grows the live memory the least (its output minus
+    // the inputs it is the last reader of). Ties go to the filter that
+    // makes the most consumers ready (so its output can be reduced right
+    // away), then to the default order.
+    std::vector<bool> done(num_filters, false);
+    std::vector<int>  order;
+
+    while((int) order.size() < num_filters)
+    {
+        int     best = -1;
+        index_t best_delta = 0;
+        int     best_unlocks = 0;
+
+        for(int i = 0; i < num_filters; ++i)
+        {
+            if(done[i] || !ready(inputs[i], done, -1))
+            {
+                continue;
+            }
+
+            index_t delta = output_bytes[i];
+            std::map<int,int> reads;
+            for(size_t p = 0; p < inputs[i].size(); ++p)
+            {
+                reads[inputs[i][p]]++;
+            }
+
+            std::map<int,int>::const_iterator ritr;
+            for(ritr = reads.begin(); ritr != reads.end(); ritr++)
+            {
+                if(pending_reads[ritr->first] == ritr->second)
+                {
+                    delta -= output_bytes[ritr->first];
+                }
+            }
+
+            int unlocks = 0;
+            for(size_t c = 0; c < consumers[i].size(); ++c)
+            {
+                if(ready(inputs[consumers[i][c]], done, i))
+                {
+                    unlocks++;
+                }
+            }
+
+            if(best == -1 ||
+               delta < best_delta ||
+               (delta == best_delta && unlocks > best_unlocks))
+            {
+                best = i;
+                best_delta = delta;
+                best_unlocks = unlocks;
+            }
+        }
+
+        done[best] = true;
+        order.push_back(best);
+        for(size_t p = 0; p < inputs[best].size(); ++p)
+        {
+            pending_reads[inputs[best][p]]--;
+        }
+    }
+
+    traversals.reset();
+    Node &trav = traversals.append();
+    for(int i = 0; i < num_filters; ++i)
+    {
+        trav[names[order[i]]] = urefs[names[order[i]]];
+    }
+
+    return true;
+}
+
 //-----------------------------------------------------------------------------
 void
 Workspace::ExecutionPlan::bf_topo_sort_visit(Graph &graph,
@@ -252,7 +422,12 @@ Workspace::ExecutionPlan::bf_topo_sort_visit(Graph &graph,
 Workspace::Workspace()
 :m_graph(this),
  m_registry(),
- m_timing_info()
+ m_timing_info(),
+ m_last_execution_timings(),
+ m_last_execution_memory(),
+ m_memory_budget(0),
+ m_memory_budget_agreement(nullptr),
+ m_output_size_estimates()
 {
 
 }
@@ -297,16 +472,43 @@ void
 Workspace::traversals(Node &traversals)
 {
     traversals.reset();
+    plan(traversals);
+}
+
+//-----------------------------------------------------------------------------
+bool
+Workspace::plan(Node &traversals)
+{
+    // only reorder when asked to save memory, the default plan
+    // runs each sink's pipeline to completion in turn
+    if(m_memory_budget > 0 &&
+       ExecutionPlan::generate_memory_aware(graph(),
+                                            m_output_size_estimates,
+                                            traversals))
+    {
+        return true;
+    }
+
     ExecutionPlan::generate(graph(),traversals);
+    return false;
 }
 
 //-----------------------------------------------------------------------------
 void
 Workspace::execute()
 {
+    FLOW_TRACE_SCOPE("flow::Workspace::execute");
+    // number of this execution in the timing info
+    const int exec_count = g_timing_exec_count.fetch_add(1);
     Timer t_total_exec;
+    m_last_execution_timings.reset();
+    m_last_execution_memory.reset();
+    registry().reset_peak_bytes();
+    index_t released_bytes = 0;
+    // largest size seen for each output during this execution
+    std::map<std::string,index_t> size_estimates;
     Node traversals;
-    ExecutionPlan::generate(graph(),traversals);
+    bool memory_aware = plan(traversals);
     // execute traversals
     NodeIterator travs_itr = traversals.children();
 
@@ -337,12 +539,18 @@ Workspace::execute()
 
             Timer t_flt_exec;
             // execute
-            f->execute();
+            {
+                TraceScope flt_trace(f->name());
+                f->execute();
+            }
+            float flt_exec_time = t_flt_exec.elapsed();
 
-            m_timing_info << g_timing_exec_count
+            m_timing_info << exec_count
                           << " " << f->name()
-                          << " " << std::fixed << t_flt_exec.elapsed()
+                          << " " << std::fixed << flt_exec_time
                           <<"\n";
+            // add_child avoids treating '/' in names as a path
+            m_last_execution_timings.add_child(f->name()) = flt_exec_time;
 
             // if has output, set output
             if(f->output_port())
@@ -359,6 +567,42 @@ Workspace::execute()
 
             f->reset_inputs_and_output();
 
+            // inputs may have grown while executing
+            // (for example lazily converted data sets)
+            ports_itr.to_front();
+            while(ports_itr.has_next())
+            {
+                std::string port_name = ports_itr.next().as_string();
+                std::string f_input_name = graph().edges_in(f_name)[port_name].as_string();
+                registry().update_size(f_input_name);
+                index_t &est = size_estimates[f_input_name];
+                est = std::max(est, registry().size_in_bytes(f_input_name));
+            }
+
+            if(f->output_port())
+            {
+                index_t &est = size_estimates[f_name];
+                est = std::max(est, registry().size_in_bytes(f_name));
+            }
+
+            Node &flt_mem = m_last_execution_memory["filters"].add_child(f->name());
+            flt_mem["output_bytes"] = registry().size_in_bytes(f_name);
+            flt_mem["live_bytes"]   = registry().live_bytes();
+
+            if(m_memory_budget > 0)
+            {
+                bool over_budget = registry().live_bytes() > m_memory_budget;
+                if(m_memory_budget_agreement != nullptr)
+                {
+                    over_budget = m_memory_budget_agreement(over_budget);
+                }
+
+                if(over_budget)
+                {
+                    released_bytes += registry().release_cached();
+                }
+            }
+
             // consume inputs
             ports_itr.to_front();
             while(ports_itr.has_next())
@@ -370,14 +614,31 @@ Workspace::execute()
         }
     }
 
-    m_timing_info << g_timing_exec_count
+    float total_exec_time = t_total_exec.elapsed();
+    m_timing_info << exec_count
                   << " [total] "
-                  << std::fixed << t_total_exec.elapsed()
+                  << std::fixed << total_exec_time
                   <<"\n";
+    m_last_execution_timings.add_child("[total]") = total_exec_time;
 
+    m_last_execution_memory["peak_bytes"] = registry().peak_bytes();
+    if(m_memory_budget > 0)
+    {
+        m_last_execution_memory["budget"] = m_memory_budget;
+        m_last_execution_memory["released_cached_bytes"] = released_bytes;
+        m_last_execution_memory["plan"] = memory_aware ? "memory_aware"
+                                                       : "default";
+    }
 
-    g_timing_exec_count++;
-
+    // keep the largest estimates for the next plan
+    std::map<std::string,index_t>::const_iterator est_itr;
+    for(est_itr = size_estimates.begin();
+        est_itr != size_estimates.end();
+        est_itr++)
+    {
+        index_t &est = m_output_size_estimates[est_itr->first];
+        est = std::max(est, est_itr->second);
+    }
 }
 
 
@@ -387,6 +648,8 @@ Workspace::reset()
 {
     graph().reset();
     registry().reset();
+    // estimates belong to the filters of the old graph
+    m_output_size_estimates.clear();
 }
 
 
@@ -399,6 +662,7 @@ Workspace::info(Node &out) const
     graph().info(out["graph"]);
     registry().info(out["registry"]);
     out["timings"] = timing_info();
+    out["memory"] = m_last_execution_memory;
 }
 
 
@@ -434,6 +698,69 @@ Workspace::timing_info() const
     return m_timing_info.str();
 }
 
+//-----------------------------------------------------------------------------
+const Node &
+Workspace::last_execution_timings() const
+{
+    return m_last_execution_timings;
+}
+
+//-----------------------------------------------------------------------------
+const Node &
+Workspace::last_execution_memory() const
+{
+    return m_last_execution_memory;
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::set_memory_budget(index_t bytes)
+{
+    m_memory_budget = bytes;
+}
+
+//-----------------------------------------------------------------------------
+index_t
+Workspace::memory_budget() const
+{
+    return m_memory_budget;
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::set_memory_budget_agreement(MemoryBudgetAgreement agreement)
+{
+    m_memory_budget_agreement = agreement;
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::output_size_estimates(Node &estimates) const
+{
+    estimates.reset();
+    std::map<std::string,index_t>::const_iterator itr;
+    for(itr = m_output_size_estimates.begin();
+        itr != m_output_size_estimates.end();
+        itr++)
+    {
+        // add_child avoids treating '/' in names as a path
+        estimates.add_child(itr->first).set_int64(itr->second);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void
+Workspace::set_output_size_estimates(const Node &estimates)
+{
+    m_output_size_estimates.clear();
+    NodeConstIterator itr = estimates.children();
+    while(itr.has_next())
+    {
+        const Node &est = itr.next();
+        m_output_size_estimates[itr.name()] = est.to_index_t();
+    }
+}
+
 //-----------------------------------------------------------------------------
 Filter *
 Workspace::create_filter(const std::string &filter_type_name)
@@ -60,6 +60,7 @@
 #include <flow_registry.hpp>
 #include <flow_graph.hpp>
 #include <sstream>
+#include <map>
 
 
 //-----------------------------------------------------------------------------
@@ -119,6 +120,37 @@ public:
     void           reset_timing_info();
     /// return a string of recorded timing events
     std::string    timing_info() const;
+    /// return the per filter execution times (in seconds) recorded
+    /// during the most recent call to execute()
+    const conduit::Node &last_execution_timings() const;
+    /// return the per filter memory use (in bytes) recorded during the
+    /// most recent call to execute(): each filter's output size, the live
+    /// registry bytes after it ran, and the peak for the whole execution
+    const conduit::Node &last_execution_memory() const;
+
+    /// sets a soft limit (in bytes) for the data held in the registry,
+    /// when exceeded entries are asked to drop state they can recreate.
+    /// With a budget, filters are also ordered to keep the live memory low,
+    /// using the output sizes seen in previous executions (until every
+    /// filter has an estimate, the default order is used).
+    /// (0, the default, disables the budget)
+    void             set_memory_budget(conduit::index_t bytes);
+    conduit::index_t memory_budget() const;
+
+    /// combines the over budget votes of all ranks. The state entries
+    /// drop can be collective to recreate, so parallel hosts must make
+    /// every rank release at the same point of the execution (e.g.,
+    /// release when any rank is over budget). Called once per filter
+    /// while a budget is set. (nullptr, the default, uses the local vote)
+    typedef bool (*MemoryBudgetAgreement)(bool over_budget);
+    void             set_memory_budget_agreement(MemoryBudgetAgreement agreement);
+
+    /// the output size estimates (in bytes, keyed by filter name) used
+    /// to plan memory aware executions. The plan must be the same on
+    /// every rank, parallel hosts should replace the estimates with
+    /// their max across ranks before calling execute().
+    void output_size_estimates(conduit::Node &estimates) const;
+    void set_output_size_estimates(const conduit::Node &estimates);
 
     // ------------------------------------------------------------------------
     /// Interface to set and obtain the MPI communicator.
@@ -184,6 +216,10 @@ private:
 
     static Filter *create_filter(const std::string &filter_type);
 
+    // generates the traversals used by execute(),
+    // returns true if the memory aware plan was used
+    bool           plan(conduit::Node &traversals);
+
     static int  m_default_mpi_comm;
 
     class ExecutionPlan;
@@ -192,6 +228,13 @@ private:
     Graph             m_graph;
     Registry          m_registry;
     std::stringstream m_timing_info;
+    conduit::Node     m_last_execution_timings;
+    conduit::Node     m_last_execution_memory;
+    conduit::index_t  m_memory_budget;
+    MemoryBudgetAgreement m_memory_budget_agreement;
+    // largest output sizes (in bytes) seen since the last reset(),
+    // keyed by filter
+    std::map<std::string,conduit::index_t> m_output_size_estimates;
 
 };
 
@@ -5,6 +5,8 @@
 #include <stack>
 #include <sstream>
 
+#include <flow_trace.hpp>
+
 namespace rover {
 
 class Logger
@@ -53,8 +55,10 @@ protected:
 #define ROVER_ERROR(msg) rover::Logger::get_instance()->get_stream() <<"<Error>\n" \
   <<"  message: "<< msg <<"\n  file: " <<__FILE__<<"\n  line:  "<<__LINE__<<std::endl;
 
-#define ROVER_DATA_OPEN(name) rover::DataLogger::GetInstance()->OpenLogEntry(name);
-#define ROVER_DATA_CLOSE(time) rover::DataLogger::GetInstance()->CloseLogEntry(time);
+#define ROVER_DATA_OPEN(name) flow::Trace::begin(name); \
+  rover::DataLogger::GetInstance()->OpenLogEntry(name);
+#define ROVER_DATA_CLOSE(time) flow::Trace::end(); \
+  rover::DataLogger::GetInstance()->CloseLogEntry(time);
 #define ROVER_DATA_ADD(key,value) rover::DataLogger::GetInstance()->AddLogData(key, value);
 
 #else
@@ -62,8 +66,9 @@ protected:
 #define ROVER_WARN(msg)
 #define ROVER_ERROR(msg)
 
-#define ROVER_DATA_OPEN(name)
-#define ROVER_DATA_CLOSE(name) (void)name;
+// data entries still feed the unified trace (a no-op unless enabled)
+#define ROVER_DATA_OPEN(name) flow::Trace::begin(name);
+#define ROVER_DATA_CLOSE(name) flow::Trace::end(); (void)name;
 #define ROVER_DATA_ADD(key,value)
 #endif
 } // namespace rover
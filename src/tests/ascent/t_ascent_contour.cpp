@@ -57,6 +57,7 @@
 #include <math.h>
 
 #include <conduit_blueprint.hpp>
+#include <conduit_relay.hpp>
 
 #include "t_config.hpp"
 #include "t_utils.hpp"
@@ -319,6 +320,114 @@ TEST(ascent_contour, test_multi_contour_levels)
     ASCENT_ACTIONS_DUMP(actions,output_file,msg);
 }
 
+//-----------------------------------------------------------------------------
+// contours the data with the given params and saves the result
+void
+save_contour(const Node &data,
+             const Node &contour_params,
+             const std::string &output_file)
+{
+    conduit::Node actions;
+    // add the pipeline
+    conduit::Node &add_pipelines= actions.append();
+    add_pipelines["action"] = "add_pipelines";
+    conduit::Node &pipelines = add_pipelines["pipelines"];
+    pipelines["pl1/f1/type"] = "contour";
+    pipelines["pl1/f1/params"] = contour_params;
+    // add the extracts
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    conduit::Node &extracts = add_extracts["extracts"];
+    extracts["e1/type"]  = "relay";
+    extracts["e1/pipeline"]  = "pl1";
+    extracts["e1/params/path"] = output_file;
+    extracts["e1/params/protocol"] = "hdf5";
+
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.close();
+}
+
+//-----------------------------------------------------------------------------
+// loads the first domain saved by save_contour
+void
+load_contour(const std::string &output_path,
+             const std::string &output_file,
+             Node &n_domain)
+{
+    Node n_root;
+    conduit::relay::io::load(output_file + ".cycle_000100.root","hdf5",n_root);
+    char domain_file[512];
+    snprintf(domain_file,
+             sizeof(domain_file),
+             n_root["file_pattern"].as_string().c_str(),
+             0);
+    conduit::relay::io::load(conduit::utils::join_file_path(output_path, domain_file),
+                             "hdf5",
+                             n_domain);
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_contour, test_expression_iso_value)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent support disabled, skipping test");
+        return;
+    }
+
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing a contour with an expression iso value");
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,"tout_expression_iso_value");
+    string output_root = output_file + ".cycle_000100.root";
+
+    remove_test_image(output_root);
+
+    // the expression gives the same value as the numeric contour
+    conduit::Node contour_params;
+    contour_params["field"] = "braid";
+    contour_params["iso_values"] = "0.2 * 2";
+    save_contour(data, contour_params, output_file);
+
+    // make sure the expected root file exists
+    EXPECT_TRUE(conduit::utils::is_file(output_root));
+
+    string numeric_file = output_file + "_numeric";
+    contour_params["iso_values"] = 0.4;
+    save_contour(data, contour_params, numeric_file);
+
+    Node n_expr, n_numeric;
+    load_contour(output_path, output_file, n_expr);
+    load_contour(output_path, numeric_file, n_numeric);
+
+    const Node &expr_conn = n_expr["topologies"].child(0)["elements/connectivity"];
+    const Node &numeric_conn = n_numeric["topologies"].child(0)["elements/connectivity"];
+    EXPECT_GT(expr_conn.dtype().number_of_elements(), 0);
+    EXPECT_EQ(expr_conn.dtype().number_of_elements(),
+              numeric_conn.dtype().number_of_elements());
+}
+
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
 {
@@ -52,9 +52,16 @@
 
 #include <ascent_expression_eval.hpp>
 #include <expressions/ascent_blueprint_architect.hpp>
+#include <expressions/ascent_quantile_sketch.hpp>
+#include <expressions/ascent_topology_metadata.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <thread>
 
 #include <conduit_blueprint.hpp>
 
@@ -388,6 +395,15 @@ TEST(ascent_expressions, functional_correctness)
   EXPECT_EQ(res["value"].to_float64(), 2);
   EXPECT_EQ(res["type"].as_string(), "double");
 
+  expr = "quantile(field('ele_example'), 3.0/16.0)";
+  res = eval.evaluate(expr);
+  EXPECT_EQ(res["value"].to_float64(), 2);
+  EXPECT_EQ(res["type"].as_string(), "double");
+
+  expr = "quantile(field('ele_example'), 1.0, method='exact')";
+  res = eval.evaluate(expr);
+  EXPECT_EQ(res["value"].to_float64(), 15);
+
   expr = "16.0/256 == avg(histogram(field('ele_example')).value)";
   res = eval.evaluate(expr);
   EXPECT_EQ(res["value"].to_uint8(), 1);
@@ -542,6 +558,61 @@ TEST(ascent_expressions, test_identifier)
   EXPECT_EQ(res2["type"].as_string(), "vector");
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, concurrent_evaluation)
+{
+  Node data;
+  conduit::blueprint::mesh::examples::braid("hexs",
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            data);
+  // ascent normally adds this but we are doing an end around
+  data["state/domain_id"] = 0;
+  Node multi_dom;
+  blueprint::mesh::to_multi_domain(data, multi_dom);
+
+  runtime::expressions::register_builtin();
+
+  runtime::expressions::ExpressionEval serial_eval(&multi_dom);
+  const double expected =
+    serial_eval.evaluate("max(field('braid')).value")["value"].to_float64() +
+    1.0;
+
+  // independent evaluations, each with its own named cache entry
+  const int num_threads = 8;
+  std::vector<double> values(num_threads, 0.0);
+  std::vector<int> failed(num_threads, 0);
+  std::vector<std::thread> threads;
+  for(int t = 0; t < num_threads; ++t)
+  {
+    threads.push_back(std::thread([&, t]()
+    {
+      try
+      {
+        runtime::expressions::ExpressionEval eval(&multi_dom);
+        const std::string name = "concurrent_max_" + std::to_string(t);
+        eval.evaluate("max(field('braid'))", name);
+        values[t] = eval.evaluate(name + ".value + 1")["value"].to_float64();
+      }
+      catch(...)
+      {
+        failed[t] = 1;
+      }
+    }));
+  }
+  for(std::thread &thread : threads)
+  {
+    thread.join();
+  }
+
+  for(int t = 0; t < num_threads; ++t)
+  {
+    EXPECT_EQ(failed[t], 0);
+    EXPECT_EQ(values[t], expected);
+  }
+}
+
 //-----------------------------------------------------------------------------
 TEST(ascent_expressions, test_history)
 {
@@ -608,6 +679,11 @@ TEST(ascent_expressions, test_history)
   EXPECT_EQ(res["value"].to_int32(), 1);
   EXPECT_EQ(res["type"].as_string(), "int");
 
+  // a relative index past the oldest entry is clamped to the newest
+  expr = "history(val, 10)";
+  res = eval.evaluate(expr);
+  EXPECT_EQ(res["value"].to_int32(), 4);
+
   bool threw = false;
   try
   {
@@ -643,6 +719,71 @@ TEST(ascent_expressions, test_history)
   EXPECT_EQ(res["type"].as_string(), "double");
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, history_windows)
+{
+  Node data;
+  conduit::blueprint::mesh::examples::braid("hexs",
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            EXAMPLE_MESH_SIDE_DIM,
+                                            data);
+  // ascent normally adds this but we are doing an end around
+  data["state/domain_id"] = 0;
+  Node multi_dom;
+  blueprint::mesh::to_multi_domain(data, multi_dom);
+
+  runtime::expressions::register_builtin();
+  runtime::expressions::ExpressionEval::reset_cache();
+
+  const std::vector<std::string> vals = {"1", "5", "2", "8", "3"};
+  conduit::Node res;
+  for(size_t i = 0; i < vals.size(); ++i)
+  {
+    multi_dom.child(0)["state/cycle"] = int(100 * (i + 1));
+    multi_dom.child(0)["state/time"] = 0.5 * (i + 1);
+    runtime::expressions::ExpressionEval eval(&multi_dom);
+    eval.evaluate(vals[i], "val");
+    if(i == 2)
+    {
+      // created part way through, then kept up to date
+      res = eval.evaluate("rolling_avg(val, 2)");
+      EXPECT_EQ(res["value"].to_float64(), 3.5);
+    }
+  }
+
+  runtime::expressions::ExpressionEval eval(&multi_dom);
+  res = eval.evaluate("rolling_avg(val, 2)");
+  EXPECT_EQ(res["value"].to_float64(), 5.5);
+  EXPECT_EQ(res["type"].as_string(), "double");
+
+  res = eval.evaluate("rolling_avg(val, 10)");
+  EXPECT_EQ(res["value"].to_float64(), 19.0 / 5.0);
+
+  res = eval.evaluate("rolling_max(val, 2)");
+  EXPECT_EQ(res["value"].to_float64(), 8);
+
+  res = eval.evaluate("rolling_min(val, 3)");
+  EXPECT_EQ(res["value"].to_float64(), 2);
+
+  res = eval.evaluate("ema(val, 0.5)");
+  EXPECT_EQ(res["value"].to_float64(), 4.125);
+
+  res = eval.evaluate("derivative(val)");
+  EXPECT_EQ(res["value"].to_float64(), -10);
+
+  bool threw = false;
+  try
+  {
+    eval.evaluate("rolling_avg(val, 0)");
+  }
+  catch(...)
+  {
+    threw = true;
+  }
+  EXPECT_EQ(threw, true);
+}
+
 //-----------------------------------------------------------------------------
 TEST(ascent_expressions, if_expressions)
 {
@@ -687,6 +828,146 @@ TEST(ascent_expressions, if_expressions)
   EXPECT_EQ(threw, true);
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, topology_metadata)
+{
+  Node data;
+  conduit::blueprint::mesh::examples::basic("hexs", 3, 3, 3, data);
+  data["state/domain_id"] = 0;
+  std::shared_ptr<Node> multi_dom = std::make_shared<Node>();
+  blueprint::mesh::to_multi_domain(data, *multi_dom);
+
+  using runtime::expressions::TopologyMetadata;
+  std::shared_ptr<TopologyMetadata> metadata = TopologyMetadata::get(multi_dom);
+  // shared until the data set changes
+  EXPECT_EQ(metadata, TopologyMetadata::get(multi_dom));
+
+  EXPECT_EQ(metadata->num_points(0, "mesh"), 27);
+  EXPECT_EQ(metadata->num_cells(0, "mesh"), 8);
+  EXPECT_EQ(metadata->global_num_points("mesh"), 27);
+  EXPECT_EQ(metadata->global_num_cells("mesh"), 8);
+  EXPECT_TRUE(metadata->has_topology("mesh"));
+  EXPECT_FALSE(metadata->has_topology("bananas"));
+
+  Node bounds = metadata->global_bounds("mesh");
+  EXPECT_EQ(bounds["min_coords"].to_json(), "[-10.0, -10.0, -10.0]");
+  EXPECT_EQ(bounds["max_coords"].to_json(), "[10.0, 10.0, 10.0]");
+
+  const std::vector<double> &centroids = metadata->centroids(0, "mesh");
+  EXPECT_EQ(centroids.size(), size_t(24));
+  EXPECT_EQ(centroids[0], -5.0);
+  EXPECT_EQ(centroids[1], -5.0);
+  EXPECT_EQ(centroids[2], -5.0);
+
+  Node topo_and_assoc = metadata->topo_and_assoc({"field"});
+  EXPECT_EQ(topo_and_assoc["topo_name"].as_string(), "mesh");
+  EXPECT_EQ(topo_and_assoc["assoc_str"].as_string(), "element");
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, topology_metadata_shapes)
+{
+  std::shared_ptr<Node> multi_dom = std::make_shared<Node>();
+  Node &dom = multi_dom->append();
+  dom["state/domain_id"] = 0;
+
+  // 1D uniform, without dims/j
+  dom["coordsets/line_coords/type"] = "uniform";
+  dom["coordsets/line_coords/dims/i"] = 5;
+  dom["coordsets/line_coords/origin/x"] = 1.0;
+  dom["topologies/line/type"] = "uniform";
+  dom["topologies/line/coordset"] = "line_coords";
+
+  // a triangle and a quad in one polygonal topology
+  const float64 xs[5] = {0., 1., 1., 0., 2.};
+  const float64 ys[5] = {0., 0., 1., 1., 0.};
+  dom["coordsets/poly_coords/type"] = "explicit";
+  dom["coordsets/poly_coords/values/x"].set(xs, 5);
+  dom["coordsets/poly_coords/values/y"].set(ys, 5);
+  const int32 conn[7] = {0, 1, 2, 3, 1, 4, 2};
+  const int32 sizes[2] = {4, 3};
+  const int32 offsets[2] = {0, 4};
+  dom["topologies/poly/type"] = "unstructured";
+  dom["topologies/poly/coordset"] = "poly_coords";
+  dom["topologies/poly/elements/shape"] = "polygonal";
+  dom["topologies/poly/elements/connectivity"].set(conn, 7);
+  dom["topologies/poly/elements/sizes"].set(sizes, 2);
+  dom["topologies/poly/elements/offsets"].set(offsets, 2);
+
+  using runtime::expressions::TopologyMetadata;
+  std::shared_ptr<TopologyMetadata> metadata = TopologyMetadata::get(multi_dom);
+
+  EXPECT_EQ(metadata->num_points(0, "line"), 5);
+  EXPECT_EQ(metadata->num_cells(0, "line"), 4);
+  EXPECT_EQ(metadata->global_num_cells("line"), 4);
+  Node bounds = metadata->global_bounds("line");
+  EXPECT_EQ(bounds["min_coords"].as_float64_ptr()[0], 1.0);
+  EXPECT_EQ(bounds["max_coords"].as_float64_ptr()[0], 5.0);
+
+  EXPECT_EQ(metadata->num_points(0, "poly"), 5);
+  EXPECT_EQ(metadata->num_cells(0, "poly"), 2);
+  EXPECT_EQ(metadata->global_num_cells("poly"), 2);
+  bounds = metadata->global_bounds("poly");
+  EXPECT_EQ(bounds["max_coords"].as_float64_ptr()[0], 2.0);
+  EXPECT_EQ(bounds["max_coords"].as_float64_ptr()[1], 1.0);
+
+  // the 1D locator is only built when positions are asked for
+  const std::vector<double> &centroids = metadata->centroids(0, "line");
+  EXPECT_EQ(centroids.size(), size_t(12));
+  EXPECT_EQ(centroids[0], 1.5);
+
+  // a field that is not there yet is looked up again once it is added
+  EXPECT_THROW(metadata->topo_and_assoc({"later"}), conduit::Error);
+  dom["fields/later/association"] = "element";
+  dom["fields/later/topology"] = "poly";
+  dom["fields/later/values"].set(DataType::float64(2));
+  Node topo_and_assoc = metadata->topo_and_assoc({"later"});
+  EXPECT_EQ(topo_and_assoc["topo_name"].as_string(), "poly");
+  EXPECT_EQ(topo_and_assoc["assoc_str"].as_string(), "element");
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_binning, paint_binning_kept_homes)
+{
+  Node data;
+  conduit::blueprint::mesh::examples::braid("hexs", 5, 5, 5, data);
+  data["state/domain_id"] = 0;
+  Node multi_dom;
+  blueprint::mesh::to_multi_domain(data, multi_dom);
+
+  Node bin_axes;
+  bin_axes["x/num_bins"] = 3;
+  bin_axes["x/clamp"] = 0;
+  bin_axes["y/num_bins"] = 2;
+  bin_axes["y/clamp"] = 0;
+
+  Node res, homes;
+  {
+    const runtime::expressions::TopologyMetadata metadata(multi_dom);
+    runtime::expressions::binning(
+        metadata, bin_axes, "braid", "sum", 0., "", res, &homes);
+  }
+  // the bin of every vertex
+  EXPECT_EQ(homes.number_of_children(), 1);
+  EXPECT_EQ(homes.child(0).dtype().number_of_elements(), 125);
+
+  Node n_binning;
+  n_binning["attrs/value/value"].set_external(res["value"]);
+  n_binning["attrs/bin_axes/value"].set_external(bin_axes);
+  n_binning["attrs/reduction_var/value"] = "braid";
+  n_binning["attrs/reduction_op/value"] = "sum";
+  n_binning["attrs/association/value"] = res["association"];
+
+  // painting with the kept bins matches recomputing them
+  runtime::expressions::paint_binning(n_binning, multi_dom, "kept", &homes);
+  runtime::expressions::paint_binning(n_binning, multi_dom, "recomputed");
+  float64_array kept = multi_dom.child(0)["fields/kept/values"].value();
+  float64_array recomputed =
+      multi_dom.child(0)["fields/recomputed/values"].value();
+  EXPECT_EQ(kept.number_of_elements(), 125);
+  EXPECT_EQ(kept.to_json(), recomputed.to_json());
+}
+
 //-----------------------------------------------------------------------------
 TEST(ascent_binning, binning_basic_meshes)
 {
@@ -747,6 +1028,17 @@ TEST(ascent_binning, binning_basic_meshes)
   EXPECT_EQ(res["attrs/value/value"].to_json(),
             "[0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0]");
 
+  // far more bins than elements, so only the occupied bins are kept
+  expr = "sum(binning('field', 'sum', [axis('x', num_bins=64), "
+         "axis('y', num_bins=64), axis('z', num_bins=64)]).value)";
+  res = eval.evaluate(expr);
+  EXPECT_EQ(res["value"].to_float64(), 28.0);
+
+  expr = "max(binning('field', 'max', [axis('x', num_bins=64), "
+         "axis('y', num_bins=64)], empty_bin_val=-1).value)";
+  res = eval.evaluate(expr);
+  EXPECT_EQ(res["value"].to_float64(), 7.0);
+
   expr = "binning('', 'pdf', [axis('field', num_bins=8)])";
   res = eval.evaluate(expr);
   EXPECT_EQ(res["attrs/value/value"].to_json(),
@@ -1058,6 +1350,317 @@ TEST(ascent_expressions, lineout)
   res = eval.evaluate(expr);
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, probe)
+{
+  //
+  // Create an example mesh.
+  //
+  Node data;
+  data["coordsets/coords/type"] = "uniform";
+  data["coordsets/coords/dims/i"] = 5;
+  data["coordsets/coords/dims/j"] = 5;
+  data["coordsets/coords/dims/k"] = 5;
+  data["topologies/topo/type"] = "uniform";
+  data["topologies/topo/coordset"] = "coords";
+
+  // a linear vertex field is reproduced exactly by interpolation
+  data["fields/vert_example/association"] = "vertex";
+  data["fields/vert_example/topology"] = "topo";
+  data["fields/vert_example/values"].set(DataType::float64(125));
+  float64 *vert_vals_ptr = data["fields/vert_example/values"].value();
+  for(int k = 0; k < 5; k++)
+    for(int j = 0; j < 5; j++)
+      for(int i = 0; i < 5; i++)
+      {
+        vert_vals_ptr[(k * 5 + j) * 5 + i] = i + 2. * j + 3. * k;
+      }
+
+  data["fields/ele_example/association"] = "element";
+  data["fields/ele_example/topology"] = "topo";
+  data["fields/ele_example/values"].set(DataType::float64(64));
+  float64 *ele_vals_ptr = data["fields/ele_example/values"].value();
+  for(int i = 0; i < 64; i++)
+  {
+    ele_vals_ptr[i] = float64(i);
+  }
+
+  Node verify_info;
+  EXPECT_TRUE(blueprint::mesh::verify(data, verify_info));
+
+  // ascent normally adds this but we are doing an end around
+  data["state/domain_id"] = 0;
+  Node multi_dom;
+  blueprint::mesh::to_multi_domain(data, multi_dom);
+
+  runtime::expressions::register_builtin();
+  runtime::expressions::ExpressionEval eval(&multi_dom);
+
+  conduit::Node res;
+  std::string expr;
+
+  expr = "probe(field('vert_example'), vector(1.5, 2.25, 0.5))";
+  res = eval.evaluate(expr);
+  EXPECT_EQ(res["type"].as_string(), "double");
+  EXPECT_NEAR(res["value"].to_float64(), 7.5, 1e-12);
+
+  expr = "probe(field('ele_example'), vector(1.5, 0.5, 2.5))";
+  res = eval.evaluate(expr);
+  EXPECT_EQ(res["value"].to_float64(), 33.0);
+
+  expr = "probe(field('vert_example'), vector(10, 10, 10), empty_val=-1.0)";
+  res = eval.evaluate(expr);
+  EXPECT_EQ(res["value"].to_float64(), -1.0);
+
+  expr = "probe(field('vert_example'),"
+         " [vector(0, 0, 0), vector(4, 4, 4), vector(-1, 0, 0)])";
+  res = eval.evaluate(expr);
+  EXPECT_EQ(res["type"].as_string(), "array");
+  float64_array values = res["value"].value();
+  EXPECT_EQ(values.number_of_elements(), 3);
+  EXPECT_NEAR(values[0], 0.0, 1e-12);
+  EXPECT_NEAR(values[1], 24.0, 1e-12);
+  EXPECT_EQ(values[2], 0.0);
+
+  // two lines sampled at once, without devil ray
+  expr = "lineout(3, [vector(0, 0, 0), vector(0, 4, 0)],"
+         " [vector(4, 4, 4), vector(4, 4, 0)],"
+         " fields=['vert_example', 'ele_example'], empty_val=-1.0)";
+  res = eval.evaluate(expr);
+  EXPECT_EQ(res["attrs/lines/value"].to_int32(), 2);
+  EXPECT_EQ(res["attrs/samples/value"].to_int32(), 3);
+  float64_array line_x = res["attrs/coordinates/x/value"].value();
+  float64_array line_vals = res["attrs/vars/vert_example/value"].value();
+  EXPECT_EQ(line_vals.number_of_elements(), 6);
+  EXPECT_NEAR(line_x[4], 2.0, 1e-12);
+  EXPECT_NEAR(line_vals[1], 12.0, 1e-12);
+  EXPECT_NEAR(line_vals[4], 10.0, 1e-12);
+  EXPECT_TRUE(res.has_path("attrs/vars/ele_example/value"));
+
+  expr = "sample_points([vector(1.5, 2.25, 0.5), vector(10, 10, 10)],"
+         " empty_val=-1.0)";
+  res = eval.evaluate(expr);
+  float64_array vert_samples = res["attrs/vars/vert_example/value"].value();
+  float64_array ele_samples = res["attrs/vars/ele_example/value"].value();
+  EXPECT_NEAR(vert_samples[0], 7.5, 1e-12);
+  EXPECT_EQ(vert_samples[1], -1.0);
+  EXPECT_EQ(ele_samples[1], -1.0);
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, field_quantile_large)
+{
+  //
+  // 1e6 element values that are a shuffle of 0 .. n-1, so the rank of a
+  // value is the value plus one. They are split over four domains, so the
+  // answer comes from merged sketches.
+  //
+  const int num_domains = 4;
+  const int64 n = 1000000;
+  const int64 per_domain = n / num_domains;
+  std::vector<float64> shuffled(n);
+  std::iota(shuffled.begin(), shuffled.end(), 0.);
+  std::mt19937 gen(42);
+  std::shuffle(shuffled.begin(), shuffled.end(), gen);
+
+  Node multi_dom;
+  for(int d = 0; d < num_domains; d++)
+  {
+    Node &dom = multi_dom.append();
+    dom["coordsets/coords/type"] = "uniform";
+    dom["coordsets/coords/dims/i"] = 101;
+    dom["coordsets/coords/dims/j"] = 101;
+    dom["coordsets/coords/dims/k"] = 26;
+    dom["coordsets/coords/origin/x"] = 0.0;
+    dom["coordsets/coords/origin/y"] = 0.0;
+    dom["coordsets/coords/origin/z"] = 25.0 * d;
+    dom["topologies/topo/type"] = "uniform";
+    dom["topologies/topo/coordset"] = "coords";
+    dom["fields/ele_example/association"] = "element";
+    dom["fields/ele_example/topology"] = "topo";
+    dom["fields/ele_example/values"].set(&shuffled[d * per_domain],
+                                         per_domain);
+    dom["state/domain_id"] = d;
+  }
+
+  runtime::expressions::register_builtin();
+  runtime::expressions::ExpressionEval eval(&multi_dom);
+
+  const double error = 0.01;
+  const double qs[] = {0.0, 0.01, 0.25, 0.5, 0.9, 0.999, 1.0};
+  for(const double q : qs)
+  {
+    std::stringstream expr;
+    expr << std::fixed << "quantile(field('ele_example'), " << q << ", error=" << error
+         << ")";
+    conduit::Node res = eval.evaluate(expr.str());
+    const double rank = res["value"].to_float64() + 1.;
+    EXPECT_LE(std::abs(rank - q * n), error * n) << "q = " << q;
+    EXPECT_LE(res["attrs/error/value"].to_float64(), error);
+    EXPECT_EQ(res["attrs/count/value"].to_int64(), n);
+  }
+
+  //
+  // the same bound for sketches merged directly and through the packed
+  // form that is sent between ranks
+  //
+  const int num_sketches = 8;
+  const int64 per_sketch = n / num_sketches;
+  const int64 capacity =
+      runtime::expressions::QuantileSketch::capacity(error, n);
+  runtime::expressions::QuantileSketch merged(capacity);
+  runtime::expressions::QuantileSketch unpacked(capacity);
+  for(int s = 0; s < num_sketches; s++)
+  {
+    runtime::expressions::QuantileSketch sketch(capacity);
+    for(int64 i = s * per_sketch; i < (s + 1) * per_sketch; i++)
+    {
+      sketch.insert(shuffled[i]);
+    }
+    merged.merge(sketch);
+    std::vector<double> buffer;
+    sketch.pack(buffer);
+    EXPECT_EQ(unpacked.unpack(buffer.data()), index_t(buffer.size()));
+  }
+  EXPECT_EQ(merged.count(), n);
+  EXPECT_EQ(unpacked.count(), n);
+  EXPECT_LE(merged.rank_error(), error * n);
+  EXPECT_LE(unpacked.rank_error(), error * n);
+  for(const double q : qs)
+  {
+    EXPECT_LE(std::abs(merged.quantile(q) + 1. - q * n), error * n)
+      << "q = " << q;
+    EXPECT_LE(std::abs(unpacked.quantile(q) + 1. - q * n), error * n)
+      << "q = " << q;
+  }
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, nearest_vertex)
+{
+  //
+  // a uniform mesh, searched by index arithmetic
+  //
+  Node data;
+  data["coordsets/coords/type"] = "uniform";
+  data["coordsets/coords/dims/i"] = 5;
+  data["coordsets/coords/dims/j"] = 5;
+  data["coordsets/coords/dims/k"] = 5;
+  data["topologies/topo/type"] = "uniform";
+  data["topologies/topo/coordset"] = "coords";
+  data["fields/vert_example/association"] = "vertex";
+  data["fields/vert_example/topology"] = "topo";
+  data["fields/vert_example/values"].set(DataType::float64(125));
+  float64 *vert_vals_ptr = data["fields/vert_example/values"].value();
+  for(int k = 0; k < 5; k++)
+    for(int j = 0; j < 5; j++)
+      for(int i = 0; i < 5; i++)
+      {
+        vert_vals_ptr[(k * 5 + j) * 5 + i] = i + 2. * j + 3. * k;
+      }
+  data["fields/ele_example/association"] = "element";
+  data["fields/ele_example/topology"] = "topo";
+  data["fields/ele_example/values"].set(DataType::float64(64));
+  data["state/domain_id"] = 0;
+  Node multi_dom;
+  blueprint::mesh::to_multi_domain(data, multi_dom);
+
+  runtime::expressions::register_builtin();
+  {
+    runtime::expressions::ExpressionEval eval(&multi_dom);
+
+    conduit::Node res =
+        eval.evaluate("nearest_vertex(field('vert_example'), "
+                      "vector(1.4, 2.6, 0.2))");
+    EXPECT_EQ(res["type"].as_string(), "value_position");
+    EXPECT_NEAR(res["attrs/value/value"].to_float64(), 7.0, 1e-12);
+    EXPECT_NEAR(res["attrs/distance/value"].to_float64(), 0.6, 1e-12);
+    EXPECT_EQ(res["attrs/position/value"].to_json(), "[1.0, 3.0, 0.0]");
+    EXPECT_EQ(res["attrs/element/index"].to_int32(), 16);
+
+    res = eval.evaluate("nearest_vertex(field('vert_example'),"
+                        " [vector(0.1, 0.1, 0.1), vector(10, 10, 10)])");
+    EXPECT_EQ(res["type"].as_string(), "array");
+    float64_array values = res["value"].value();
+    EXPECT_EQ(values.number_of_elements(), 2);
+    EXPECT_NEAR(values[0], 0.0, 1e-12);
+    EXPECT_NEAR(values[1], 24.0, 1e-12);
+
+    // only vertex fields have a value at a vertex
+    EXPECT_THROW(eval.evaluate("nearest_vertex(field('ele_example'), "
+                               "vector(0, 0, 0))"),
+                 conduit::Error);
+  }
+
+  //
+  // an explicit mesh, searched through the vertex grid
+  //
+  Node tets;
+  conduit::blueprint::mesh::examples::basic("tets", 3, 3, 3, tets);
+  tets["fields/x/association"] = "vertex";
+  tets["fields/x/topology"] = "mesh";
+  tets["fields/x/values"].set(tets["coordsets/coords/values/x"]);
+  tets["state/domain_id"] = 0;
+  Node tets_multi_dom;
+  blueprint::mesh::to_multi_domain(tets, tets_multi_dom);
+
+  runtime::expressions::ExpressionEval eval(&tets_multi_dom);
+  conduit::Node res =
+      eval.evaluate("nearest_vertex(field('x'), vector(-6, 1, 9))");
+  EXPECT_NEAR(res["attrs/value/value"].to_float64(), -10.0, 1e-12);
+  EXPECT_EQ(res["attrs/position/value"].to_json(), "[-10.0, 0.0, 10.0]");
+  EXPECT_NEAR(res["attrs/distance/value"].to_float64(),
+              std::sqrt(16.0 + 1.0 + 1.0),
+              1e-12);
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_expressions, probe_domain_boundary)
+{
+  //
+  // Two domains that share the face at x = 2, with a different constant
+  // element value in each.
+  //
+  Node multi_dom;
+  for(int d = 0; d < 2; d++)
+  {
+    Node &dom = multi_dom.append();
+    dom["coordsets/coords/type"] = "uniform";
+    dom["coordsets/coords/dims/i"] = 3;
+    dom["coordsets/coords/dims/j"] = 3;
+    dom["coordsets/coords/dims/k"] = 3;
+    dom["coordsets/coords/origin/x"] = 2.0 * d;
+    dom["coordsets/coords/origin/y"] = 0.0;
+    dom["coordsets/coords/origin/z"] = 0.0;
+    dom["topologies/topo/type"] = "uniform";
+    dom["topologies/topo/coordset"] = "coords";
+    dom["fields/ele_example/association"] = "element";
+    dom["fields/ele_example/topology"] = "topo";
+    dom["fields/ele_example/values"].set(DataType::float64(8));
+    float64_array vals = dom["fields/ele_example/values"].value();
+    vals.fill(1.0 + 2.0 * d);
+    dom["state/domain_id"] = d;
+  }
+
+  Node verify_info;
+  EXPECT_TRUE(blueprint::mesh::verify(multi_dom, verify_info));
+
+  runtime::expressions::register_builtin();
+  runtime::expressions::ExpressionEval eval(&multi_dom);
+
+  // points on the shared face get the average of both domains, the same
+  // as when the domains are on different ranks
+  const std::string expr =
+      "probe(field('ele_example'),"
+      " [vector(1, 1, 1), vector(2, 1, 1), vector(3, 1, 1)])";
+  conduit::Node res = eval.evaluate(expr);
+  float64_array values = res["value"].value();
+  EXPECT_EQ(values.number_of_elements(), 3);
+  EXPECT_NEAR(values[0], 1.0, 1e-12);
+  EXPECT_NEAR(values[1], 2.0, 1e-12);
+  EXPECT_NEAR(values[2], 3.0, 1e-12);
+}
+
 //-----------------------------------------------------------------------------
 int
 main(int argc, char *argv[])
@@ -422,6 +422,105 @@ TEST(ascent_gradient, test_cell_gradient_radial)
     ASCENT_ACTIONS_DUMP(actions,output_file,msg);
 
 }
+
+//-----------------------------------------------------------------------------
+TEST(ascent_gradient, test_shared_gradient_quantities)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent vtkm support disabled, skipping test");
+        return;
+    }
+
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing gradient quantities shared between pipelines");
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,"tout_shared_gradient");
+
+    //
+    // Create the actions.
+    //
+
+    conduit::Node pipelines;
+    pipelines["pl1/f1/type"] = "gradient";
+    pipelines["pl1/f1/params/field"] = "vel";
+    pipelines["pl1/f1/params/output_name"] = "grad_1";
+    pipelines["pl2/f1/type"] = "gradient";
+    pipelines["pl2/f1/params/field"] = "vel";
+    pipelines["pl2/f1/params/output_name"] = "grad_2";
+    pipelines["pl3/f1/type"] = "vorticity";
+    pipelines["pl3/f1/params/field"] = "vel";
+    pipelines["pl3/f1/params/output_name"] = "vel_vorticity";
+    pipelines["pl4/f1/type"] = "qcriterion";
+    pipelines["pl4/f1/params/field"] = "vel";
+    pipelines["pl4/f1/params/output_name"] = "vel_qcriterion";
+
+    conduit::Node extracts;
+    for(int i = 1; i <= 4; ++i)
+    {
+      const std::string idx = std::to_string(i);
+      conduit::Node &extract = extracts["e" + idx];
+      extract["type"] = "relay";
+      extract["pipeline"] = "pl" + idx;
+      extract["params/path"] = output_file + "_" + idx;
+      extract["params/protocol"] = "blueprint/mesh/yaml";
+    }
+
+    conduit::Node actions;
+    // add the pipeline
+    conduit::Node &add_pipelines= actions.append();
+    add_pipelines["action"] = "add_pipelines";
+    add_pipelines["pipelines"] = pipelines;
+    // add the extracts
+    conduit::Node &add_extracts= actions.append();
+    add_extracts["action"] = "add_extracts";
+    add_extracts["extracts"] = extracts;
+
+    //
+    // Run Ascent
+    //
+
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+
+    // the second gradient reuses the first, vorticity and qcriterion
+    // are computed on their own since they were not asked for before
+    conduit::Node info;
+    ascent.info(info);
+    EXPECT_EQ(info["derived_fields/computed"].to_int64(), 3);
+    EXPECT_EQ(info["derived_fields/reused"].to_int64(), 1);
+
+    // the next execute computes all three quantities in one pass
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.info(info);
+    EXPECT_EQ(info["derived_fields/computed"].to_int64(), 1);
+    EXPECT_EQ(info["derived_fields/reused"].to_int64(), 3);
+    ascent.close();
+
+    EXPECT_TRUE(conduit::utils::is_file(output_file + "_2.cycle_000100.root"));
+    EXPECT_TRUE(conduit::utils::is_file(output_file + "_3.cycle_000100.root"));
+}
+
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
 {
@@ -56,6 +56,8 @@
 
 
 #include <ascent_expression_eval.hpp>
+#include <expressions/ascent_blueprint_architect.hpp>
+#include <expressions/ascent_topology_metadata.hpp>
 #include <flow_workspace.hpp>
 
 #include <mpi.h>
@@ -350,6 +352,95 @@ TEST(ascent_mpi_expressions, mpi_expressoins)
     }
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_mpi_expressions, mpi_binning_sparse_matches_dense)
+{
+    int par_rank;
+    int par_size;
+    MPI_Comm comm = MPI_COMM_WORLD;
+    MPI_Comm_rank(comm, &par_rank);
+    MPI_Comm_size(comm, &par_size);
+
+    flow::Workspace::set_default_mpi_comm(MPI_Comm_c2f(comm));
+
+    //
+    // Every rank has a 2x2 element domain starting at x = rank, so the
+    // bins of its first column of elements are also occupied by the
+    // previous rank and the others are only occupied by this rank.
+    //
+    Node multi_dom;
+    Node &dom = multi_dom.append();
+    dom["state/domain_id"] = par_rank;
+    dom["coordsets/coords/type"] = "uniform";
+    dom["coordsets/coords/dims/i"] = 3;
+    dom["coordsets/coords/dims/j"] = 3;
+    dom["coordsets/coords/origin/x"] = double(par_rank);
+    dom["coordsets/coords/origin/y"] = 0.0;
+    dom["topologies/topo/type"] = "uniform";
+    dom["topologies/topo/coordset"] = "coords";
+    dom["fields/field/association"] = "element";
+    dom["fields/field/topology"] = "topo";
+    dom["fields/field/values"].set(DataType::float64(4));
+    float64_array values = dom["fields/field/values"].value();
+    for(int i = 0; i < 4; i++)
+    {
+      values[i] = par_rank * 10.0 + i;
+    }
+
+    Node bin_axes;
+    bin_axes["x/num_bins"] = 64;
+    bin_axes["x/min_val"] = 0.0;
+    bin_axes["x/max_val"] = double(par_size + 2);
+    bin_axes["x/clamp"] = 0;
+    bin_axes["y/num_bins"] = 64;
+    bin_axes["y/min_val"] = 0.0;
+    bin_axes["y/max_val"] = 2.0;
+    bin_axes["y/clamp"] = 0;
+
+    const runtime::expressions::TopologyMetadata metadata(multi_dom);
+    const std::string ops[] = {"sum", "min", "max", "var"};
+    for(const std::string &op : ops)
+    {
+      Node dense_axes = bin_axes;
+      Node sparse_axes = bin_axes;
+      Node dense, sparse;
+      runtime::expressions::binning(metadata, dense_axes, "field", op, -1.0,
+                                    "", dense, nullptr, "dense");
+      runtime::expressions::binning(metadata, sparse_axes, "field", op, -1.0,
+                                    "", sparse, nullptr, "sparse");
+
+      float64_array dense_vals = dense["value"].value();
+      float64_array sparse_vals = sparse["value"].value();
+      ASSERT_EQ(dense_vals.number_of_elements(), 64 * 64);
+      ASSERT_EQ(sparse_vals.number_of_elements(), 64 * 64);
+      int occupied = 0;
+      double total = 0.0;
+      for(index_t i = 0; i < dense_vals.number_of_elements(); i++)
+      {
+        EXPECT_NEAR(dense_vals[i], sparse_vals[i], 1e-12)
+          << op << " bin " << i;
+        if(dense_vals[i] != -1.0)
+        {
+          occupied++;
+          total += dense_vals[i];
+        }
+      }
+      // two columns of two elements per rank, with one column shared
+      // by neighboring ranks
+      EXPECT_EQ(occupied, 2 * (par_size + 1)) << op;
+      if(op == "sum")
+      {
+        double expected = 0.0;
+        for(int r = 0; r < par_size; r++)
+        {
+          expected += r * 40.0 + 6.0;
+        }
+        EXPECT_NEAR(total, expected, 1e-12);
+      }
+    }
+}
+
+//-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
 {
     int result = 0;
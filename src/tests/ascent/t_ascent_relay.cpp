@@ -924,6 +924,208 @@ TEST(ascent_relay, test_relay_sparse_topos)
     n_root.print();
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_relay, test_relay_structured_ghost_layer)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent vtkm support disabled, skipping test");
+        return;
+    }
+
+    //
+    // Create an example mesh with a layer of garbage zones (value 2)
+    // around the boundary
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("uniform",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    const int cell_dim = EXAMPLE_MESH_SIDE_DIM - 1;
+    data["fields/ascent_ghosts/association"] = "element";
+    data["fields/ascent_ghosts/topology"] = "mesh";
+    data["fields/ascent_ghosts/values"].set(DataType::int32(cell_dim * cell_dim * cell_dim));
+    int32 *ghosts = data["fields/ascent_ghosts/values"].value();
+    int index = 0;
+    for(int k = 0; k < cell_dim; ++k)
+    {
+      for(int j = 0; j < cell_dim; ++j)
+      {
+        for(int i = 0; i < cell_dim; ++i)
+        {
+          bool boundary = i == 0 || j == 0 || k == 0 ||
+                          i == cell_dim - 1 || j == cell_dim - 1 || k == cell_dim - 1;
+          ghosts[index++] = boundary ? 2 : 0;
+        }
+      }
+    }
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing stripping a structured ghost layer");
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,"tout_relay_structured_ghosts");
+    string output_root = output_file + ".cycle_000100.root";
+
+    // remove old files
+    remove_test_image(output_root);
+
+    conduit::Node extracts;
+    extracts["e1/type"]  = "relay";
+
+    extracts["e1/params/path"] = output_file;
+    extracts["e1/params/protocol"] = "blueprint/mesh/hdf5";
+
+    conduit::Node actions;
+    // add the extracts
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    add_extracts["extracts"] = extracts;
+
+    //
+    // Run Ascent
+    //
+
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["runtime"] = "ascent";
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.close();
+
+    EXPECT_TRUE(conduit::utils::is_file(output_root));
+
+    // the stripped mesh stays uniform and loses one point on each side
+    Node n_root;
+    conduit::relay::io::load(output_root,"hdf5",n_root);
+    char domain_file[512];
+    snprintf(domain_file,
+             sizeof(domain_file),
+             n_root["file_pattern"].as_string().c_str(),
+             0);
+
+    Node n_domain;
+    conduit::relay::io::load(conduit::utils::join_file_path(output_path, domain_file),
+                             "hdf5",
+                             n_domain);
+    const Node &n_coords = n_domain["coordsets"].child(0);
+    EXPECT_EQ(n_coords["type"].as_string(), "uniform");
+    EXPECT_EQ(n_coords["dims/i"].to_int32(), EXAMPLE_MESH_SIDE_DIM - 2);
+    EXPECT_EQ(n_coords["dims/j"].to_int32(), EXAMPLE_MESH_SIDE_DIM - 2);
+    EXPECT_EQ(n_coords["dims/k"].to_int32(), EXAMPLE_MESH_SIDE_DIM - 2);
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_relay, test_relay_structured_threshold)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent vtkm support disabled, skipping test");
+        return;
+    }
+
+    //
+    // Create an example mesh with a cell field holding the i index
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("uniform",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    const int cell_dim = EXAMPLE_MESH_SIDE_DIM - 1;
+    const int num_cells = cell_dim * cell_dim * cell_dim;
+    data["fields/i_index/association"] = "element";
+    data["fields/i_index/topology"] = "mesh";
+    data["fields/i_index/values"].set(DataType::float64(num_cells));
+    float64 *i_index = data["fields/i_index/values"].value();
+    for(int c = 0; c < num_cells; ++c)
+    {
+      i_index[c] = c % cell_dim;
+    }
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing a structured threshold");
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,"tout_relay_structured_threshold");
+    string output_root = output_file + ".cycle_000100.root";
+
+    // remove old files
+    remove_test_image(output_root);
+
+    conduit::Node pipelines;
+    pipelines["pl1/f1/type"] = "threshold";
+    pipelines["pl1/f1/params/field"] = "i_index";
+    pipelines["pl1/f1/params/min_value"] = 2.0;
+    pipelines["pl1/f1/params/max_value"] = 5.0;
+
+    conduit::Node extracts;
+    extracts["e1/type"]  = "relay";
+    extracts["e1/pipeline"]  = "pl1";
+
+    extracts["e1/params/path"] = output_file;
+    extracts["e1/params/protocol"] = "blueprint/mesh/hdf5";
+
+    conduit::Node actions;
+    // add the pipeline
+    conduit::Node &add_pipelines = actions.append();
+    add_pipelines["action"] = "add_pipelines";
+    add_pipelines["pipelines"] = pipelines;
+    // add the extracts
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    add_extracts["extracts"] = extracts;
+
+    //
+    // Run Ascent
+    //
+
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["runtime"] = "ascent";
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.close();
+
+    EXPECT_TRUE(conduit::utils::is_file(output_root));
+
+    // the threshold selects a box of 4 cells along i and stays uniform
+    Node n_root;
+    conduit::relay::io::load(output_root,"hdf5",n_root);
+    char domain_file[512];
+    snprintf(domain_file,
+             sizeof(domain_file),
+             n_root["file_pattern"].as_string().c_str(),
+             0);
+
+    Node n_domain;
+    conduit::relay::io::load(conduit::utils::join_file_path(output_path, domain_file),
+                             "hdf5",
+                             n_domain);
+    const Node &n_coords = n_domain["coordsets"].child(0);
+    EXPECT_EQ(n_coords["type"].as_string(), "uniform");
+    EXPECT_EQ(n_coords["dims/i"].to_int32(), 5);
+    EXPECT_EQ(n_coords["dims/j"].to_int32(), EXAMPLE_MESH_SIDE_DIM);
+    EXPECT_EQ(n_coords["dims/k"].to_int32(), EXAMPLE_MESH_SIDE_DIM);
+}
+
 
 
 
@@ -506,6 +506,110 @@ TEST(ascent_slice, test_3slice)
     std::string msg = "An example of the three slice filter.";
     ASCENT_ACTIONS_DUMP(actions,output_file,msg);
 }
+
+//-----------------------------------------------------------------------------
+TEST(ascent_slice, test_cut)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent vtkm support disabled, skipping test");
+        return;
+    }
+
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing cut");
+
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,"tout_cut_3d");
+
+    // remove old files
+    if(conduit::utils::is_file(output_file + ".cycle_000100.root"))
+    {
+      conduit::utils::remove_file(output_file + ".cycle_000100.root");
+    }
+
+    //
+    // Create the actions.
+    //
+
+    conduit::Node pipelines;
+    // pipeline 1
+    pipelines["pl1/f1/type"] = "cut";
+    conduit::Node &cut_params = pipelines["pl1/f1/params"];
+
+    conduit::Node &plane = cut_params["cuts"].append();
+    plane["plane/point/x"] = 0.;
+    plane["plane/point/y"] = 0.;
+    plane["plane/point/z"] = 0.;
+    plane["plane/normal/x"] = 0.;
+    plane["plane/normal/y"] = 0.;
+    plane["plane/normal/z"] = 1.;
+
+    conduit::Node &sphere = cut_params["cuts"].append();
+    sphere["sphere/center/x"] = 0.;
+    sphere["sphere/center/y"] = 0.;
+    sphere["sphere/center/z"] = 0.;
+    sphere["sphere/radius"] = 5.;
+
+    conduit::Node &box = cut_params["cuts"].append();
+    box["operation"] = "clip";
+    box["invert"] = "true";
+    box["box/min/x"] = 5.;
+    box["box/min/y"] = 5.;
+    box["box/min/z"] = 5.;
+    box["box/max/x"] = 10.;
+    box["box/max/y"] = 10.;
+    box["box/max/z"] = 10.;
+
+    conduit::Node extracts;
+    extracts["e1/type"] = "relay";
+    extracts["e1/pipeline"] = "pl1";
+    extracts["e1/params/path"] = output_file;
+    extracts["e1/params/protocol"] = "blueprint/mesh/yaml";
+
+    conduit::Node actions;
+    // add the pipeline
+    conduit::Node &add_pipelines = actions.append();
+    add_pipelines["action"] = "add_pipelines";
+    add_pipelines["pipelines"] = pipelines;
+    // add the extracts
+    conduit::Node &add_extracts = actions.append();
+    add_extracts["action"] = "add_extracts";
+    add_extracts["extracts"] = extracts;
+
+    //
+    // Run Ascent
+    //
+
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.close();
+
+    // check that we created the extract
+    EXPECT_TRUE(conduit::utils::is_file(output_file + ".cycle_000100.root"));
+    std::string msg = "An example of the cut filter slicing and clipping in one filter.";
+    ASCENT_ACTIONS_DUMP(actions,output_file,msg);
+}
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
 {
@@ -155,6 +155,91 @@ TEST(ascent_threshold, test_threshold_3d)
     ASCENT_ACTIONS_DUMP(actions,output_file,msg);
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_threshold, test_shared_expression_params)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent vtkm support disabled, skipping test");
+        return;
+    }
+
+    //
+    // Create an example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    ASCENT_INFO("Testing an expression shared by two thresholds");
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,"tout_threshold_shared_expr");
+
+    //
+    // Create the actions.
+    //
+
+    const std::string expr = "0.5 * max(field('braid')).value";
+    conduit::Node pipelines;
+    pipelines["pl1/f1/type"] = "threshold";
+    pipelines["pl1/f1/params/field"] = "braid";
+    pipelines["pl1/f1/params/min_value"] = expr;
+    pipelines["pl1/f1/params/max_value"] = 10.0;
+    pipelines["pl2/f1/type"] = "threshold";
+    pipelines["pl2/f1/params/field"] = "radial";
+    pipelines["pl2/f1/params/min_value"] = expr;
+    pipelines["pl2/f1/params/max_value"] = 100.0;
+
+    conduit::Node extracts;
+    extracts["e1/type"] = "relay";
+    extracts["e1/pipeline"] = "pl1";
+    extracts["e1/params/path"] = output_file + "_1";
+    extracts["e1/params/protocol"] = "blueprint/mesh/yaml";
+    extracts["e2/type"] = "relay";
+    extracts["e2/pipeline"] = "pl2";
+    extracts["e2/params/path"] = output_file + "_2";
+    extracts["e2/params/protocol"] = "blueprint/mesh/yaml";
+
+    conduit::Node actions;
+    // add the pipeline
+    conduit::Node &add_pipelines= actions.append();
+    add_pipelines["action"] = "add_pipelines";
+    add_pipelines["pipelines"] = pipelines;
+    // add the extracts
+    conduit::Node &add_extracts= actions.append();
+    add_extracts["action"] = "add_extracts";
+    add_extracts["extracts"] = extracts;
+
+    //
+    // Run Ascent
+    //
+
+    Ascent ascent;
+
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+
+    // both thresholds see the same input, so the expression is
+    // evaluated once and reused by the second threshold
+    conduit::Node info;
+    ascent.info(info);
+    EXPECT_EQ(info["expression_params/evaluated"].to_int64(), 1);
+    EXPECT_EQ(info["expression_params/reused"].to_int64(), 1);
+    ascent.close();
+}
+
 
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
@@ -421,7 +421,181 @@ TEST(ascent_triggers, trigger_extract_inline_actions)
     ASCENT_ACTIONS_DUMP(actions,output_file,msg);
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_triggers, trigger_multiple_cycles)
+{
+    //
+    // Create example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                               EXAMPLE_MESH_SIDE_DIM,
+                                               EXAMPLE_MESH_SIDE_DIM,
+                                               EXAMPLE_MESH_SIDE_DIM,
+                                               data);
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,"tout_trigger_multiple_cycles");
+    string output_root_100 = output_file + ".cycle_000100.root";
+    string output_root_101 = output_file + ".cycle_000101.root";
+
+    // remove old files
+    if(conduit::utils::is_file(output_root_100))
+    {
+      conduit::utils::remove_file(output_root_100);
+    }
+    if(conduit::utils::is_file(output_root_101))
+    {
+      conduit::utils::remove_file(output_root_101);
+    }
+
+    //
+    // Create the trigger actions.
+    //
+    conduit::Node extracts;
+    extracts["e1/type"]  = "relay";
+    extracts["e1/params/path"] = output_file;
+    extracts["e1/params/protocol"] = "blueprint/mesh/hdf5";
+
+    conduit::Node trigger_actions;
+    conduit::Node &add_ext= trigger_actions.append();
+    add_ext["action"] = "add_extracts";
+    add_ext["extracts"] = extracts;
+
+    //
+    // Create the actions.
+    //
+    Node actions;
+    std::string condition = "cycle() >= 100";
+    conduit::Node triggers;
+    triggers["t1/params/condition"] = condition;
+    triggers["t1/params/actions"] = trigger_actions;
+
+    conduit::Node &add_triggers= actions.append();
+    add_triggers["action"] = "add_triggers";
+    add_triggers["triggers"] = triggers;
+
+    //
+    // Run Ascent for two cycles with the same actions, so the
+    // second firing reuses the trigger's runtime
+    //
+
+    Ascent ascent;
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+
+    data["state/cycle"] = 101;
+    ascent.publish(data);
+    ascent.execute(actions);
+    ascent.close();
+
+    // check that the trigger fired on both cycles
+    EXPECT_TRUE(conduit::utils::is_file(output_root_100));
+    EXPECT_TRUE(conduit::utils::is_file(output_root_101));
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_triggers, trigger_keeps_parent_expression_params)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent vtkm support disabled, skipping test");
+        return;
+    }
+
+    //
+    // Create example mesh.
+    //
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                               EXAMPLE_MESH_SIDE_DIM,
+                                               EXAMPLE_MESH_SIDE_DIM,
+                                               EXAMPLE_MESH_SIDE_DIM,
+                                               data);
 
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    string output_path = prepare_output_dir();
+    string output_file = conduit::utils::join_file_path(output_path,"tout_trigger_expression_params");
+
+    //
+    // The parent and the trigger both threshold with the same
+    // expression valued param.
+    //
+    const std::string expr = "0.5 * max(field('braid')).value";
+    conduit::Node pipelines;
+    pipelines["pl1/f1/type"] = "threshold";
+    pipelines["pl1/f1/params/field"] = "braid";
+    pipelines["pl1/f1/params/min_value"] = expr;
+    pipelines["pl1/f1/params/max_value"] = 10.0;
+    pipelines["pl2/f1/type"] = "threshold";
+    pipelines["pl2/f1/params/field"] = "radial";
+    pipelines["pl2/f1/params/min_value"] = expr;
+    pipelines["pl2/f1/params/max_value"] = 100.0;
+
+    conduit::Node extracts;
+    extracts["e1/type"] = "relay";
+    extracts["e1/pipeline"] = "pl1";
+    extracts["e1/params/path"] = output_file + "_1";
+    extracts["e1/params/protocol"] = "blueprint/mesh/yaml";
+    extracts["e2/type"] = "relay";
+    extracts["e2/pipeline"] = "pl2";
+    extracts["e2/params/path"] = output_file + "_2";
+    extracts["e2/params/protocol"] = "blueprint/mesh/yaml";
+
+    conduit::Node trigger_actions;
+    conduit::Node &trigger_pipelines = trigger_actions.append();
+    trigger_pipelines["action"] = "add_pipelines";
+    trigger_pipelines["pipelines/tpl/f1/type"] = "threshold";
+    trigger_pipelines["pipelines/tpl/f1/params/field"] = "braid";
+    trigger_pipelines["pipelines/tpl/f1/params/min_value"] = expr;
+    trigger_pipelines["pipelines/tpl/f1/params/max_value"] = 10.0;
+    conduit::Node &trigger_extracts = trigger_actions.append();
+    trigger_extracts["action"] = "add_extracts";
+    trigger_extracts["extracts/te/type"] = "relay";
+    trigger_extracts["extracts/te/pipeline"] = "tpl";
+    trigger_extracts["extracts/te/params/path"] = output_file + "_trigger";
+    trigger_extracts["extracts/te/params/protocol"] = "blueprint/mesh/yaml";
+
+    conduit::Node actions;
+    conduit::Node &add_pipelines= actions.append();
+    add_pipelines["action"] = "add_pipelines";
+    add_pipelines["pipelines"] = pipelines;
+    conduit::Node &add_extracts= actions.append();
+    add_extracts["action"] = "add_extracts";
+    add_extracts["extracts"] = extracts;
+    conduit::Node &add_triggers= actions.append();
+    add_triggers["action"] = "add_triggers";
+    add_triggers["triggers/t1/params/condition"] = "cycle() >= 100";
+    add_triggers["triggers/t1/params/actions"] = trigger_actions;
+
+    //
+    // Run Ascent
+    //
+
+    Ascent ascent;
+    Node ascent_opts;
+    ascent_opts["runtime/type"] = "ascent";
+    ascent.open(ascent_opts);
+    ascent.publish(data);
+    ascent.execute(actions);
+
+    // the trigger's runtime has its own memo, so the parent still sees
+    // one evaluation shared by its two thresholds
+    conduit::Node info;
+    ascent.info(info);
+    EXPECT_EQ(info["expression_params/evaluated"].to_int64(), 1);
+    EXPECT_EQ(info["expression_params/reused"].to_int64(), 1);
+    ascent.close();
+}
 
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
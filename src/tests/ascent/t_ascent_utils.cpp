@@ -51,6 +51,7 @@
 #include "gtest/gtest.h"
 
 #include <ascent.hpp>
+#include <ascent_runtime_scratch_arena.hpp>
 
 #include <iostream>
 #include <math.h>
@@ -86,3 +87,31 @@ TEST(ascent_utils, ascent_copy_dir)
     EXPECT_TRUE(conduit::utils::is_file(idx_fpath));
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_utils, scratch_arena)
+{
+    using ascent::runtime::filters::ScratchArena;
+    const size_t limit = ScratchArena::global_limit();
+    ScratchArena::set_global_limit(1024 * sizeof(float));
+
+    ScratchArena arena;
+    std::vector<float> &values = arena.vector<float>("values");
+    values.resize(512);
+    const float *ptr = values.data();
+    arena.trim();
+    EXPECT_EQ(ScratchArena::global_bytes(), 512 * sizeof(float));
+
+    // the same size reuses the same memory in the next execute
+    std::vector<float> &same = arena.vector<float>("values");
+    same.resize(512);
+    EXPECT_EQ(same.data(), ptr);
+    arena.trim();
+
+    // going over the limit frees the buffers
+    arena.vector<float>("more").resize(1024);
+    arena.trim();
+    EXPECT_EQ(arena.bytes(), size_t(0));
+    EXPECT_EQ(ScratchArena::global_bytes(), size_t(0));
+
+    ScratchArena::set_global_limit(limit);
+}
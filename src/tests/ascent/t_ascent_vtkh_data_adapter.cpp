@@ -432,6 +432,130 @@ TEST(ascent_multi_topo, adapter_test)
     delete collection;
 }
 
+//-----------------------------------------------------------------------------
+TEST(ascent_multi_topo, collection_catalog)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent vtkm support disabled, skipping test");
+        return;
+    }
+
+    Node data;
+    build_multi_topo(data, EXAMPLE_MESH_SIDE_DIM);
+
+    VTKHCollection* collection = VTKHDataAdapter::BlueprintToVTKHCollection(data,true);
+
+    EXPECT_EQ(collection->number_of_topologies(), 2);
+    EXPECT_TRUE(collection->has_topology("mesh"));
+    EXPECT_TRUE(collection->has_topology("point_mesh"));
+    EXPECT_FALSE(collection->has_topology("bananas"));
+
+    EXPECT_TRUE(collection->has_field("braid"));
+    EXPECT_FALSE(collection->has_field("bananas"));
+    EXPECT_EQ(collection->field_topology("braid"), "mesh");
+    EXPECT_EQ(collection->field_topology("point_braid"), "point_mesh");
+    EXPECT_EQ(collection->field_topology("bananas"), "");
+    EXPECT_EQ(collection->field_association("braid"), "vertex");
+    EXPECT_EQ(collection->field_association("radial"), "element");
+
+    std::vector<vtkm::Range> range = collection->field_range("braid");
+    EXPECT_EQ(range.size(), 1);
+    EXPECT_TRUE(range[0].IsNonEmpty());
+
+    vtkm::Bounds bounds = collection->global_bounds();
+    EXPECT_TRUE(bounds.IsNonEmpty());
+
+    // derived collections update the copied catalog
+    VTKHCollection *copy = collection->copy_without_topology("point_mesh");
+    EXPECT_EQ(copy->number_of_topologies(), 1);
+    EXPECT_FALSE(copy->has_field("point_braid"));
+    EXPECT_TRUE(copy->has_field("braid"));
+
+    copy->add(collection->dataset_by_topology("point_mesh"), "point_mesh");
+    EXPECT_EQ(copy->number_of_topologies(), 2);
+    EXPECT_EQ(copy->field_topology("point_radial"), "point_mesh");
+    // the inherited ranges are kept, the new topology's are gathered
+    EXPECT_EQ(copy->field_range("braid")[0].Min, range[0].Min);
+    EXPECT_EQ(copy->field_range("point_braid").size(), 1);
+
+    delete copy;
+    delete collection;
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_data_adapter, native_integer_fields)
+{
+    Node n;
+    ascent::about(n);
+    // only run this test if ascent was built with vtkm support
+    if(n["runtimes/ascent/vtkm/status"].as_string() == "disabled")
+    {
+        ASCENT_INFO("Ascent vtkm support disabled, skipping test");
+        return;
+    }
+
+    Node data, verify_info;
+    conduit::blueprint::mesh::examples::braid("hexs",
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              EXAMPLE_MESH_SIDE_DIM,
+                                              data);
+
+    const int num_eles = data["fields/radial/values"].dtype().number_of_elements();
+    data["fields/mat_id/association"] = "element";
+    data["fields/mat_id/topology"] = "mesh";
+    data["fields/mat_id/values"].set(DataType::int32(num_eles));
+    data["fields/mask/association"] = "element";
+    data["fields/mask/topology"] = "mesh";
+    data["fields/mask/values"].set(DataType::uint8(num_eles));
+    int32 *mat_id = data["fields/mat_id/values"].value();
+    uint8 *mask = data["fields/mask/values"].value();
+    for(int i = 0; i < num_eles; ++i)
+    {
+      mat_id[i] = i % 3;
+      mask[i] = i % 2;
+    }
+
+    EXPECT_TRUE(conduit::blueprint::mesh::verify(data,verify_info));
+
+    VTKHDataAdapter::SetNativeFieldTypes({"int32"});
+    VTKHCollection* collection = VTKHDataAdapter::BlueprintToVTKHCollection(data,true);
+
+    vtkm::cont::DataSet &dom = collection->dataset_by_topology("mesh").GetDomain(0);
+    // int32 is passed through, uint8 was not asked for so it keeps
+    // the default conversion
+    EXPECT_TRUE(dom.GetField("mat_id").GetData().IsValueType<vtkm::Int32>());
+    EXPECT_TRUE(dom.GetField("mask").GetData().IsValueType<vtkm::Float64>());
+
+    std::vector<vtkm::Range> range = collection->field_range("mat_id");
+    EXPECT_EQ(range.size(), 1);
+    EXPECT_EQ(range[0].Min, 0.);
+    EXPECT_EQ(range[0].Max, 2.);
+
+    // filters that need floating point get a converted copy, the
+    // collection keeps the native field
+    vtkh::DataSet fp_data = collection->floating_point_dataset("mesh", {"mat_id"});
+    EXPECT_TRUE(fp_data.GetDomain(0).GetField("mat_id").GetData().IsValueType<vtkm::Float64>());
+    EXPECT_TRUE(dom.GetField("mat_id").GetData().IsValueType<vtkm::Int32>());
+    EXPECT_TRUE(collection->floating_point_dataset("bananas", {"mat_id"}).GetNumberOfDomains() == 0);
+
+    VTKHDataAdapter::SetNativeFieldTypes({});
+    EXPECT_TRUE(VTKHDataAdapter::NativeFieldTypes().empty());
+    EXPECT_THROW(VTKHDataAdapter::SetNativeFieldTypes({"bananas"}),
+                 conduit::Error);
+    // not in vtk-m's default type list
+    EXPECT_THROW(VTKHDataAdapter::SetNativeFieldTypes({"int8"}),
+                 conduit::Error);
+    EXPECT_THROW(VTKHDataAdapter::SetNativeFieldTypes({"uint32"}),
+                 conduit::Error);
+
+    delete collection;
+}
+
 //-----------------------------------------------------------------------------
 int main(int argc, char* argv[])
 {
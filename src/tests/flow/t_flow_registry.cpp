@@ -212,3 +212,47 @@ TEST(ascent_flow_registry, detach_tracked)
 
 
 
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_registry, memory_accounting)
+{
+    Node *a = new Node();
+    a->set(DataType::float64(100));
+    Node *b = new Node();
+    b->set(DataType::float64(50));
+
+    // untracked data counts toward live bytes, but is never released
+    Node src;
+    src.set(DataType::float64(10));
+
+    Registry r;
+    r.add<Node>("src",&src);
+    r.add<Node>("a",a,1);
+    r.add<Node>("b",b,1);
+    // aliased entries share the same memory
+    r.add<Node>("a_al",a,1);
+
+    EXPECT_EQ(r.size_in_bytes("a"), 800);
+    EXPECT_EQ(r.size_in_bytes("b"), 400);
+    EXPECT_EQ(r.live_bytes(), 1280);
+    EXPECT_EQ(r.peak_bytes(), 1280);
+
+    r.consume("b");
+    EXPECT_EQ(r.live_bytes(), 880);
+
+    // data can grow after it is added
+    r.fetch<Node>("a")->set(DataType::float64(200));
+    r.update_size("a");
+    EXPECT_EQ(r.live_bytes(), 1680);
+    EXPECT_EQ(r.peak_bytes(), 1680);
+
+    r.consume("a");
+    r.consume("a_al");
+    EXPECT_EQ(r.live_bytes(), 80);
+    EXPECT_EQ(r.peak_bytes(), 1680);
+
+    r.reset_peak_bytes();
+    EXPECT_EQ(r.peak_bytes(), 80);
+
+    r.print();
+}
@@ -0,0 +1,200 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2015-2019, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-716457
+//
+// All rights reserved.
+//
+// This file is part of Ascent.
+//
+// For details, see: http://ascent.readthedocs.io/.
+//
+// Please also read ascent/LICENSE
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// * Redistributions of source code must retain the above copyright notice,
+//   this list of conditions and the disclaimer below.
+//
+// * Redistributions in binary form must reproduce the above copyright notice,
+//   this list of conditions and the disclaimer (as noted below) in the
+//   documentation and/or other materials provided with the distribution.
+//
+// * Neither the name of the LLNS/LLNL nor the names of its contributors may
+//   be used to endorse or promote products derived from this software without
+//   specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL LAWRENCE LIVERMORE NATIONAL SECURITY,
+// LLC, THE U.S. DEPARTMENT OF ENERGY OR CONTRIBUTORS BE LIABLE FOR ANY
+// DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+// OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+// HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+// STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+// IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+//-----------------------------------------------------------------------------
+///
+/// file: t_flow_trace.cpp
+///
+//-----------------------------------------------------------------------------
+
+#include "gtest/gtest.h"
+
+#include <flow.hpp>
+
+#include <iostream>
+
+#include "t_config.hpp"
+#include "t_utils.hpp"
+
+
+
+using namespace std;
+using namespace conduit;
+using namespace flow;
+
+//-----------------------------------------------------------------------------
+// puts the trace back in its default state
+void reset_trace()
+{
+    Trace::disable();
+    Trace::set_rank(0);
+    Trace::set_buffer_capacity(1 << 16);
+    Trace::clear();
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_trace, ring_buffer_wraps)
+{
+    reset_trace();
+    Trace::set_buffer_capacity(4);
+    Trace::clear();
+    Trace::enable();
+    for(int i = 0; i < 10; ++i)
+    {
+        FLOW_TRACE_SCOPE("wrap");
+    }
+    Trace::disable();
+    EXPECT_EQ(Trace::number_of_events(), 4);
+    Trace::clear();
+    EXPECT_EQ(Trace::number_of_events(), 0);
+    reset_trace();
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_trace, disabled_records_nothing)
+{
+    reset_trace();
+    {
+        FLOW_TRACE_SCOPE("ignored");
+        Trace::begin("ignored_manual");
+        Trace::end();
+    }
+    EXPECT_EQ(Trace::number_of_events(), 0);
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_trace, toggle_inside_manual_pairs)
+{
+    reset_trace();
+    Trace::enable();
+    // a begin from before tracing is disabled ...
+    Trace::begin("outer");
+    Trace::disable();
+    // ... must not be closed by the end of a begin that wasn't recorded
+    Trace::begin("skipped");
+    Trace::enable();
+    Trace::end();
+    Trace::begin("inner");
+    Trace::end();
+    Trace::end();
+    Trace::disable();
+    EXPECT_EQ(Trace::number_of_events(), 2);
+
+    std::string json = Trace::events_json();
+    EXPECT_TRUE(json.find("\"name\":\"outer\"") != std::string::npos);
+    EXPECT_TRUE(json.find("\"name\":\"inner\"") != std::string::npos);
+    EXPECT_TRUE(json.find("skipped") == std::string::npos);
+    reset_trace();
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_trace, intern)
+{
+    int a = Trace::intern("trace_a");
+    int b = Trace::intern("trace_b");
+    EXPECT_NE(a, b);
+    EXPECT_EQ(a, Trace::intern("trace_a"));
+    EXPECT_EQ(Trace::name(b), "trace_b");
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_trace, nested_scopes_json)
+{
+    reset_trace();
+    Trace::set_rank(3);
+    Trace::enable();
+    {
+        TraceScope outer(std::string("outer \"quoted\""));
+        {
+            FLOW_TRACE_SCOPE("inner");
+        }
+    }
+    Trace::disable();
+    EXPECT_EQ(Trace::number_of_events(), 2);
+
+    std::string json = Trace::events_json();
+    EXPECT_TRUE(json.find("\"name\":\"inner\"") != std::string::npos);
+    EXPECT_TRUE(json.find("outer \\\"quoted\\\"") != std::string::npos);
+    EXPECT_TRUE(json.find("\"pid\":3") != std::string::npos);
+    EXPECT_TRUE(json.find("\"depth\":1") != std::string::npos);
+
+    // the chrome trace must be valid json
+    std::string output_path = prepare_output_dir();
+    std::string output_file = conduit::utils::join_file_path(output_path,
+                                                             "tout_flow_trace.json");
+    remove_test_file(output_file);
+    Trace::write_chrome_trace(output_file);
+    EXPECT_TRUE(conduit::utils::is_file(output_file));
+
+    Node n;
+    n.load(output_file, "json");
+    EXPECT_EQ(n["traceEvents"].number_of_children(), 3);
+    reset_trace();
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_trace, workspace_filters)
+{
+    reset_trace();
+    Trace::enable();
+
+    Workspace::register_filter_type<flow::filters::RegistrySource>();
+    Workspace w;
+    Node v;
+    v.set(int(10));
+    w.registry().add<Node>(":src",&v);
+
+    Node p;
+    p["entry"] = ":src";
+    w.graph().add_filter("registry_source","s",p);
+    w.execute();
+    Trace::disable();
+
+    std::string json = Trace::events_json();
+    EXPECT_TRUE(json.find("flow::Workspace::execute") != std::string::npos);
+    EXPECT_TRUE(json.find("\"name\":\"s\"") != std::string::npos);
+
+    Workspace::clear_supported_filter_types();
+    reset_trace();
+}
@@ -198,6 +198,63 @@ public:
 
 
 
+//-----------------------------------------------------------------------------
+class AllocFilter: public Filter
+{
+public:
+    AllocFilter()
+    : Filter()
+    {}
+
+    virtual ~AllocFilter()
+    {}
+
+    virtual void declare_interface(Node &i)
+    {
+        i["type_name"]   = "alloc";
+        i["output_port"] = "true";
+        i["port_names"].append().set("in");
+        i["default_params"]["size"].set((int)1);
+    }
+
+    virtual void execute()
+    {
+        int size = params()["size"].value();
+
+        Node *res = new Node();
+        res->set(DataType::float64(size));
+        set_output<Node>(res);
+    }
+};
+
+//-----------------------------------------------------------------------------
+class JoinFilter: public Filter
+{
+public:
+    JoinFilter()
+    : Filter()
+    {}
+
+    virtual ~JoinFilter()
+    {}
+
+    virtual void declare_interface(Node &i)
+    {
+        i["type_name"]   = "join";
+        i["output_port"] = "true";
+        i["port_names"].append().set("a");
+        i["port_names"].append().set("b");
+    }
+
+    virtual void execute()
+    {
+        Node *res = new Node();
+        res->set((int)(input<Node>("a")->dtype().number_of_elements() +
+                       input<Node>("b")->dtype().number_of_elements()));
+        set_output<Node>(res);
+    }
+};
+
 //-----------------------------------------------------------------------------
 TEST(ascent_flow_workspace, linear_graph)
 {
@@ -237,6 +294,120 @@ TEST(ascent_flow_workspace, linear_graph)
     Workspace::clear_supported_filter_types();
 }
 
+//-----------------------------------------------------------------------------
+// stands in for a host that combines the votes of all ranks
+int budget_votes = 0;
+bool count_budget_votes(bool over_budget)
+{
+    budget_votes++;
+    return over_budget;
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_workspace, linear_graph_memory)
+{
+    Workspace::register_filter_type<SrcFilter>();
+    Workspace::register_filter_type<IncFilter>();
+
+    Workspace w;
+
+    w.graph().add_filter("src","s");
+    w.graph().add_filter("inc","a");
+    w.graph().add_filter("inc","b");
+
+    w.graph().connect("s","a","in");
+    w.graph().connect("a","b","in");
+
+    w.execute();
+
+    const Node &mem = w.last_execution_memory();
+    mem.print();
+
+    // each filter outputs a single int32
+    EXPECT_EQ(mem["filters/s/output_bytes"].to_index_t(), 4);
+    EXPECT_EQ(mem["filters/a/output_bytes"].to_index_t(), 4);
+    // when 'a' finishes, its input and output are both live
+    EXPECT_EQ(mem["filters/a/live_bytes"].to_index_t(), 8);
+    EXPECT_EQ(mem["peak_bytes"].to_index_t(), 8);
+    EXPECT_FALSE(mem.has_child("budget"));
+
+    Node info;
+    w.info(info);
+    EXPECT_TRUE(info.has_path("memory/peak_bytes"));
+
+    w.registry().consume("b");
+
+    // with a budget, results are still correct
+    w.set_memory_budget(1);
+    w.execute();
+    EXPECT_EQ(w.registry().fetch<Node>("b")->to_int(),2);
+    EXPECT_EQ(w.last_execution_memory()["budget"].to_index_t(), 1);
+    w.registry().consume("b");
+
+    // the host agrees on releasing once per filter
+    w.set_memory_budget_agreement(&count_budget_votes);
+    w.execute();
+    EXPECT_EQ(budget_votes, 3);
+    EXPECT_EQ(w.registry().fetch<Node>("b")->to_int(),2);
+    w.registry().consume("b");
+
+    Workspace::clear_supported_filter_types();
+}
+
+//-----------------------------------------------------------------------------
+TEST(ascent_flow_workspace, memory_aware_plan)
+{
+    Workspace::register_filter_type<SrcFilter>();
+    Workspace::register_filter_type<AllocFilter>();
+    Workspace::register_filter_type<JoinFilter>();
+
+    Workspace w;
+
+    Node p_big;
+    p_big["size"] = 1000;
+
+    // two large results, one of which is reduced before the join
+    w.graph().add_filter("src","s");
+    w.graph().add_filter("alloc","big_1",p_big);
+    w.graph().add_filter("alloc","big_2",p_big);
+    w.graph().add_filter("alloc","reduce");
+    w.graph().add_filter("join","j");
+
+    w.graph().connect("s","big_1","in");
+    w.graph().connect("s","big_2","in");
+    w.graph().connect("big_2","reduce","in");
+    w.graph().connect("big_1","j","a");
+    w.graph().connect("reduce","j","b");
+
+    // without a budget, or without estimates, the default plan is used
+    w.set_memory_budget(1000000);
+    w.execute();
+    const Node &mem = w.last_execution_memory();
+    mem.print();
+    EXPECT_EQ(mem["plan"].as_string(), "default");
+    // both large results are live at once
+    index_t default_peak = mem["peak_bytes"].to_index_t();
+    EXPECT_GE(default_peak, 16000);
+    EXPECT_EQ(w.registry().fetch<Node>("j")->to_int(), 1001);
+    w.registry().consume("j");
+
+    // estimates from the previous execution drive the new order
+    w.execute();
+    w.last_execution_memory().print();
+    EXPECT_EQ(w.last_execution_memory()["plan"].as_string(), "memory_aware");
+    EXPECT_LT(w.last_execution_memory()["peak_bytes"].to_index_t(), default_peak);
+    EXPECT_EQ(w.registry().fetch<Node>("j")->to_int(), 1001);
+    w.registry().consume("j");
+
+    Node travs;
+    w.traversals(travs);
+    travs.print();
+    EXPECT_EQ(travs.number_of_children(), 1);
+    EXPECT_EQ(travs[0].number_of_children(), 5);
+
+    Workspace::clear_supported_filter_types();
+}
+
 //-----------------------------------------------------------------------------
 TEST(ascent_flow_workspace, linear_graph_using_filter_ptr_iface)
 {
@@ -53,6 +53,7 @@
 #include <ascent_hola.hpp>
 
 #include <fstream>
+#include <thread>
 #include <vector>
 #ifdef REPLAY_MPI
 #include <mpi.h>
@@ -65,15 +66,25 @@ void usage()
   std::cout<<"of a simulation. Domain overloading is supported, so you can load x domains ";
   std::cout<<"with y mpi ranks where x >= y\n\n.";
   std::cout<<"======================== Options  =========================\n";
-  std::cout<<"  --root    : the root file for a blueprint hdf5 set of files.\n";
-  std::cout<<"  --cycles  : a text file containing a list of root files, one per line.\n";
-  std::cout<<"              Each file will be loaded and sent to Ascent in order.\n";
-  std::cout<<"  --actions : a json file containing ascent actions. Default value\n";
-  std::cout<<"              is 'ascent_actions.json'.\n\n";
+  std::cout<<"  --root     : the root file for a blueprint hdf5 set of files.\n";
+  std::cout<<"  --cycles   : a text file containing a list of root files, one per line.\n";
+  std::cout<<"               Each file will be loaded and sent to Ascent in order.\n";
+  std::cout<<"  --actions  : a json file containing ascent actions. Default value\n";
+  std::cout<<"               is 'ascent_actions.json'.\n";
+  std::cout<<"  --repeat   : the number of times each cycle is published and executed.\n";
+  std::cout<<"               Default value is 1.\n";
+  std::cout<<"  --prefetch : load the next cycle in a background thread while the\n";
+  std::cout<<"               current cycle is processed. The MPI version requires\n";
+  std::cout<<"               MPI_THREAD_MULTIPLE support, and the I/O libraries must\n";
+  std::cout<<"               be thread safe if the actions also write files.\n";
+  std::cout<<"  --timings  : a file to save per-phase and per-filter timings (min/max\n";
+  std::cout<<"               across ranks). Files ending in '.json' are saved as json,\n";
+  std::cout<<"               otherwise csv is used.\n\n";
   std::cout<<"======================== Examples =========================\n";
   std::cout<<"./relay_ser --root=clover.cycle_000060.root\n";
   std::cout<<"./relay_ser --root=clover.cycle_000060.root --actions=my_actions.json\n";
   std::cout<<"srun -n 4 relay_mpi --cycles=cycles_file\n";
+  std::cout<<"srun -n 4 relay_mpi --cycles=cycles_file --prefetch --repeat=5 --timings=times.csv\n";
   std::cout<<"\n\n";
 }
 
@@ -82,6 +93,9 @@ struct Options
   std::string m_actions_file = "ascent_actions.json";
   std::string m_root_file;
   std::string m_cycles_file;
+  std::string m_timings_file;
+  int m_repeat = 1;
+  bool m_prefetch = false;
 
   void parse(int argc, char** argv)
   {
@@ -99,6 +113,22 @@ struct Options
       {
         m_actions_file = get_arg(argv[i]);
       }
+      else if(contains(argv[i], "--timings="))
+      {
+        m_timings_file = get_arg(argv[i]);
+      }
+      else if(contains(argv[i], "--repeat="))
+      {
+        m_repeat = atoi(get_arg(argv[i]).c_str());
+        if(m_repeat < 1)
+        {
+          bad_arg(argv[i]);
+        }
+      }
+      else if(std::string(argv[i]) == "--prefetch")
+      {
+        m_prefetch = true;
+      }
       else
       {
         bad_arg(argv[i]);
@@ -171,6 +201,116 @@ bool contains(const std::string haystack, std::string needle)
   }
 };
 
+//
+// Collects named timings for a single publish/execute pass. Every rank
+// records the same names in the same order, so reductions can be done
+// on flat arrays.
+//
+struct Timings
+{
+  std::vector<std::string> m_names;
+  std::vector<double> m_values;
+  std::vector<double> m_min;
+  std::vector<double> m_max;
+
+  void add(const std::string &name, double value)
+  {
+    m_names.push_back(name);
+    m_values.push_back(value);
+  }
+
+  void reduce()
+  {
+    const int size = m_values.size();
+    m_min = m_values;
+    m_max = m_values;
+#ifdef REPLAY_MPI
+    if(size > 0)
+    {
+      MPI_Allreduce(m_values.data(), m_min.data(), size,
+                    MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+      MPI_Allreduce(m_values.data(), m_max.data(), size,
+                    MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    }
+#endif
+  }
+
+  double max(const std::string &name) const
+  {
+    for(size_t i = 0; i < m_names.size(); ++i)
+    {
+      if(m_names[i] == name)
+      {
+        return m_max[i];
+      }
+    }
+    return 0.;
+  }
+};
+
+//
+// loads a root file. This runs in the prefetch thread when enabled.
+//
+void load_cycle(const std::string &root_file,
+                const conduit::Node &replay_opts,
+                conduit::Node &data,
+                double &load_time)
+{
+  conduit::Node opts(replay_opts);
+  opts["root_file"] = root_file;
+  flow::Timer load;
+  ascent::hola("relay/blueprint/mesh", opts, data);
+  load_time = load.elapsed();
+}
+
+void save_timings(const std::string &file_name,
+                  const std::vector<std::string> &time_steps,
+                  const std::vector<std::vector<Timings>> &timings)
+{
+  std::string curr, next;
+  conduit::utils::rsplit_string(file_name, ".", curr, next);
+
+  if(curr == "json")
+  {
+    conduit::Node res;
+    for(size_t c = 0; c < timings.size(); ++c)
+    {
+      conduit::Node &cycle = res["cycles"].append();
+      cycle["root_file"] = time_steps[c];
+      for(size_t r = 0; r < timings[c].size(); ++r)
+      {
+        const Timings &t = timings[c][r];
+        conduit::Node &rep = cycle["repeats"].append();
+        for(size_t i = 0; i < t.m_names.size(); ++i)
+        {
+          conduit::Node &entry = rep.add_child(t.m_names[i]);
+          entry["min"] = t.m_min[i];
+          entry["max"] = t.m_max[i];
+        }
+      }
+    }
+    res.save(file_name, "json");
+  }
+  else
+  {
+    std::ofstream out(file_name);
+    out<<"root_file,repeat,name,min,max\n";
+    for(size_t c = 0; c < timings.size(); ++c)
+    {
+      for(size_t r = 0; r < timings[c].size(); ++r)
+      {
+        const Timings &t = timings[c][r];
+        for(size_t i = 0; i < t.m_names.size(); ++i)
+        {
+          out<<time_steps[c]<<","<<r<<","<<t.m_names[i]<<","
+             <<t.m_min[i]<<","<<t.m_max[i]<<"\n";
+        }
+      }
+    }
+    out.close();
+  }
+}
+
 int main (int argc, char *argv[])
 {
   Options options;
@@ -197,14 +337,38 @@ int main (int argc, char *argv[])
   int rank = 0;
 
 #ifdef REPLAY_MPI
-  MPI_Init(NULL,NULL);
+  int provided = MPI_THREAD_SINGLE;
+  if(options.m_prefetch)
+  {
+    // the prefetch thread does collectives while the main thread
+    // is executing the actions
+    MPI_Init_thread(NULL,NULL,MPI_THREAD_MULTIPLE,&provided);
+  }
+  else
+  {
+    MPI_Init(NULL,NULL);
+  }
   MPI_Comm_size(MPI_COMM_WORLD, &comm_size);
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  if(options.m_prefetch && provided < MPI_THREAD_MULTIPLE)
+  {
+    if(rank == 0)
+    {
+      std::cerr<<"MPI_THREAD_MULTIPLE is not supported: disabling prefetch\n";
+    }
+    options.m_prefetch = false;
+  }
+
+  // loads get their own communicator so they never
+  // interleave with collectives issued by ascent
+  MPI_Comm load_comm;
+  MPI_Comm_dup(MPI_COMM_WORLD, &load_comm);
 #endif
 
   conduit::Node replay_data, replay_opts;
 #ifdef REPLAY_MPI
-  replay_opts["mpi_comm"] = MPI_Comm_c2f(MPI_COMM_WORLD);
+  replay_opts["mpi_comm"] = MPI_Comm_c2f(load_comm);
 #endif
   //replay_data.print();
   conduit::Node ascent_opts;
@@ -222,44 +386,110 @@ int main (int argc, char *argv[])
   ascent::Ascent ascent;
   ascent.open(ascent_opts);
 
+  std::vector<std::vector<Timings>> all_timings(time_steps.size());
+
+  // data being loaded for the next cycle
+  conduit::Node next_data;
+  double next_load_time = 0.;
+  std::thread prefetch;
+
+  if(options.m_prefetch && time_steps.size() > 0)
+  {
+    prefetch = std::thread(load_cycle,
+                           std::cref(time_steps[0]),
+                           std::cref(replay_opts),
+                           std::ref(next_data),
+                           std::ref(next_load_time));
+  }
+
   for(int i = 0; i < time_steps.size(); ++i)
   {
-    replay_opts["root_file"] = time_steps[i];
     if(rank == 0)
     {
       std::cout<<"Root file "<<time_steps[i]<<"\n";
     }
-    flow::Timer load;
-    ascent::hola("relay/blueprint/mesh", replay_opts, replay_data);
+
+    double load_time = 0.;
+    flow::Timer load_wait;
+    if(options.m_prefetch)
+    {
+      prefetch.join();
+      replay_data.swap(next_data);
+      next_data.reset();
+      load_time = next_load_time;
+      // start loading the next cycle while we process this one
+      if(i + 1 < time_steps.size())
+      {
+        prefetch = std::thread(load_cycle,
+                               std::cref(time_steps[i+1]),
+                               std::cref(replay_opts),
+                               std::ref(next_data),
+                               std::ref(next_load_time));
+      }
+    }
+    else
+    {
+      load_cycle(time_steps[i], replay_opts, replay_data, load_time);
+    }
 #ifdef REPLAY_MPI
     MPI_Barrier(MPI_COMM_WORLD);
 #endif
-    float load_time = load.elapsed();
-      
-    flow::Timer publish;
-    ascent.publish(replay_data);
+    double load_wait_time = load_wait.elapsed();
+
+    for(int r = 0; r < options.m_repeat; ++r)
+    {
+      Timings timings;
+      timings.add("load", load_time);
+      timings.add("load_wait", load_wait_time);
+
+      flow::Timer publish;
+      ascent.publish(replay_data);
 #ifdef REPLAY_MPI
-    MPI_Barrier(MPI_COMM_WORLD);
+      MPI_Barrier(MPI_COMM_WORLD);
 #endif
-    float publish_time = publish.elapsed();
+      timings.add("publish", publish.elapsed());
 
-    flow::Timer execute;
-    ascent.execute(actions);
+      flow::Timer execute;
+      ascent.execute(actions);
 #ifdef REPLAY_MPI
-    MPI_Barrier(MPI_COMM_WORLD);
+      MPI_Barrier(MPI_COMM_WORLD);
 #endif
-    float execute_time = execute.elapsed();
-    if(rank == 0)
-    {
-      std::cout<<" Load -----: "<<load_time<<"\n";
-      std::cout<<" Publish --: "<<publish_time<<"\n";
-      std::cout<<" Execute --: "<<execute_time<<"\n";
+      timings.add("execute", execute.elapsed());
+
+      conduit::Node info;
+      ascent.info(info);
+      if(info.has_child("filter_timings"))
+      {
+        conduit::NodeConstIterator itr = info["filter_timings"].children();
+        while(itr.has_next())
+        {
+          const conduit::Node &filter_time = itr.next();
+          timings.add("filter:" + itr.name(), filter_time.to_float64());
+        }
+      }
+
+      timings.reduce();
+      if(rank == 0)
+      {
+        std::cout<<" Repeat ---: "<<r<<"\n";
+        std::cout<<" Load -----: "<<timings.max("load")<<"\n";
+        std::cout<<" Load wait : "<<timings.max("load_wait")<<"\n";
+        std::cout<<" Publish --: "<<timings.max("publish")<<"\n";
+        std::cout<<" Execute --: "<<timings.max("execute")<<"\n";
+      }
+      all_timings[i].push_back(timings);
     }
   }
 
   ascent.close();
 
+  if(rank == 0 && options.m_timings_file != "")
+  {
+    save_timings(options.m_timings_file, time_steps, all_timings);
+  }
+
 #ifdef REPLAY_MPI
+  MPI_Comm_free(&load_comm);
   MPI_Finalize();
 #endif
   return 0;